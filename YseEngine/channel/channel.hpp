@@ -27,6 +27,8 @@ namespace YSE {
       MOVE,
       VIRTUAL,
       ATTACH_REVERB,
+      AMBISONICS,
+      DSP,
     };
   }
 }
@@ -13,14 +13,18 @@
 
 YSE::CHANNEL::implementationObject::implementationObject(channel * head) :
 head(head), 
-newVolume(1.f), lastVolume(1.f), parent(nullptr), userChannel(true),
- allowVirtual(true)
+newVolume(1.f), lastVolume(1.f), rampTarget(1.f), rampStep(0.f), rampLeft(0),
+ parent(nullptr), hrtf(nullptr),
+ post_dsp(nullptr), reverbPending(false), userChannel(true), allowVirtual(true)
 {
+  // timed messages are kept on the audio thread, which should not allocate memory
+  timedMessages.reserve(16);
 }
 
  YSE::CHANNEL::implementationObject::~implementationObject() {
   // exit the dsp thread for this channel
    join();
+   if (post_dsp && post_dsp->calledfrom) post_dsp->calledfrom = nullptr;
 
   if (INTERNAL::Global().isActive()) {
     if (parent != nullptr) {
@@ -75,7 +79,8 @@ void YSE::CHANNEL::implementationObject::dsp() {
   // if no sounds or other channels are linked, we skip this channel
   if (children.empty() && sounds.empty()) return;
 
-  // clear channel buffer
+  // clear channel buffer. Buffers which are still silent from the
+  // previous round are not cleared again.
   clearBuffers();
 
   // calculate child channels if there are any
@@ -83,6 +88,12 @@ void YSE::CHANNEL::implementationObject::dsp() {
     INTERNAL::Global().addFastJob(*i);
   }
 
+  // sounds will be convolved instead of panned when there's an hrtf set
+  // for binaural output
+  hrtf = CHANNEL::Manager().getChannelType() == CT_BINAURAL ? INTERNAL::Hrtf().get() : nullptr;
+  if (hrtf != nullptr) hrtfOut.clear();
+  if (ambisonics.active()) ambisonics.begin(SOUND::Manager().getListenerAngle());
+
   // calculate sounds in this channel
   for (auto i = sounds.begin(); i != sounds.end(); ++i) {
     if ((*i)->dsp()) {
@@ -90,9 +101,21 @@ void YSE::CHANNEL::implementationObject::dsp() {
     }
   }
 
-  REVERB::Manager().process(this);
+  if (ambisonics.active()) {
+    if (hrtf != nullptr) ambisonics.decode(hrtf, hrtfOut);
+    else ambisonics.decode(out);
+  }
+  if (hrtf != nullptr) hrtfOut.render(out);
+
+  // insert effects run once on the mix, before the reverb
+  for (DSP::dspObject * ptr = post_dsp; ptr != nullptr; ptr = ptr->link()) {
+    ptr->processOrSleep(out);
+  }
+
+  // reverb zones run in parallel with other channels and are added in buffersToParent
+  reverbPending = REVERB::Manager().begin(this);
 
-  if (INTERNAL::UnderWaterEffect().channel() == this) {
+  if (!reverbPending && INTERNAL::UnderWaterEffect().channel() == this) {
     INTERNAL::UnderWaterEffect().apply(out);
   }
 }
@@ -104,6 +127,15 @@ void YSE::CHANNEL::implementationObject::removeInterface() {
 void YSE::CHANNEL::implementationObject::buffersToParent() {
   join();
 
+  // this runs on the audio thread, so it's safe to wait for the reverb here
+  if (reverbPending) {
+    REVERB::Manager().end(this);
+    reverbPending = false;
+    if (INTERNAL::UnderWaterEffect().channel() == this) {
+      INTERNAL::UnderWaterEffect().apply(out);
+    }
+  }
+
   // call this recursively on all child channels 
   for (auto i = children.begin(); i != children.end(); ++i) {
     (*i)->buffersToParent();
@@ -116,13 +148,28 @@ void YSE::CHANNEL::implementationObject::buffersToParent() {
   if (parent == nullptr) return;
   if (children.empty() && sounds.empty()) return;
 
-  // if not the main channel, add output to parent channel
+  // if not the main channel, add output to parent channel. Silent
+  // buffers are skipped by the buffer itself.
   for (UInt i = 0; i < out.size(); ++i) {
     // parent size is not checked but should be ok because it's adjusted before calling this
     parent->out[i] += out[i];
   }
 }
 
+void YSE::CHANNEL::implementationObject::setDSP(DSP::dspObject * ptr) {
+  if (post_dsp && post_dsp->calledfrom) {
+    *(post_dsp->calledfrom) = nullptr;
+  }
+
+  // the object is removed from the sound or channel that used it before
+  if (ptr && ptr->calledfrom) {
+    *(ptr->calledfrom) = nullptr;
+  }
+
+  post_dsp = ptr;
+  if (post_dsp) post_dsp->calledfrom = &post_dsp;
+}
+
 void YSE::CHANNEL::implementationObject::attachUnderWaterFX() {
   INTERNAL::UnderWaterEffect().channel(this);
 }
@@ -137,6 +184,7 @@ void YSE::CHANNEL::implementationObject::setup() {
     for (UInt i = 0; i < CHANNEL::Manager().getNumberOfOutputs(); i++) {
       outConf[i].angle = CHANNEL::Manager().getOutputAngle(i);
     }
+    setAmbisonicLayout();
     objectStatus = OBJECT_SETUP;
   }
 }
@@ -147,6 +195,7 @@ void YSE::CHANNEL::implementationObject::resize(bool deep) {
   for (UInt i = 0; i < CHANNEL::Manager().getNumberOfOutputs(); i++) {
     outConf[i].angle = CHANNEL::Manager().getOutputAngle(i);
   }
+  setAmbisonicLayout();
   if (deep) {
     for (auto i = children.begin(); i != children.end(); ++i) {
       (*i)->resize(true);
@@ -194,8 +243,18 @@ void YSE::CHANNEL::implementationObject::sync() {
   }
 
   messageObject message;
+  ULong now = DEVICE::Manager().frame();
   while (messages.try_pop(message)) {
-    parseMessage(message);
+    // Messages for a later frame wait until adjustVolume reaches that frame.
+    // When there's no more room, they are applied right away instead of lost.
+    if (message.frame > now && timedMessages.size() < timedMessages.capacity()) {
+      auto pos = timedMessages.end();
+      while (pos != timedMessages.begin() && (pos - 1)->frame > message.frame) --pos;
+      timedMessages.insert(pos, message);
+    }
+    else {
+      parseMessage(message);
+    }
   }
 }
 
@@ -218,6 +277,12 @@ void YSE::CHANNEL::implementationObject::parseMessage(const messageObject & mess
     case VOLUME: 
       newVolume = message.floatValue; 
       break;
+    case AMBISONICS:
+      ambisonics.setOrder(message.uintValue);
+      break;
+    case DSP:
+      setDSP((DSP::dspObject *)message.ptrValue);
+      break;
     
   }
 }
@@ -245,6 +310,14 @@ void YSE::CHANNEL::implementationObject::childrenToParent() {
   }
 }
 
+void YSE::CHANNEL::implementationObject::setAmbisonicLayout() {
+  std::vector<Flt> angles(CHANNEL::Manager().getNumberOfSpeakers());
+  for (UInt i = 0; i < angles.size(); i++) {
+    angles[i] = CHANNEL::Manager().getOutputAngle(i);
+  }
+  ambisonics.setLayout(angles);
+}
+
 void YSE::CHANNEL::implementationObject::clearBuffers() {
   for (UInt i = 0; i < out.size(); ++i) {
     out[i] = 0.0f;
@@ -252,25 +325,64 @@ void YSE::CHANNEL::implementationObject::clearBuffers() {
 }
 
 void YSE::CHANNEL::implementationObject::adjustVolume() {
-  if (newVolume != lastVolume) {
-    // new value, create a ramp
-    Flt step = (newVolume - lastVolume) / STANDARD_BUFFERSIZE;
+  if (timedMessages.empty()) {
+    adjustVolume(0, STANDARD_BUFFERSIZE);
+    return;
+  }
 
-    for (UInt i = 0; i < out.size(); ++i) {
-      Flt multiplier = lastVolume;
-      Flt * ptr = out[i].getPtr();
-      for (UInt j = 0; j < STANDARD_BUFFERSIZE; j++) {
-        *ptr++ *= multiplier;
-        multiplier += step;
-      }
+  // split the buffer at every timed message in it
+  ULong blockStart = DEVICE::Manager().frame();
+  UInt from = 0;
+  while (from < STANDARD_BUFFERSIZE) {
+    UInt due = 0;
+    while (due < timedMessages.size() && timedMessages[due].frame <= blockStart + from) {
+      parseMessage(timedMessages[due]);
+      due++;
+    }
+    if (due > 0) timedMessages.erase(timedMessages.begin(), timedMessages.begin() + due);
+
+    UInt to = STANDARD_BUFFERSIZE;
+    if (!timedMessages.empty() && timedMessages.front().frame < blockStart + STANDARD_BUFFERSIZE) {
+      to = static_cast<UInt>(timedMessages.front().frame - blockStart);
     }
-    lastVolume = newVolume;
+    adjustVolume(from, to);
+    from = to;
+  }
+}
+
+void YSE::CHANNEL::implementationObject::adjustVolume(UInt from, UInt to) {
+  if (newVolume != rampTarget) {
+    // new value, create a ramp
+    rampTarget = newVolume;
+    rampStep = (rampTarget - lastVolume) / STANDARD_BUFFERSIZE;
+    rampLeft = STANDARD_BUFFERSIZE;
   }
-  else {
+
+  if (rampLeft == 0 && from == 0 && to == STANDARD_BUFFERSIZE) {
     // same volume, just copy
     for (UInt i = 0; i < out.size(); ++i) {
-      out[i] *= newVolume;
+      out[i] *= lastVolume;
+    }
+    return;
+  }
+
+  UInt ramp = rampLeft < to - from ? rampLeft : to - from;
+  for (UInt i = 0; i < out.size(); ++i) {
+    // nothing to ramp in a silent buffer
+    if (out[i].isZero()) continue;
+    Flt multiplier = lastVolume;
+    Flt * ptr = out[i].getPtr();
+    UInt j = from;
+    for (; j < from + ramp; j++) {
+      ptr[j] *= multiplier;
+      multiplier += rampStep;
+    }
+    for (; j < to; j++) {
+      ptr[j] *= rampTarget;
     }
   }
+
+  rampLeft -= ramp;
+  lastVolume = rampLeft > 0 ? lastVolume + rampStep * ramp : rampTarget;
 }
 
@@ -15,6 +15,8 @@
 #include "classes.hpp"
 #include "utils/lfQueue.hpp"
 #include "internal/threadPool.h"
+#include "internal/hrtf.h"
+#include "internal/ambisonics.h"
 
 namespace YSE {
   namespace CHANNEL {
@@ -153,9 +155,14 @@ namespace YSE {
       void clearBuffers();
 
       /** Creates a ramp to the new volume if needed, to avoid pops. Called by the dsp function.
+          Timed volume changes start their ramp at their exact frame in the block.
       */
       void adjustVolume();
 
+      /** Applies the channel volume to the frames from 'from' up to 'to'.
+      */
+      void adjustVolume(UInt from, UInt to);
+
 
       /**
         Attach the premade special effect for 'underwater' simulation to this channel
@@ -192,9 +199,13 @@ namespace YSE {
       std::atomic<channel *> head; // < The interface connected to this object
       std::atomic<OBJECT_IMPLEMENTATION_STATE> objectStatus; // < the status of this object
       lfQueue<messageObject> messages;
+      std::vector<messageObject> timedMessages; // messages waiting for their frame, in order
 
       Flt  newVolume;
-      Flt  lastVolume;
+      Flt  lastVolume; // volume applied to the last frame
+      Flt  rampTarget; // the volume the current ramp goes to
+      Flt  rampStep;
+      UInt rampLeft; // frames left in the current ramp
 
       CHANNEL::implementationObject * parent;
 
@@ -204,6 +215,19 @@ namespace YSE {
       std::vector<output> outConf;
       std::vector<DSP::buffer> out;
 
+      // binaural output, only used when the channel type is CT_BINAURAL
+      INTERNAL::hrtfSet * hrtf;
+      INTERNAL::hrtfMix hrtfOut;
+
+      // optional ambisonic bus, sounds are encoded into this instead of panned
+      INTERNAL::ambisonicBus ambisonics;
+      void setAmbisonicLayout();
+
+      // insert effects, processed on the mix of this channel
+      DSP::dspObject * post_dsp;
+      Bool reverbPending; // reverb zones started in dsp(), to be added in buffersToParent()
+      void setDSP(DSP::dspObject * ptr);
+
       Bool userChannel; // channel is created by user and not crucial for the system
       Bool allowVirtual;
 
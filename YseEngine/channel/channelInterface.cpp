@@ -12,7 +12,7 @@
 #include "internalHeaders.h"
 
 
-YSE::channel::channel() : volume(1.f), allowVirtual(true), pimpl(nullptr)
+YSE::channel::channel() : volume(1.f), allowVirtual(true), ambisonicOrder(0), dsp(nullptr), pimpl(nullptr)
 {}
 
 YSE::channel::~channel() {
@@ -53,6 +53,17 @@ YSE::channel& YSE::channel::setVolume(Flt value) {
   return (*this);
 }
 
+YSE::channel& YSE::channel::setVolume(Flt value, unsigned long long frame) {
+  Clamp(value, 0.f, 1.f);
+  CHANNEL::messageObject m;
+  m.ID = CHANNEL::VOLUME;
+  m.floatValue = value;
+  m.frame = frame;
+  pimpl->sendMessage(m);
+  volume = value; // only used for getVolume
+  return (*this);
+}
+
 Flt YSE::channel::getVolume() {
   return volume;
 }
@@ -78,6 +89,39 @@ bool YSE::channel::getVirtual() {
   return allowVirtual;
 }
 
+YSE::channel& YSE::channel::setAmbisonics(UInt order) {
+  if (order > INTERNAL::AMBISONICS_MAX_ORDER) order = INTERNAL::AMBISONICS_MAX_ORDER;
+  CHANNEL::messageObject m;
+  m.ID = CHANNEL::AMBISONICS;
+  m.uintValue = order;
+  pimpl->sendMessage(m);
+  ambisonicOrder = order;
+  return (*this);
+}
+
+UInt YSE::channel::getAmbisonics() {
+  return ambisonicOrder;
+}
+
+YSE::channel& YSE::channel::setDSP(DSP::dspObject * value) {
+  if (dsp != value) {
+    dsp = value;
+    // allocate here, because the message is handled on the audio thread
+    for (DSP::dspObject * i = value; i != nullptr; i = i->link()) {
+      i->prepare(CHANNEL::Manager().getNumberOfOutputs());
+    }
+    CHANNEL::messageObject m;
+    m.ID = CHANNEL::DSP;
+    m.ptrValue = value;
+    pimpl->sendMessage(m);
+  }
+  return (*this);
+}
+
+YSE::DSP::dspObject * YSE::channel::getDSP() {
+  return dsp;
+}
+
 bool YSE::channel::isValid() {
   return pimpl != nullptr;
 }
@@ -15,6 +15,7 @@
 #include "headers/defines.hpp"
 #include "headers/types.hpp"
 #include "channel.hpp"
+#include "../classes.hpp"
 
 
 namespace YSE {
@@ -64,6 +65,15 @@ namespace YSE {
         */
     channel&  setVolume(float value);
 
+    /**
+        Changes the volume of a channel at an exact frame on the device clock. See System().frame().
+
+        @param value    The new volume for this channel
+        @param frame    The frame at which the change starts. Frames which have already passed
+                        are applied at once.
+        */
+    channel&  setVolume(float value, unsigned long long frame);
+
     /**
         Get the volume of a channel.
 
@@ -100,6 +110,37 @@ namespace YSE {
     */
     bool getVirtual();
 
+    /** Mix the sounds in this channel to an ambisonic sound field instead of
+        panning them to every output. The sound field is decoded to the speakers
+        (or to binaural output) once per block, so the cost of a sound no longer
+        depends on the number of speakers. This is most useful for channels with
+        a lot of sounds on surround layouts.
+
+        @param order  The ambisonic order, from 1 to 3. Higher orders are more
+                      precise but need more channels: (order + 1)^2. Use 0 to
+                      turn ambisonics off, which is the default.
+    */
+    channel& setAmbisonics(unsigned int order);
+
+    /** Get the ambisonic order of this channel.
+
+        @return 0 if ambisonics are not used
+    */
+    unsigned int getAmbisonics();
+
+    /** Attach a chain of dsp objects to this channel. The chain processes the mix of
+        all sounds and subchannels in this channel, once per block, no matter how
+        many sounds there are. Use link() on the dsp object to add more objects to
+        the chain, and nullptr to remove it.
+
+        A dsp object can only be used in one place: attaching it to a channel
+        removes it from its previous sound or channel.
+
+        @param value  The first dsp object of the chain
+    */
+    channel& setDSP(DSP::dspObject * value);
+    DSP::dspObject * getDSP();
+
     /** Check if this channel is valid. It's almost impossible for a channel to 
         be invalid. Something would be very wrong with the whole system. (Can you
         really run out of memory these days?)
@@ -128,6 +169,8 @@ namespace YSE {
 
     Flt volume; // to remember the channel volume
     Bool allowVirtual; // allows virtual sounds in this channel (defaults to true)
+    UInt ambisonicOrder; // 0 means no ambisonics (default)
+    DSP::dspObject * dsp; // first object of the insert chain
     std::string name;
     CHANNEL::implementationObject * pimpl;
 
@@ -10,6 +10,7 @@
 
 
 #include "internalHeaders.h"
+#include <algorithm>
 
 YSE::CHANNEL::managerObject & YSE::CHANNEL::Manager() {
   static managerObject m;
@@ -20,8 +21,15 @@ YSE::CHANNEL::managerObject::managerObject()
 : mgrSetup( this), 
   mgrDelete(this), 
   outputAngles(nullptr),
-  outputChannels(0) 
-  {}
+  outputChannels(0),
+  positionedOutputs(0),
+  customChanged(false)
+  {
+  // a value outside of the circle means the angle is not set
+  for (Int i = 0; i < MAX_CUSTOM_OUTPUTS; i++) {
+    customAngles[i] = 10.f;
+  }
+}
 
 YSE::CHANNEL::managerObject::~managerObject() {
   // wait for jobs to finish
@@ -154,7 +162,17 @@ void YSE::CHANNEL::managerObject::setChannelConf(CHANNEL_TYPE type, Int outputs)
   channelType = type;
 }
 
+void YSE::CHANNEL::managerObject::setCustomAngle(UInt nr, Flt angle) {
+  if (nr >= MAX_CUSTOM_OUTPUTS) return;
+  angle = fmod(angle, Pi2);
+  if (angle > Pi) angle -= Pi2;
+  else if (angle <= -Pi) angle += Pi2;
+  customAngles[nr] = angle;
+  if (channelType == CT_CUSTOM) customChanged = true;
+}
+
 void YSE::CHANNEL::managerObject::changeChannelConf() {
+  customChanged = false;
   delete[] outputAngles;
   outputAngles = new aFlt[outputChannels.load()];
   switch (channelType.load()) {
@@ -166,8 +184,28 @@ void YSE::CHANNEL::managerObject::changeChannelConf() {
     case CT_51SIDE: set51Side(); break;
     case CT_61:	set61(); break;
     case CT_71:	set71(); break;
-    case CT_CUSTOM: break; // we've set number of outputs. CT_CUSTOM expects the positions will be 
-                           // set later
+    case CT_BINAURAL: setStereo(); break;
+    case CT_CUSTOM: setCustom(); break; // positions are set with System().speakerAngle()
+  }
+
+  // an LFE output has no position in the layout
+  switch (channelType.load()) {
+    case CT_51:
+    case CT_51SIDE: positionedOutputs = 5; break;
+    case CT_61: positionedOutputs = 6; break;
+    case CT_71: positionedOutputs = 7; break;
+    default: positionedOutputs = outputChannels.load(); break;
+  }
+  if (positionedOutputs > outputChannels) positionedOutputs = outputChannels.load();
+
+  // vector base amplitude panning is used for surround and custom layouts
+  switch (channelType.load()) {
+    case CT_51:
+    case CT_51SIDE:
+    case CT_61:
+    case CT_71:
+    case CT_CUSTOM: calculateSpeakerPairs(positionedOutputs); break;
+    default: speakerPairs.clear(); break;
   }
 
   REVERB::Manager().setOutputChannels(outputChannels);
@@ -177,6 +215,42 @@ void YSE::CHANNEL::managerObject::changeChannelConf() {
   }
 }
 
+void YSE::CHANNEL::managerObject::calculateSpeakerPairs(UInt speakers) {
+  speakerPairs.clear();
+  if (speakers < 3) return;
+
+  // sort speakers by angle
+  std::vector<UInt> order(speakers);
+  for (UInt i = 0; i < speakers; i++) order[i] = i;
+  std::sort(order.begin(), order.end(), [this](UInt a, UInt b) {
+    return outputAngles[a].load() < outputAngles[b].load();
+  });
+
+  for (UInt i = 0; i < speakers; i++) {
+    UInt a = order[i];
+    UInt b = order[(i + 1) % speakers];
+    Flt angleA = outputAngles[a];
+    Flt angleB = outputAngles[b];
+
+    // a pair cannot be used if the speakers are 180 degrees or more apart
+    Flt span = angleB - angleA;
+    if (span <= 0) span += Pi2;
+    if (span >= Pi) continue;
+
+    Flt det = sin(angleA) * cos(angleB) - cos(angleA) * sin(angleB);
+    if (fabs(det) < 0.0001f) continue;
+
+    speakerPair pair;
+    pair.first = a;
+    pair.second = b;
+    pair.inverse[0] = cos(angleB) / det;
+    pair.inverse[1] = -sin(angleB) / det;
+    pair.inverse[2] = -cos(angleA) / det;
+    pair.inverse[3] = sin(angleA) / det;
+    speakerPairs.push_back(pair);
+  }
+}
+
 void YSE::CHANNEL::managerObject::setAuto(Int count) {
   switch (count) {
   case	1: setMono(); break;
@@ -231,6 +305,19 @@ void YSE::CHANNEL::managerObject::set61() {
   outputAngles[5] = Pi / 180.0f * 180.0f;
 }
 
+void YSE::CHANNEL::managerObject::setCustom() {
+  // speakers without a position are spread evenly
+  for (UInt i = 0; i < outputChannels; i++) {
+    if (i < MAX_CUSTOM_OUTPUTS && customAngles[i] <= Pi) {
+      outputAngles[i] = customAngles[i].load();
+    }
+    else {
+      outputAngles[i] = Pi2 / outputChannels * i;
+      if (outputAngles[i] > Pi) outputAngles[i] = outputAngles[i] - Pi2;
+    }
+  }
+}
+
 void YSE::CHANNEL::managerObject::set71() {
   outputAngles[0] = Pi / 180.0f *  -45.0f;
   outputAngles[1] = Pi / 180.0f *   45.0f;
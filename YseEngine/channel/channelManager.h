@@ -18,9 +18,31 @@
 #include "internalHeaders.h"
 #include "internal/threadPool.h"
 
+// maximum number of outputs for which a custom speaker angle can be set
+#define MAX_CUSTOM_OUTPUTS 32
+
 namespace YSE {
   namespace CHANNEL {
 
+    /**
+      Two adjacent speakers used for vector base amplitude panning. The inverse
+      of the matrix formed by both speaker directions is calculated when the
+      channel configuration changes.
+    */
+    class speakerPair {
+    public:
+      UInt first, second;
+      Flt inverse[4];
+
+      /** Calculates the gains for both speakers for a direction. Both gains are
+          positive when the direction lies between the speakers.
+      */
+      inline void gains(Flt x, Flt z, Flt & g1, Flt & g2) const {
+        g1 = x * inverse[0] + z * inverse[1];
+        g2 = x * inverse[2] + z * inverse[3];
+      }
+    };
+
     class managerObject {
     public:
 
@@ -105,8 +127,20 @@ namespace YSE {
       void changeChannelConf();
       
       UInt getNumberOfOutputs();
+      // the number of outputs with a position in the layout, which excludes LFE
+      UInt getNumberOfSpeakers() { return positionedOutputs; }
+      CHANNEL_TYPE getChannelType() { return channelType; }
       Flt  getOutputAngle(UInt nr);
 
+      // speaker positions for CT_CUSTOM, in radians
+      void setCustomAngle(UInt nr, Flt angle);
+      Bool needsConfChange() { return customChanged; }
+
+      // surround layouts use vector base amplitude panning instead of
+      // cosine panning over all outputs
+      Bool usesVBAP() { return !speakerPairs.empty(); }
+      const std::vector<speakerPair> & getSpeakerPairs() { return speakerPairs; }
+
       channel & master();
       channel & FX();
       channel & music();
@@ -153,7 +187,14 @@ namespace YSE {
       // channel output configuration
       aFlt * outputAngles;
       aUInt outputChannels;
+      aUInt positionedOutputs;
       std::atomic<CHANNEL_TYPE> channelType;
+      aFlt customAngles[MAX_CUSTOM_OUTPUTS];
+      aBool customChanged;
+
+      // adjacent speaker pairs, only used for surround layouts
+      std::vector<speakerPair> speakerPairs;
+      void calculateSpeakerPairs(UInt speakers);
 
       void setMono();
       void setStereo();
@@ -162,6 +203,7 @@ namespace YSE {
       void set51Side();
       void set61();
       void set71();
+      void setCustom();
       void setAuto(Int count);
 
       friend class setupJob;
@@ -40,6 +40,14 @@ namespace YSE {
         UInt   uintValue;
         void * ptrValue;
       };
+
+      /** The frame on the device clock at which this message should be applied.
+      Messages with a frame that has already passed (the default) are applied at
+      the next update.
+      */
+      ULong frame;
+
+      messageObject() : frame(0) {}
     };
   }
 }
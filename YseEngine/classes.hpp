@@ -38,6 +38,7 @@ namespace YSE {
     class dspSourceObject;
 
     // filters
+    class biQuadBank;
     class highPass;
     class lowPass;
     class bandPass;
@@ -56,6 +57,9 @@ namespace YSE {
     class noise;
     class vcf;
     class oscillator;
+    class wavetableSet;
+    class oscillatorBank;
+    class blepOscillator;
     
     // math functions
     class clip;
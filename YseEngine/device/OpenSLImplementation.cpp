@@ -267,8 +267,7 @@ void OpenSLImplementation::PrepareSoundBuffer() {
 
   while (pos < numSamples) {
     if (bufferPos == YSE::STANDARD_BUFFERSIZE) {
-      master.dsp();
-      master.buffersToParent();
+      YSE::DEVICE::Manager().renderBlock();
       bufferPos = 0;
     }
 
@@ -10,12 +10,14 @@
 
 
 #include "internalHeaders.h"
+#include "internal/denormal.h"
 
 
 YSE::DEVICE::deviceManager::deviceManager() 
   : master(nullptr)
   , currentInputChannels(0)
   , currentOutputChannels(2)
+  , clock(0)
 {
 }
 
@@ -36,6 +38,9 @@ bool YSE::DEVICE::deviceManager::doOnCallback(int numSamples)
 {
   if (master == nullptr) return false;
 
+  // the audio thread is created by the audio backend, so this is set on every callback
+  INTERNAL::disableDenormals();
+
   if (INTERNAL::Global().needsUpdate()) {
     // update global objects
     INTERNAL::Time().update();
@@ -63,7 +68,7 @@ bool YSE::DEVICE::deviceManager::doOnCallback(int numSamples)
   output that doesn't have the same amount of channels. Some jitter is to be expected
   at that point anyway.
   */
-  if (CHANNEL::Manager().getNumberOfOutputs() != master->out.size()) {
+  if (CHANNEL::Manager().getNumberOfOutputs() != master->out.size() || CHANNEL::Manager().needsConfChange()) {
     CHANNEL::Manager().changeChannelConf();
     master->resize(true);
   }
@@ -71,6 +76,18 @@ bool YSE::DEVICE::deviceManager::doOnCallback(int numSamples)
   return true;
 }
 
+void YSE::DEVICE::deviceManager::renderBlock()
+{
+  master->dsp();
+  master->buffersToParent();
+  clock += STANDARD_BUFFERSIZE;
+}
+
+ULong YSE::DEVICE::deviceManager::frame()
+{
+  return clock;
+}
+
 void YSE::DEVICE::deviceManager::setMaster(CHANNEL::implementationObject * ptr)
 {
   master = ptr;
@@ -14,6 +14,7 @@
 #include "classes.hpp"
 #include "headers/types.hpp"
 #include <vector>
+#include <atomic>
 
 namespace YSE {
 
@@ -52,6 +53,17 @@ namespace YSE {
 
       bool doOnCallback(int numSamples);
 
+      /* Renders the next STANDARD_BUFFERSIZE frames on the master channel and
+         advances the device clock. Backends should call this instead of calling
+         dsp on the master channel themselves.
+      */
+      void renderBlock();
+
+      /* The device clock: the number of frames rendered since the engine started.
+         While rendering, this is the frame at which the current block starts.
+      */
+      ULong frame();
+
       void setMaster(CHANNEL::implementationObject * ptr);
       CHANNEL::implementationObject & getMaster();
 
@@ -69,6 +81,8 @@ namespace YSE {
       CHANNEL::implementationObject * master;
       int currentInputChannels, currentOutputChannels;
 
+      std::atomic<ULong> clock;
+
     };
 
   }
@@ -52,8 +52,7 @@ int YSE::DEVICE::managerObject::paCallback(
   UInt pos = 0;
   while (pos < static_cast<UInt>(numSamples)) {
     if (manager->bufferPos == STANDARD_BUFFERSIZE) {
-      manager->master->dsp();
-      manager->master->buffersToParent();
+      manager->renderBlock();
       manager->bufferPos = 0;
     }
     
@@ -62,7 +61,7 @@ int YSE::DEVICE::managerObject::paCallback(
     for (UInt i = 0; i < manager->master->out.size(); i++) {
       UInt l = size;
       Flt * ptr1 = ((Flt **)output)[i] + pos;
-      Flt * ptr2 = manager->master->out[i].getPtr() + manager->bufferPos;
+      const Flt * ptr2 = manager->master->out[i].getConstPtr() + manager->bufferPos;
 
       for (; l > 7; l -= 8, ptr1 += 8, ptr2 += 8) {
         ptr1[0] = ptr2[0] < -1.f ? -1.f : ptr2[0] > 1.f ? 1.f : ptr2[0];
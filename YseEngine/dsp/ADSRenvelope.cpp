@@ -50,9 +50,7 @@ void YSE::DSP::ADSRenvelope::saveToFile(const char * fileName) {
   SaveToFile(fileName, envelope);
 }
 
-YSE::DSP::buffer & YSE::DSP::ADSRenvelope::operator()(STATE state, UInt length) {
-  if (length != result.getLength()) result.resize(length);
-
+void YSE::DSP::ADSRenvelope::setState(STATE state) {
   // envelope should start from the beginning on a new note
   if (state == ADSRenvelope::ATTACK) {
     phase = envelope.getPtr();
@@ -61,15 +59,9 @@ YSE::DSP::buffer & YSE::DSP::ADSRenvelope::operator()(STATE state, UInt length)
     endReached = false;
   }
 
-  // when called after release has reached zero
-  if (endReached) {
-    result = 0.f;
-    return result;
-  }
-
   // note is released, so go to the loop end (release moment) but
   // take into account that the current amplitude might be different
-  else if (state == ADSRenvelope::RELEASE && loopEnd != nullptr) {
+  if (!endReached && state == ADSRenvelope::RELEASE && loopEnd != nullptr) {
     // find the point nearest to the loop end with the same
     // value as the current point as to avoid a glitch when changing phase
     Flt * search = loopEnd;
@@ -77,7 +69,18 @@ YSE::DSP::buffer & YSE::DSP::ADSRenvelope::operator()(STATE state, UInt length)
     phase = search;
     looping = false;
   }
+}
+
+YSE::DSP::buffer & YSE::DSP::ADSRenvelope::operator()(STATE state, UInt length) {
+  if (length != result.getLength()) result.resize(length);
+
+  setState(state);
 
+  // when called after release has reached zero
+  if (endReached) {
+    result = 0.f;
+    return result;
+  }
 
   // fill the result buffer
   Flt * out = result.getPtr();
@@ -97,4 +100,26 @@ YSE::DSP::buffer & YSE::DSP::ADSRenvelope::operator()(STATE state, UInt length)
 
   
   return result;
-}
\ No newline at end of file
+}
+
+Flt YSE::DSP::ADSRenvelope::control(STATE state, UInt frames) {
+  setState(state);
+
+  while (frames && !endReached) {
+    // frames until the phase loops or the envelope ends
+    Flt * limit = looping ? loopEnd : envelopeEnd;
+    UInt left = static_cast<UInt>(limit - phase);
+    if (frames < left) {
+      phase += frames;
+      break;
+    }
+    // a loop of one point
+    if (left == 0) break;
+
+    frames -= left;
+    if (looping) phase = loopStart;
+    else endReached = true;
+  }
+
+  return endReached ? 0.f : *phase;
+}
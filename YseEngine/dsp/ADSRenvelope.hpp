@@ -47,11 +47,19 @@ namespace YSE {
 
       YSE::DSP::buffer & operator()(STATE state, UInt length = STANDARD_BUFFERSIZE);
 
+      // Control rate: move the envelope ahead by 'frames' and return the value
+      // it has there. Use 0 frames to get the current value, for instance right
+      // after an ATTACK. Consumers can interpolate between these values.
+      Flt control(STATE state, UInt frames = CONTROL_BLOCKSIZE);
+
       void saveToFile(const char * fileName);
 
       inline Bool isAtEnd() { return endReached; }
 
     private:
+      // handle a new attack or release
+      void setState(STATE state);
+
       std::vector<breakPoint> breakPoints;
       buffer envelope, result;
       Flt * phase;
@@ -0,0 +1,237 @@
+/*
+  ==============================================================================
+
+    biQuadBank.cpp
+    Created: 16 Oct 2026 9:02:18pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include "biQuadBank.hpp"
+#include <string.h>
+
+namespace {
+  const UInt FRESH = 4;
+}
+
+YSE::DSP::biQuadBank::biQuadBank(UInt lanes, UInt stages)
+  : writeSlot(0), readSlot(1), shared(2), ramping(false), started(false) {
+  reset(edit);
+  for (UInt i = 0; i < 3; i++) reset(slots[i]);
+  reset(current);
+  memset(&delta, 0, sizeof(design));
+  resize(lanes, stages);
+}
+
+YSE::DSP::biQuadBank::biQuadBank(const biQuadBank & source)
+  : numLanes(source.numLanes), numStages(source.numStages)
+  , edit(source.edit)
+  , writeSlot(source.writeSlot), readSlot(source.readSlot), shared(source.shared.load())
+  , current(source.current), delta(source.delta)
+  , ramping(source.ramping), started(source.started) {
+  for (UInt i = 0; i < 3; i++) slots[i] = source.slots[i];
+  memcpy(s1, source.s1, sizeof(s1));
+  memcpy(s2, source.s2, sizeof(s2));
+}
+
+void YSE::DSP::biQuadBank::reset(design & d) {
+  // all stages start as a plain wire
+  memset(&d, 0, sizeof(design));
+  for (UInt s = 0; s < BIQUAD_STAGES; s++) {
+    for (UInt l = 0; l < BIQUAD_LANES; l++) d.b0[s][l] = 1.f;
+  }
+}
+
+YSE::DSP::biQuadBank & YSE::DSP::biQuadBank::resize(UInt lanes, UInt stages) {
+  if (lanes < 1) lanes = 1;
+  if (lanes > BIQUAD_LANES) lanes = BIQUAD_LANES;
+  if (stages < 1) stages = 1;
+  if (stages > BIQUAD_STAGES) stages = BIQUAD_STAGES;
+  numLanes = lanes;
+  numStages = stages;
+  started = false;
+  return clear();
+}
+
+YSE::DSP::biQuadBank & YSE::DSP::biQuadBank::set(UInt lane, UInt stage, const coefficients & c) {
+  if (lane >= BIQUAD_LANES || stage >= BIQUAD_STAGES) return *this;
+  edit.b0[stage][lane] = c.b0;
+  edit.b1[stage][lane] = c.b1;
+  edit.b2[stage][lane] = c.b2;
+  edit.a1[stage][lane] = c.a1;
+  edit.a2[stage][lane] = c.a2;
+  return *this;
+}
+
+YSE::DSP::biQuadBank & YSE::DSP::biQuadBank::set(UInt stage, const coefficients & c) {
+  for (UInt l = 0; l < BIQUAD_LANES; l++) set(l, stage, c);
+  return *this;
+}
+
+YSE::DSP::biQuadBank & YSE::DSP::biQuadBank::publish() {
+  slots[writeSlot] = edit;
+  writeSlot = shared.exchange(writeSlot | FRESH) & ~FRESH;
+  return *this;
+}
+
+YSE::DSP::biQuadBank & YSE::DSP::biQuadBank::clear() {
+  memset(s1, 0, sizeof(s1));
+  memset(s2, 0, sizeof(s2));
+  return *this;
+}
+
+void YSE::DSP::biQuadBank::update(UInt length) {
+  if (ramping) {
+    // the previous ramp has ended
+    current = slots[readSlot];
+    ramping = false;
+  }
+
+  if (!(shared.load() & FRESH)) return;
+  readSlot = shared.exchange(readSlot) & ~FRESH;
+  const design & target = slots[readSlot];
+
+  if (!started || length == 0) {
+    current = target;
+    return;
+  }
+
+  Flt step = 1.f / length;
+  for (UInt s = 0; s < numStages; s++) {
+    for (UInt l = 0; l < BIQUAD_LANES; l++) {
+      delta.b0[s][l] = (target.b0[s][l] - current.b0[s][l]) * step;
+      delta.b1[s][l] = (target.b1[s][l] - current.b1[s][l]) * step;
+      delta.b2[s][l] = (target.b2[s][l] - current.b2[s][l]) * step;
+      delta.a1[s][l] = (target.a1[s][l] - current.a1[s][l]) * step;
+      delta.a2[s][l] = (target.a2[s][l] - current.a2[s][l]) * step;
+    }
+  }
+  ramping = true;
+}
+
+template <UInt L>
+void YSE::DSP::biQuadBank::run(const Flt * const * in, Flt * const * out, UInt length) {
+  // Samples are interleaved per lane in a small frame, so that the inner
+  // loop runs over the lanes with contiguous data. Coefficients and state
+  // are copied to locals, which tells the compiler that they don't alias
+  // the frame.
+  Flt frame[STANDARD_BUFFERSIZE][L];
+  Flt b0[L], b1[L], b2[L], a1[L], a2[L];
+  Flt d0[L], d1[L], d2[L], e1[L], e2[L];
+  Flt z1[L], z2[L];
+
+  for (UInt start = 0; start < length; start += STANDARD_BUFFERSIZE) {
+    UInt n = length - start < STANDARD_BUFFERSIZE ? length - start : STANDARD_BUFFERSIZE;
+
+    for (UInt l = 0; l < L; l++) {
+      if (in[l] == nullptr) {
+        for (UInt i = 0; i < n; i++) frame[i][l] = 0.f;
+      }
+      else {
+        const Flt * ptr = in[l] + start;
+        for (UInt i = 0; i < n; i++) frame[i][l] = ptr[i];
+      }
+    }
+
+    for (UInt s = 0; s < numStages; s++) {
+      for (UInt l = 0; l < L; l++) {
+        b0[l] = current.b0[s][l]; b1[l] = current.b1[s][l]; b2[l] = current.b2[s][l];
+        a1[l] = current.a1[s][l]; a2[l] = current.a2[s][l];
+        z1[l] = s1[s][l]; z2[l] = s2[s][l];
+      }
+
+      if (ramping) {
+        for (UInt l = 0; l < L; l++) {
+          d0[l] = delta.b0[s][l]; d1[l] = delta.b1[s][l]; d2[l] = delta.b2[s][l];
+          e1[l] = delta.a1[s][l]; e2[l] = delta.a2[s][l];
+        }
+        for (UInt i = 0; i < n; i++) {
+          for (UInt l = 0; l < L; l++) {
+            Flt x = frame[i][l];
+            Flt y = b0[l] * x + z1[l];
+            z1[l] = b1[l] * x - a1[l] * y + z2[l];
+            z2[l] = b2[l] * x - a2[l] * y;
+            frame[i][l] = y;
+            b0[l] += d0[l]; b1[l] += d1[l]; b2[l] += d2[l];
+            a1[l] += e1[l]; a2[l] += e2[l];
+          }
+        }
+        for (UInt l = 0; l < L; l++) {
+          current.b0[s][l] = b0[l]; current.b1[s][l] = b1[l]; current.b2[s][l] = b2[l];
+          current.a1[s][l] = a1[l]; current.a2[s][l] = a2[l];
+        }
+      }
+      else {
+        for (UInt i = 0; i < n; i++) {
+          for (UInt l = 0; l < L; l++) {
+            Flt x = frame[i][l];
+            Flt y = b0[l] * x + z1[l];
+            z1[l] = b1[l] * x - a1[l] * y + z2[l];
+            z2[l] = b2[l] * x - a2[l] * y;
+            frame[i][l] = y;
+          }
+        }
+      }
+
+      for (UInt l = 0; l < L; l++) {
+        s1[s][l] = z1[l]; s2[s][l] = z2[l];
+      }
+    }
+
+    for (UInt l = 0; l < L; l++) {
+      if (out[l] == nullptr) continue;
+      Flt * ptr = out[l] + start;
+      for (UInt i = 0; i < n; i++) ptr[i] = frame[i][l];
+    }
+  }
+}
+
+void YSE::DSP::biQuadBank::process(MULTICHANNELBUFFER & buffer) {
+  if (buffer.empty()) return;
+  UInt length = buffer[0].getLength();
+  update(length);
+
+  const Flt * in[BIQUAD_LANES] = { nullptr };
+  Flt * out[BIQUAD_LANES] = { nullptr };
+  for (UInt l = 0; l < numLanes && l < buffer.size(); l++) {
+    if (buffer[l].getLength() < length) continue;
+    out[l] = buffer[l].getPtr();
+    in[l] = out[l];
+  }
+
+  if (numLanes == 1) run<1>(in, out, length);
+  else if (numLanes <= 4) run<4>(in, out, length);
+  else run<8>(in, out, length);
+  started = true;
+}
+
+void YSE::DSP::biQuadBank::process(const buffer & in, buffer & out) {
+  UInt length = in.getLength();
+  if (out.getLength() != length) out.resize(length);
+  update(length);
+
+  const Flt * i[1] = { in.getPtr() };
+  Flt * o[1] = { out.getPtr() };
+  run<1>(i, o, length);
+  started = true;
+}
+
+void YSE::DSP::biQuadBank::process(const buffer & in, MULTICHANNELBUFFER & out) {
+  UInt length = in.getLength();
+  update(length);
+
+  const Flt * source = in.getConstPtr();
+  const Flt * i[BIQUAD_LANES] = { nullptr };
+  Flt * o[BIQUAD_LANES] = { nullptr };
+  for (UInt l = 0; l < numLanes && l < out.size(); l++) {
+    if (out[l].getLength() != length) out[l].resize(length);
+    i[l] = source;
+    o[l] = out[l].getPtr();
+  }
+
+  if (numLanes == 1) run<1>(i, o, length);
+  else if (numLanes <= 4) run<4>(i, o, length);
+  else run<8>(i, o, length);
+  started = true;
+}
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    biQuadBank.hpp
+    Created: 16 Oct 2026 9:02:18pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef BIQUADBANK_HPP_INCLUDED
+#define BIQUADBANK_HPP_INCLUDED
+
+#include "buffer.hpp"
+
+namespace YSE {
+  namespace DSP {
+
+    const UInt BIQUAD_LANES = 8;
+    const UInt BIQUAD_STAGES = 4;
+
+    /*
+    A cascade of up to BIQUAD_STAGES biquads for up to BIQUAD_LANES channels
+    at once. Every lane has its own coefficients, so a lane can be a channel
+    of a multichannel buffer, or one filter of a filter bank on the same input.
+    - The filters use transposed direct form II. Coefficients and state are
+    stored per lane, so that all lanes are calculated in one loop which the
+    compiler can vectorize.
+    - Coefficients are set from one control thread and become active after
+    publish(). The audio thread picks them up at the start of the next block
+    and interpolates from the old to the new values during that block.
+    Interpolated coefficients of two stable filters are stable as well.
+    - Nothing is allocated after construction.
+    */
+
+    class API biQuadBank {
+    public:
+      // normalized coefficients: y = b0*x + b1*x1 + b2*x2 - a1*y1 - a2*y2
+      struct coefficients {
+        Flt b0, b1, b2, a1, a2;
+      };
+
+      biQuadBank(UInt lanes = 1, UInt stages = 1);
+      biQuadBank(const biQuadBank & source);
+
+      // changes the number of lanes and stages in use and resets the filter
+      // state. This is not safe while the audio thread is processing.
+      biQuadBank & resize(UInt lanes, UInt stages);
+      UInt lanes() const { return numLanes; }
+      UInt stages() const { return numStages; }
+
+      // control thread: prepare new coefficients
+      biQuadBank & set(UInt lane, UInt stage, const coefficients & c);
+      biQuadBank & set(UInt stage, const coefficients & c); // all lanes
+      // control thread: make prepared coefficients visible to the audio thread
+      biQuadBank & publish();
+
+      // audio thread: forget the filter state
+      biQuadBank & clear();
+
+      // Filter every channel in place. Channel c uses lane c. Channels
+      // above the number of lanes are not changed.
+      void process(MULTICHANNELBUFFER & buffer);
+      // filter a mono buffer with lane 0
+      void process(const buffer & in, buffer & out);
+      // filter the same input with every lane, the output of lane l goes to out[l]
+      void process(const buffer & in, MULTICHANNELBUFFER & out);
+
+    private:
+      struct design {
+        Flt b0[BIQUAD_STAGES][BIQUAD_LANES];
+        Flt b1[BIQUAD_STAGES][BIQUAD_LANES];
+        Flt b2[BIQUAD_STAGES][BIQUAD_LANES];
+        Flt a1[BIQUAD_STAGES][BIQUAD_LANES];
+        Flt a2[BIQUAD_STAGES][BIQUAD_LANES];
+      };
+
+      void reset(design & d);
+      void update(UInt length);
+
+      template <UInt L>
+      void run(const Flt * const * in, Flt * const * out, UInt length);
+
+      UInt numLanes, numStages;
+
+      // Coefficients are passed on with three copies: the control thread
+      // writes to one, the audio thread reads from another and the third
+      // one is exchanged between them. 'shared' holds the index of the
+      // exchanged copy, plus FRESH when it holds coefficients that are not
+      // picked up yet.
+      design edit;
+      design slots[3];
+      UInt writeSlot, readSlot;
+      std::atomic<UInt> shared;
+
+      // coefficients in use, with the increment per sample while moving
+      // to the target coefficients in slots[readSlot]
+      design current, delta;
+      Bool ramping;
+      // new coefficients are used right away until the first block is done
+      Bool started;
+
+      Flt s1[BIQUAD_STAGES][BIQUAD_LANES];
+      Flt s2[BIQUAD_STAGES][BIQUAD_LANES];
+    };
+
+  }
+}
+
+#endif  // BIQUADBANK_HPP_INCLUDED
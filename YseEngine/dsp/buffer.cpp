@@ -18,13 +18,15 @@ namespace YSE {
     // don't move these constructors to the header file, because it will cause storage
     // vector to be allocated in the application memory instead of the dll memory, causing
     // a dll boundary crossing when resizing it later.
-    buffer::buffer(UInt length, UInt overflow) : storage(length + overflow), overflow(overflow) {}
+    buffer::buffer(UInt length, UInt overflow) : storage(length + overflow), overflow(overflow), zero(true) {}
     
-    buffer::buffer(const buffer & cp) : storage(cp.storage.size()) {
+    buffer::buffer(const buffer & cp) : storage(cp.storage.size()), zero(true) {
       operator=(cp);
     }
 
     buffer & buffer::operator+=(Flt f) {
+      if (f == 0) return (*this);
+      zero = false;
       UInt l = (UInt)storage.size();
       Flt * ptr = storage.data();
       for (; l > 7; l -= 8, ptr += 8) {
@@ -36,6 +38,10 @@ namespace YSE {
     }
 
     buffer & buffer::operator+=(const buffer & s) {
+      // adding silence changes nothing
+      if (s.zero) return (*this);
+      zero = false;
+
       // use length of shortest buffer to prevent memory errors
       UInt l = getLength() < s.getLength() ? getLength() : s.getLength();
       Flt * ptr1 = storage.data();
@@ -53,6 +59,8 @@ namespace YSE {
     }
 
     buffer & buffer::operator-=(Flt f) {
+      if (f == 0) return (*this);
+      zero = false;
       UInt l = (UInt)storage.size();
       Flt * ptr = storage.data();
       for (; l > 7; l -= 8, ptr += 8) {
@@ -64,6 +72,9 @@ namespace YSE {
     }
 
     buffer & buffer::operator-=(const buffer & s) {
+      if (s.zero) return (*this);
+      zero = false;
+
       // use length of shortest buffer to prevent memory errors
       UInt l = getLength() < s.getLength() ? getLength() : s.getLength();
       Flt * ptr1 = storage.data();
@@ -80,6 +91,8 @@ namespace YSE {
     }
 
     buffer & buffer::operator*=(Flt f) {
+      if (zero) return (*this);
+      if (f == 0) return operator=(0.f);
       UInt l = (UInt)storage.size();
       Flt * ptr = storage.data();
       for (; l > 7; l -= 8, ptr += 8) {
@@ -91,6 +104,9 @@ namespace YSE {
     }
 
     buffer & buffer::operator*=(const buffer & s) {
+      if (zero) return (*this);
+      if (s.zero && s.storage.size() >= storage.size()) return operator=(0.f);
+
       // use length of shortest buffer to prevent memory errors
       UInt l = getLength() < s.getLength() ? getLength() : s.getLength();
       Flt * ptr1 = storage.data();
@@ -107,6 +123,8 @@ namespace YSE {
     }
 
     buffer & buffer::operator/=(Flt f) {
+      if (zero) return (*this);
+      if (f == 0) return operator=(0.f);
       UInt l = (UInt)storage.size();
       Flt * ptr = storage.data();
       for (; l > 7; l -= 8, ptr += 8) {
@@ -124,6 +142,9 @@ namespace YSE {
     }
 
     buffer & buffer::operator/=(const buffer & s) {
+      if (zero) return (*this);
+      if (s.zero && s.storage.size() >= storage.size()) return operator=(0.f);
+
       // use length of shortest buffer to prevent memory errors
       UInt l = getLength() < s.getLength() ? getLength() : s.getLength();
       Flt * ptr1 = storage.data();
@@ -156,6 +177,10 @@ namespace YSE {
 
       overflow = s.overflow;
 
+      // a silent buffer only has to be cleared
+      if (s.zero) return operator=(0.f);
+      zero = false;
+
       UInt l = (UInt)storage.size();
       Flt * ptr1 = storage.data();
       const Flt * ptr2 = s.storage.data();
@@ -176,6 +201,8 @@ namespace YSE {
     }
 
     buffer & buffer::operator=(Flt f) {
+      if (f == 0 && zero) return (*this);
+      zero = (f == 0);
       UInt l = (UInt)storage.size();
       Flt * ptr1 = storage.data();
       for (; l > 7; l -= 8, ptr1 += 8) {
@@ -194,6 +221,7 @@ namespace YSE {
     }
 
 		bool buffer::isSilent() const {
+			if (zero) return true;
 			UInt l = (UInt)storage.size();
 			const Flt * ptr1 = storage.data();
 			for (; l > 7; l -= 8, ptr1 += 8) {
@@ -211,6 +239,27 @@ namespace YSE {
 			return true;
 		}
 
+		bool buffer::isSilent(Flt threshold) const {
+			if (zero) return true;
+			UInt l = getLength();
+			const Flt * ptr1 = storage.data();
+			for (; l > 7; l -= 8, ptr1 += 8) {
+				if (ptr1[0] > threshold || ptr1[0] < -threshold) return false;
+				if (ptr1[1] > threshold || ptr1[1] < -threshold) return false;
+				if (ptr1[2] > threshold || ptr1[2] < -threshold) return false;
+				if (ptr1[3] > threshold || ptr1[3] < -threshold) return false;
+				if (ptr1[4] > threshold || ptr1[4] < -threshold) return false;
+				if (ptr1[5] > threshold || ptr1[5] < -threshold) return false;
+				if (ptr1[6] > threshold || ptr1[6] < -threshold) return false;
+				if (ptr1[7] > threshold || ptr1[7] < -threshold) return false;
+			}
+			while (l--) {
+				if (*ptr1 > threshold || *ptr1 < -threshold) return false;
+				ptr1++;
+			}
+			return true;
+		}
+
 		float buffer::maxValue() const {
 			float max = -100.f;
 			UInt l = (UInt)storage.size();
@@ -237,6 +286,8 @@ namespace YSE {
       // TODO: don't just return if buffers are not long enough!
       if ((UInt)(sourcePos + length) > s.storage.size()) return (*this);
       if ((UInt)(destPos   + length) > storage.size()) return (*this);
+      if (s.zero && zero) return (*this);
+      zero = false;
 
       UInt l = length;
       Flt * ptr1 = storage.data() + destPos;
@@ -264,6 +315,10 @@ namespace YSE {
         return (*this);
       }
 
+      bool z = zero;
+      zero = s.zero;
+      s.zero = z;
+
       UInt l = (UInt)storage.size();
       Flt * ptr1 = storage.data();
       Flt * ptr2 = s.storage.data();
@@ -288,6 +343,7 @@ namespace YSE {
 
 
     buffer & buffer::resize(UInt length, Flt value) {
+      if (value != 0 && length + overflow > storage.size()) zero = false;
       storage.resize(length + overflow, value);
       return (*this);
     }
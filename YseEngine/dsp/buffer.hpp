@@ -17,6 +17,8 @@
 namespace YSE {
 
   namespace DSP {
+    template <typename E> class bufferExpression;
+
     /*
     - This class serves as a basic audio buffer. It can be used for low level
     audio operations where you need access to every frame in the buffer.
@@ -24,6 +26,9 @@ namespace YSE {
     allocate dynamic memory. This is too costly to do during callback
     functions.
     - Only the length functions are threadsafe.
+    - A buffer remembers when it contains nothing but zeros, so that
+    operations on silent buffers can be skipped. Getting write access with
+    getPtr() clears this flag, so use getConstPtr() to only read.
     */
 
     class API buffer {
@@ -41,12 +46,22 @@ namespace YSE {
       // gets the length of a sample in seconds
       inline Flt	getLengthSec() const { return ((storage.size() - overflow) / static_cast<Flt>(SAMPLERATE)); }
 
+			// true when all samples are known to be zero. A buffer can also be
+			// silent without this flag, so use isSilent() to be sure.
+			inline bool isZero() const { return zero; }
+
 			bool isSilent() const;
+			// true if no sample is louder than threshold
+			bool isSilent(Flt threshold) const;
 			float maxValue() const;
 
       // WARNING: try to avoid this function. It will give you write access
       // to the internal buffer, but there might be unexpected consequenses
-      inline Flt * getPtr() { return storage.data(); }
+      inline Flt * getPtr() { zero = false; return storage.data(); }
+      // read access, which leaves the flag alone
+      inline const Flt * getPtr() const { return storage.data(); }
+      // read access to a buffer which is not const
+      inline const Flt * getConstPtr() const { return storage.data(); }
 
       // Add the same value (f) to all samples in the buffer
       buffer & operator+=(Flt f);
@@ -64,6 +79,8 @@ namespace YSE {
 
       buffer & operator=(const buffer & s);
       buffer & operator=(Flt f);
+      // evaluates an expression like (a * b + c) in one pass, see bufferExpression.hpp
+      template <typename E> buffer & operator=(const bufferExpression<E> & expression);
       buffer & copyFrom(const buffer & s, UInt SourcePos, UInt DestPos, UInt length);
 
       buffer & swap(buffer & s);
@@ -101,6 +118,8 @@ namespace YSE {
       // vector is the requested size + overflow
       UInt overflow;
 
+      // all samples are zero
+      bool zero;
       
     };
   }
@@ -108,4 +127,6 @@ namespace YSE {
 
 
 
+#include "bufferExpression.hpp"
+
 #endif  // SAMPLE_H_INCLUDED
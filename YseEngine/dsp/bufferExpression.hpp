@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+
+    bufferExpression.hpp
+    Created: 16 Oct 2026 9:48:30pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef BUFFEREXPRESSION_HPP_INCLUDED
+#define BUFFEREXPRESSION_HPP_INCLUDED
+
+#include <type_traits>
+
+// included at the end of buffer.hpp
+
+namespace YSE {
+
+  namespace DSP {
+    /*
+    - Arithmetic on buffers with the binary operators +, -, * and / (and a
+    unary -) does not calculate anything. It builds an expression, which is
+    evaluated in a single loop when it is assigned to a buffer:
+
+        out += (a * b - c * d) * gain;
+
+    - This reads every input once and writes out once, without temporary
+    buffers. The loop has no function calls, so the compiler can vectorize it.
+    - Operands can be buffers (or derived classes), expressions and numbers.
+    - Expressions keep references to the buffers they use. Evaluate them
+    before these buffers go out of scope.
+    - An expression is as long as its shortest buffer. Assigning it to a
+    buffer never resizes that buffer: only the samples both have in common
+    are written, just like with the compound operators on buffers.
+    - Division returns zero where the divisor is zero, as buffer::operator/=
+    does.
+    - Expressions know when their result is silent, so that work on zero
+    buffers can be skipped.
+    */
+
+    template <typename E>
+    class bufferExpression {
+    public:
+      inline const E & self() const { return static_cast<const E &>(*this); }
+    };
+
+    namespace EXPRESSION {
+
+      // leaf that reads samples from a buffer
+      class bufferTerm : public bufferExpression<bufferTerm> {
+      public:
+        bufferTerm(const buffer & b) : ptr(b.getPtr()), length(b.getLength()), zero(b.isZero()) {}
+        inline Flt operator[](UInt i) const { return ptr[i]; }
+        inline UInt getLength() const { return length; }
+        inline bool isZero() const { return zero; }
+
+      private:
+        const Flt * ptr;
+        UInt length;
+        bool zero;
+      };
+
+      // leaf with the same value for every sample
+      class scalarTerm : public bufferExpression<scalarTerm> {
+      public:
+        scalarTerm(Flt value) : value(value) {}
+        inline Flt operator[](UInt) const { return value; }
+        inline UInt getLength() const { return ~0u; }
+        inline bool isZero() const { return value == 0; }
+
+      private:
+        Flt value;
+      };
+
+      struct add {
+        static inline Flt apply(Flt a, Flt b) { return a + b; }
+        static inline bool isZero(bool a, bool b) { return a && b; }
+      };
+
+      struct subtract {
+        static inline Flt apply(Flt a, Flt b) { return a - b; }
+        static inline bool isZero(bool a, bool b) { return a && b; }
+      };
+
+      struct multiply {
+        static inline Flt apply(Flt a, Flt b) { return a * b; }
+        static inline bool isZero(bool a, bool b) { return a || b; }
+      };
+
+      struct divide {
+        static inline Flt apply(Flt a, Flt b) { return b != 0 ? a / b : 0; }
+        static inline bool isZero(bool a, bool b) { return a || b; }
+      };
+
+      template <typename L, typename R, typename OP>
+      class binary : public bufferExpression<binary<L, R, OP> > {
+      public:
+        binary(const L & l, const R & r) : l(l), r(r) {}
+        inline Flt operator[](UInt i) const { return OP::apply(l[i], r[i]); }
+        inline UInt getLength() const {
+          return l.getLength() < r.getLength() ? l.getLength() : r.getLength();
+        }
+        inline bool isZero() const { return OP::isZero(l.isZero(), r.isZero()); }
+
+      private:
+        // nodes are small, so they are stored by value. This also makes it
+        // safe to keep an expression in a local variable.
+        L l;
+        R r;
+      };
+
+      template <typename E>
+      class negate : public bufferExpression<negate<E> > {
+      public:
+        negate(const E & e) : e(e) {}
+        inline Flt operator[](UInt i) const { return -e[i]; }
+        inline UInt getLength() const { return e.getLength(); }
+        inline bool isZero() const { return e.isZero(); }
+
+      private:
+        E e;
+      };
+
+      // maps an operand type to the node that reads it
+      template <typename T, typename Enable = void>
+      struct term {};
+
+      template <typename T>
+      struct term<T, typename std::enable_if<std::is_base_of<buffer, T>::value>::type> {
+        typedef bufferTerm type;
+        static const bool signal = true;
+      };
+
+      template <typename T>
+      struct term<T, typename std::enable_if<std::is_base_of<bufferExpression<T>, T>::value>::type> {
+        typedef T type;
+        static const bool signal = true;
+      };
+
+      template <typename T>
+      struct term<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+        typedef scalarTerm type;
+        static const bool signal = false;
+      };
+
+      // only defined when at least one operand is a signal, so that these
+      // operators never take part in arithmetic on plain numbers
+      template <typename L, typename R, typename OP, typename Enable = void>
+      struct result {};
+
+      template <typename L, typename R, typename OP>
+      struct result<L, R, OP, typename std::enable_if<term<L>::signal || term<R>::signal>::type> {
+        typedef binary<typename term<L>::type, typename term<R>::type, OP> type;
+      };
+
+      template <typename E>
+      inline void assign(buffer & out, const E & e) {
+        UInt l = out.getLength() < e.getLength() ? out.getLength() : e.getLength();
+        Flt * ptr = out.getPtr();
+        for (UInt i = 0; i < l; i++) ptr[i] = e[i];
+      }
+
+      template <typename E, typename OP>
+      inline void update(buffer & out, const E & e) {
+        UInt l = out.getLength() < e.getLength() ? out.getLength() : e.getLength();
+        Flt * ptr = out.getPtr();
+        for (UInt i = 0; i < l; i++) ptr[i] = OP::apply(ptr[i], e[i]);
+      }
+
+    } // namespace EXPRESSION
+
+    template <typename L, typename R>
+    inline typename EXPRESSION::result<L, R, EXPRESSION::add>::type operator+(const L & l, const R & r) {
+      return typename EXPRESSION::result<L, R, EXPRESSION::add>::type(l, r);
+    }
+
+    template <typename L, typename R>
+    inline typename EXPRESSION::result<L, R, EXPRESSION::subtract>::type operator-(const L & l, const R & r) {
+      return typename EXPRESSION::result<L, R, EXPRESSION::subtract>::type(l, r);
+    }
+
+    template <typename L, typename R>
+    inline typename EXPRESSION::result<L, R, EXPRESSION::multiply>::type operator*(const L & l, const R & r) {
+      return typename EXPRESSION::result<L, R, EXPRESSION::multiply>::type(l, r);
+    }
+
+    template <typename L, typename R>
+    inline typename EXPRESSION::result<L, R, EXPRESSION::divide>::type operator/(const L & l, const R & r) {
+      return typename EXPRESSION::result<L, R, EXPRESSION::divide>::type(l, r);
+    }
+
+    template <typename T>
+    inline EXPRESSION::negate<typename EXPRESSION::term<T>::type> operator-(const T & t) {
+      return EXPRESSION::negate<typename EXPRESSION::term<T>::type>(t);
+    }
+
+    template <typename E>
+    inline buffer & buffer::operator=(const bufferExpression<E> & expression) {
+      const E e = expression.self();
+      if (e.isZero() && e.getLength() >= getLength()) return operator=(0.f);
+      EXPRESSION::assign(*this, e);
+      copyOverflow();
+      return (*this);
+    }
+
+    template <typename E>
+    inline buffer & operator+=(buffer & out, const bufferExpression<E> & expression) {
+      const E e = expression.self();
+      if (e.isZero()) return out;
+      EXPRESSION::update<E, EXPRESSION::add>(out, e);
+      out.copyOverflow();
+      return out;
+    }
+
+    template <typename E>
+    inline buffer & operator-=(buffer & out, const bufferExpression<E> & expression) {
+      const E e = expression.self();
+      if (e.isZero()) return out;
+      EXPRESSION::update<E, EXPRESSION::subtract>(out, e);
+      out.copyOverflow();
+      return out;
+    }
+
+    template <typename E>
+    inline buffer & operator*=(buffer & out, const bufferExpression<E> & expression) {
+      const E e = expression.self();
+      if (out.isZero()) return out;
+      if (e.isZero() && e.getLength() >= out.getLength()) return out = 0.f;
+      EXPRESSION::update<E, EXPRESSION::multiply>(out, e);
+      out.copyOverflow();
+      return out;
+    }
+
+    template <typename E>
+    inline buffer & operator/=(buffer & out, const bufferExpression<E> & expression) {
+      const E e = expression.self();
+      if (out.isZero()) return out;
+      if (e.isZero() && e.getLength() >= out.getLength()) return out = 0.f;
+      EXPRESSION::update<E, EXPRESSION::divide>(out, e);
+      out.copyOverflow();
+      return out;
+    }
+
+  }
+}
+
+#endif  // BUFFEREXPRESSION_HPP_INCLUDED
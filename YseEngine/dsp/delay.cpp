@@ -8,15 +8,29 @@
   ==============================================================================
 */
 
+#include <string.h>
 #include "delay.hpp"
 
-#define XTRASAMPS 4
-#define DEFDELVS 64
-#define SAMPBLK 4
+YSE::DSP::delay::delay(Int size)
+  : lineLength(0)
+  , mask(0)
+  , guard(0)
+  , write(0)
+  , maxDelay(0)
+  , currentLength(STANDARD_BUFFERSIZE)
+  , size(size) {
+  allocate(STANDARD_BUFFERSIZE);
+}
 
-YSE::DSP::delay::delay(Int size) : bufferlength(size), buffer(size + XTRASAMPS), size(size) {}
-YSE::DSP::delay::delay(const YSE::DSP::delay & source) {
-  delay(source.size);
+YSE::DSP::delay::delay(const YSE::DSP::delay & source)
+  : lineLength(0)
+  , mask(0)
+  , guard(0)
+  , write(0)
+  , maxDelay(0)
+  , currentLength(STANDARD_BUFFERSIZE)
+  , size(source.size.load()) {
+  allocate(STANDARD_BUFFERSIZE);
 }
 
 YSE::DSP::delay& YSE::DSP::delay::setSize(UInt size) {
@@ -24,88 +38,179 @@ YSE::DSP::delay& YSE::DSP::delay::setSize(UInt size) {
   return (*this);
 }
 
-YSE::DSP::delay& YSE::DSP::delay::process(YSE::DSP::buffer & s) {
-  {
-    Int nsamps = (Int)(this->size * SAMPLERATE * 0.001f);
-    if (nsamps < 1) nsamps = 1;
-    nsamps += ((-nsamps) & (SAMPBLK - 1));
-    nsamps += DEFDELVS;
-    if ((Int)bufferlength != nsamps) {
-      buffer.resize(nsamps + XTRASAMPS, 0.f);
-      bufferlength = nsamps;
-      phase = XTRASAMPS;
-    }
-  }
+void YSE::DSP::delay::allocate(UInt blockLength) {
+  UInt samples = (UInt)(size * SAMPLERATE * 0.001f);
+  if (samples < 1) samples = 1;
+  maxDelay = samples;
+
+  // a tap can move a full block within a block, so the repeated part
+  // has to hold two blocks and the interpolation samples
+  UInt needed = samples + blockLength + 4;
+  UInt neededGuard = blockLength * 2 + 8;
+  if (needed <= lineLength && neededGuard <= guard) return;
+
+  UInt length = lineLength > 0 ? lineLength : 1;
+  while (length < needed) length <<= 1;
+  lineLength = length;
+  mask = length - 1;
+  if (neededGuard > guard) guard = neededGuard;
+  line.assign(lineLength + guard, 0.f);
+  write = 0;
+}
 
+YSE::DSP::delay& YSE::DSP::delay::process(YSE::DSP::buffer & s) {
   currentLength = s.getLength();
-  Flt * in = s.getPtr();
-  UInt length = currentLength;
-  Int ph = phase;
-  Flt * vp = buffer.data();
-  Flt * bp = vp + ph;
-  Flt * ep = vp + bufferlength + XTRASAMPS;
-  ph += currentLength;
-
-  while (length--) {
-    Flt f = *in++;
-    *bp++ = f;
-    if (bp == ep) {
-      vp[0] = ep[-4];
-      vp[1] = ep[-3];
-      vp[2] = ep[-2];
-      vp[3] = ep[-1];
-      bp = vp + XTRASAMPS;
-      ph -= bufferlength;
-    }
+  allocate(currentLength);
+
+  const Flt * in = s.getConstPtr();
+  Flt * vp = line.data();
+
+  // the block is written in at most two parts, because it can wrap around
+  UInt first = lineLength - write;
+  if (first > currentLength) first = currentLength;
+  memcpy(vp + write, in, first * sizeof(Flt));
+  if (first < currentLength) memcpy(vp, in + first, (currentLength - first) * sizeof(Flt));
+
+  // repeat the start of the line after its end
+  if (write < guard) {
+    UInt end = write + first < guard ? write + first : guard;
+    memcpy(vp + lineLength + write, vp + write, (end - write) * sizeof(Flt));
   }
-  bp = vp + phase;
-  phase = ph;
+  if (first < currentLength) {
+    UInt end = currentLength - first < guard ? currentLength - first : guard;
+    memcpy(vp + lineLength, vp, end * sizeof(Flt));
+  }
+
+  write = (write + currentLength) & mask;
+  return (*this);
+}
 
+YSE::DSP::delay& YSE::DSP::delay::clear() {
+  line.assign(line.size(), 0.f);
   return (*this);
 }
 
+Flt YSE::DSP::delay::toSamples(Flt delayTime) const {
+  Flt samples = delayTime * SAMPLERATE * 0.001f;
+  if (samples < 0) return 0;
+  if (samples > maxDelay) return static_cast<Flt>(maxDelay);
+  return samples;
+}
+
+UInt YSE::DSP::delay::blockStart(UInt delaySamples) const {
+  return (write + 2 * lineLength - currentLength - delaySamples) & mask;
+}
+
 YSE::DSP::delay& YSE::DSP::delay::read(YSE::DSP::buffer & result, UInt delayTime) {
   if (result.getLength() < currentLength) result.resize(currentLength);
-  UInt delaySamples = (UInt)(SAMPLERATE * delayTime * 0.001f) + currentLength;
-  if (delaySamples < result.getLength()) delaySamples = result.getLength();
-  else if (delaySamples > bufferlength - DEFDELVS) delaySamples = bufferlength - DEFDELVS;
-
-  Int ph = phase - delaySamples;
+  UInt delaySamples = static_cast<UInt>(toSamples(static_cast<Flt>(delayTime)));
+  memcpy(result.getPtr(), line.data() + blockStart(delaySamples), currentLength * sizeof(Flt));
+  return (*this);
+}
 
-  Flt * vp = buffer.data();
-  Flt * ep = vp + (bufferlength + XTRASAMPS);
-  if (ph < 0) ph += bufferlength;
-  Flt *bp = vp + ph;
+YSE::DSP::delay& YSE::DSP::delay::read(YSE::DSP::buffer & result, YSE::DSP::buffer & delayTime) {
+  if (result.getLength() < currentLength) result.resize(currentLength);
 
+  const Flt * ctrl = delayTime.getConstPtr();
   Flt * out = result.getPtr();
+  const Flt * vp = line.data();
+  UInt length = delayTime.getLength() < currentLength ? delayTime.getLength() : currentLength;
 
-  Int length = currentLength;
-  while (length--) {
-    *out++ = *bp++;
-    if (bp == ep) bp -= bufferlength;
+  // every frame can have another delay, so positions are wrapped one by one
+  UInt start = blockStart(0) + lineLength;
+  for (UInt i = 0; i < length; i++) {
+    Flt pos = start + i - toSamples(ctrl[i]);
+    UInt index = static_cast<UInt>(pos);
+    Flt fraction = pos - index;
+    Flt a = vp[index & mask];
+    Flt b = vp[(index + 1) & mask];
+    out[i] = a + (b - a) * fraction;
   }
 
   return (*this);
 }
 
-YSE::DSP::delay& YSE::DSP::delay::read(YSE::DSP::buffer & result, YSE::DSP::buffer & delayTime) {
+YSE::DSP::delay& YSE::DSP::delay::readLinear(YSE::DSP::buffer & result, Flt delayTime) {
   if (result.getLength() < currentLength) result.resize(currentLength);
 
-  Flt * ctrl = delayTime.getPtr();
+  Flt samples = toSamples(delayTime);
+  UInt whole = static_cast<UInt>(samples);
+  Flt fraction = samples - whole;
+
+  // b[i] is one sample older than b[i + 1]
+  const Flt * b = line.data() + blockStart(whole + 1);
   Flt * out = result.getPtr();
+  for (UInt i = 0; i < currentLength; i++) {
+    out[i] = b[i + 1] + (b[i] - b[i + 1]) * fraction;
+  }
+
+  return (*this);
+}
+
+YSE::DSP::delay& YSE::DSP::delay::readAllpass(YSE::DSP::buffer & result, Flt delayTime, Flt & state) {
+  if (result.getLength() < currentLength) result.resize(currentLength);
 
-  Flt * vp = buffer.data();
-  //Flt * ep = vp + (impl->bufferlength + XTRASAMPS);
+  Flt samples = toSamples(delayTime);
+  UInt whole = static_cast<UInt>(samples);
+  Flt fraction = samples - whole;
 
-  for (UInt i = 0; i < result.getLength(); i++) {
-    UInt delaySamples = (UInt)(SAMPLERATE * ctrl[i] * 0.001f) + currentLength;
-    if (delaySamples < result.getLength()) delaySamples = result.getLength();
-    else if (delaySamples > bufferlength - DEFDELVS) delaySamples = bufferlength - DEFDELVS;
+  // a fraction close to zero puts the pole of the filter close to -1
+  if (fraction < 0.1f && whole > 0) {
+    whole--;
+    fraction += 1.f;
+  }
+  const Flt coefficient = (1.f - fraction) / (1.f + fraction);
 
-    Int ph = phase - delaySamples + i;
-    if (ph < 0) ph += bufferlength;
-    Flt *bp = vp + ph;
-    *out++ = *bp;
+  const Flt * b = line.data() + blockStart(whole + 1);
+  Flt * out = result.getPtr();
+  Flt y = state;
+  for (UInt i = 0; i < currentLength; i++) {
+    y = coefficient * (b[i + 1] - y) + b[i];
+    out[i] = y;
+  }
+  state = y;
+
+  return (*this);
+}
+
+YSE::DSP::delay& YSE::DSP::delay::readTaps(YSE::DSP::buffer & result, UInt taps, const Flt * startTime, const Flt * endTime, const Flt * gain) {
+  if (result.getLength() < currentLength) result.resize(currentLength);
+  result = 0.f;
+
+  Flt * out = result.getPtr();
+  const Flt length = static_cast<Flt>(currentLength);
+  for (UInt t = 0; t < taps; t++) {
+    const Flt g = gain[t];
+    if (g == 0) continue;
+
+    Flt start = toSamples(startTime[t]);
+    Flt end = toSamples(endTime[t]);
+    if (end > start + length) end = start + length;
+    else if (end < start - length) end = start - length;
+
+    if (start == end) {
+      // a fixed tap reads at the same fraction for the whole block
+      UInt whole = static_cast<UInt>(start);
+      Flt fraction = start - whole;
+      const Flt * b = line.data() + blockStart(whole + 1);
+      for (UInt i = 0; i < currentLength; i++) {
+        out[i] += (b[i + 1] + (b[i] - b[i + 1]) * fraction) * g;
+      }
+    }
+    else {
+      // a moving tap is read relative to its longest delay in this block,
+      // so that the read position never goes before the start of b
+      UInt top = static_cast<UInt>(start > end ? start : end) + 1;
+      const Flt * b = line.data() + blockStart(top);
+      Flt pos = top - start;
+      const Flt step = 1.f - (end - start) / length;
+      for (UInt i = 0; i < currentLength; i++) {
+        UInt index = static_cast<UInt>(pos);
+        Flt fraction = pos - index;
+        out[i] += (b[index] + (b[index + 1] - b[index]) * fraction) * g;
+        pos += step;
+      }
+    }
   }
 
   return (*this);
@@ -113,7 +218,7 @@ YSE::DSP::delay& YSE::DSP::delay::read(YSE::DSP::buffer & result, YSE::DSP::buff
 
 
 void YSE::DSP::readInterpolated(YSE::DSP::buffer & ctrl, YSE::DSP::buffer& out, YSE::DSP::buffer & buffer, UInt &pos) {
-  Flt * input = ctrl.getPtr();
+  const Flt * input = ctrl.getConstPtr();
   Flt * output = out.getPtr();
   Int n = ctrl.getLength();
   Int nsamps = buffer.getLength();
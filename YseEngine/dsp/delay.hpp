@@ -21,13 +21,17 @@ namespace YSE {
   namespace DSP {
     /** Delay keeps an internal delay line of variable length. You can read from a delay
         at any given position, which enables you to get a delayed buffer as a result.
+
+        The delay line has a length of a power of two. The start of the line is
+        repeated after its end, so that a block can always be read without wrapping
+        around. All delay times are in milliseconds.
     */
     class API delay {
     public:
       /** Changes the length of the delay line. Longer delay lines use more memory, 
           but allow for longer delays.
 
-          @param size   the size of the delay line.
+          @param size   the size of the delay line in milliseconds.
       */
       delay& setSize(UInt size); 
 
@@ -37,6 +41,10 @@ namespace YSE {
       */
       delay& process(buffer & buffer); 
 
+      /** Set all samples in the delay line to zero.
+      */
+      delay& clear();
+
       /** Read from the delay at a fixed point and store the required
           part of the buffer in result.
 
@@ -49,7 +57,8 @@ namespace YSE {
       delay& read(buffer& result, UInt delayTime); 
 
       /** Read from the delay at a variable point and store the required
-          part of the buffer in result.
+          part of the buffer in result. Delays between samples are 
+          interpolated linearly.
 
           @param result     This buffer will receive the audio read from the
                             delay.
@@ -58,19 +67,59 @@ namespace YSE {
       */
       delay& read(buffer & result, buffer & delayTime); // read from delay at variable point
 
+      /** Read from the delay at a fractional delay time, with linear interpolation.
+      */
+      delay& readLinear(buffer & result, Flt delayTime);
+
+      /** Read from the delay at a fractional delay time, with allpass interpolation.
+          This keeps the full frequency range, but the delay time should not change
+          much between calls. 
+
+          @param state      The state of the allpass filter. Use a separate value 
+                            for every read position and initialize it to zero.
+      */
+      delay& readAllpass(buffer & result, Flt delayTime, Flt & state);
+
+      /** Read several taps in one pass and store their sum in result. Every tap
+          moves from its start time to its end time during the block, which makes
+          this usable for modulated delays like chorus and flanger. Linear 
+          interpolation is used.
+
+          A delay time can change by at most the length of a block within one block.
+          Larger changes will take more than one block.
+
+          @param taps       The number of taps.
+          @param startTime  The delay time of every tap at the start of the block.
+          @param endTime    The delay time of every tap at the end of the block.
+          @param gain       The gain of every tap.
+      */
+      delay& readTaps(buffer & result, UInt taps, const Flt * startTime, const Flt * endTime, const Flt * gain);
+
       /** Create a delay line.
 
-          @param size   The initial length of the delay line. This can be changed
-                        afterwards, but it's faster if you provide the correct 
-                        size when creating the object.
+          @param size   The initial length of the delay line in milliseconds. This 
+                        can be changed afterwards, but it's faster if you provide the
+                        correct size when creating the object.
       */
       delay(Int size);
       delay(const delay &);
 
     private:
-      UInt bufferlength;
-      std::vector<Flt> buffer;
-      Int phase;
+      // make sure the line can hold the current size and block length
+      void allocate(UInt blockLength);
+
+      // convert a delay time to samples, within the size of the delay line
+      Flt toSamples(Flt delayTime) const;
+
+      // start of the current block in the line, delayed by the given samples
+      UInt blockStart(UInt delaySamples) const;
+
+      std::vector<Flt> line; // the delay line, followed by a copy of its start
+      UInt lineLength; // a power of two
+      UInt mask;
+      UInt guard; // the part of the line which is repeated after the end
+      UInt write; // where the next block will be written
+      UInt maxDelay; // longest delay in samples
 
       UInt currentLength; // the sample length for this loop
       aUInt size;
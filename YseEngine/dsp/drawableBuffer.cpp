@@ -33,7 +33,7 @@ namespace YSE {
       Flt fraction = 0.f;
       Flt envelopeValue = env[0].value;
 
-      Flt * ptr = storage.data();
+      Flt * ptr = getPtr();
 
       for (UInt i = 0; i < storage.size(); i++)
       {
@@ -66,7 +66,7 @@ namespace YSE {
       //if (stop < start) return *this; // don't do this
 
       Flt frac = (stopValue - startValue) / static_cast<Flt>(stop - start > 1 ? stop - start : 1); // don't divide by zero
-      Flt * ptr = storage.data();
+      Flt * ptr = getPtr();
       Flt value = startValue;
       for (UInt i = start; i < stop; i++) {
         ptr[i] = value;
@@ -81,7 +81,7 @@ namespace YSE {
       //Clamp(stop, 1, impl->length.load());
       //if (stop < start) return *this; // don't do this
 
-      Flt * ptr = storage.data();
+      Flt * ptr = getPtr();
       for (UInt i = start; i < stop; i++) {
         ptr[i] = value;
       }
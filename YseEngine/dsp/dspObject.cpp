@@ -8,7 +8,23 @@
   ==============================================================================
 */
 
+#include <atomic>
 #include "dspObject.hpp"
+#include "../internalHeaders.h"
+
+namespace {
+  // signals below -100dB are considered silent
+  const Flt silenceThreshold = 0.00001f;
+
+  std::atomic<UInt> dormantCount(0);
+
+  Bool isSilent(const MULTICHANNELBUFFER & buffer) {
+    for (UInt i = 0; i < buffer.size(); i++) {
+      if (!buffer[i].isSilent(silenceThreshold)) return false;
+    }
+    return true;
+  }
+}
 
 YSE::DSP::dspSourceObject::dspSourceObject(Int buffers) {
   samples.resize(buffers);
@@ -30,19 +46,141 @@ YSE::DSP::dspObject::dspObject()
 	next(nullptr),
     previous(nullptr), 
     _bypass(false), 
+    _bypassTarget(false),
+    _bypassFrame(0),
+    _bypassPending(false),
+    _dryGain(0.f),
     _needsCreate(true),
+    _autoSleep(false),
+    _dormant(false),
+    _silentSamples(0),
 	_impact(1.f),
     _lfoType(LFO_NONE),
-	_lfoFrequency(0.f)
+	_lfoFrequency(0.f),
+    _lfoControlRate(true)
     {
   lfoOsc.reset(new lfo);
   invertedImpact.reset(new inverter);
+  unprocessed.reset(new MULTICHANNELBUFFER);
 }
 
 YSE::DSP::dspObject::~dspObject() {
   if (previous != nullptr) previous->next = next;
   if (next != nullptr) next->previous = previous;
   if (calledfrom) *calledfrom = nullptr;
+  if (_dormant) dormantCount--;
+}
+
+YSE::DSP::dspObject & YSE::DSP::dspObject::bypass(Bool value, unsigned long long frame) {
+  _bypassPending = false;
+  _bypassTarget = value;
+  _bypassFrame = frame;
+  _bypassPending = true;
+  return *this;
+}
+
+void YSE::DSP::dspObject::prepare(UInt channels) {
+  MULTICHANNELBUFFER & dry = *unprocessed;
+  if (dry.size() != channels) dry.resize(channels);
+}
+
+void YSE::DSP::dspObject::processOrSleep(MULTICHANNELBUFFER & buffer) {
+  UInt length = buffer.empty() ? 0 : buffer[0].getLength();
+
+  // a timed change that is due in this block starts at its frame
+  UInt from = 0;
+  if (_bypassPending) {
+    ULong start = DEVICE::Manager().frame();
+    ULong at = _bypassFrame;
+    if (at < start + length) {
+      from = at > start ? static_cast<UInt>(at - start) : 0;
+      _bypass = _bypassTarget.load();
+      _bypassPending = false;
+    }
+  }
+
+  Bool bypassNow = _bypass;
+  Flt target = bypassNow ? 1.f : 0.f;
+  if (_dryGain == target) {
+    if (!bypassNow) processIfAwake(buffer);
+    return;
+  }
+
+  // keep the input, to fade from or to it. This only allocates when the number
+  // of channels is not the one the object was prepared for.
+  MULTICHANNELBUFFER & dry = *unprocessed;
+  if (dry.size() != buffer.size()) dry.resize(buffer.size());
+  for (UInt i = 0; i < buffer.size(); i++) {
+    dry[i] = buffer[i];
+  }
+
+  processIfAwake(buffer);
+
+  // the fade takes one block, and continues in the next one when it starts later
+  Flt step = (bypassNow ? 1.f : -1.f) / STANDARD_BUFFERSIZE;
+  Flt gain = _dryGain;
+  for (UInt i = 0; i < buffer.size(); i++) {
+    gain = _dryGain;
+    UInt l = buffer[i].getLength() < dry[i].getLength() ? buffer[i].getLength() : dry[i].getLength();
+    if (dry[i].isZero() && buffer[i].isZero()) {
+      if (l > from) gain += step * (l - from);
+      continue;
+    }
+    Flt * out = buffer[i].getPtr();
+    const Flt * in = dry[i].getConstPtr();
+    for (UInt j = 0; j < l; j++) {
+      if (j >= from && gain != target) {
+        gain += step;
+        if ((step > 0 && gain > target) || (step < 0 && gain < target)) gain = target;
+      }
+      out[j] += (in[j] - out[j]) * gain;
+    }
+  }
+  if ((step > 0 && gain > target) || (step < 0 && gain < target)) gain = target;
+  _dryGain = gain;
+}
+
+void YSE::DSP::dspObject::processIfAwake(MULTICHANNELBUFFER & buffer) {
+  if (!_autoSleep || buffer.empty()) {
+    if (_dormant) {
+      _dormant = false;
+      dormantCount--;
+    }
+    process(buffer);
+    return;
+  }
+
+  // wake up as soon as there is input
+  if (!isSilent(buffer)) {
+    if (_dormant) {
+      _dormant = false;
+      dormantCount--;
+    }
+    _silentSamples = 0;
+    process(buffer);
+    return;
+  }
+
+  // the input is silent, so a dormant object has nothing to add
+  if (_dormant) return;
+
+  // otherwise keep processing until the tail has decayed
+  process(buffer);
+  if (!isSilent(buffer)) {
+    _silentSamples = 0;
+    return;
+  }
+
+  _silentSamples += buffer[0].getLength();
+  if (_silentSamples > tailGap()) {
+    _dormant = true;
+    dormantCount++;
+    clearTail();
+  }
+}
+
+UInt YSE::DSP::dspObject::dormantObjects() {
+  return dormantCount;
 }
 
 void YSE::DSP::dspObject::createIfNeeded() {
@@ -53,6 +191,36 @@ void YSE::DSP::dspObject::createIfNeeded() {
 }
 
 void YSE::DSP::dspObject::calculateImpact(buffer & in, buffer & filtered) {
+  if (_lfoControlRate) {
+    Flt impact = _impact;
+    LFO_TYPE type = _lfoType;
+    Flt frequency = _lfoFrequency;
+
+    // without lfo, the impact is the same for every frame
+    if (type == LFO_NONE || frequency == 0) {
+      if (impact >= 1.f) in = filtered;
+      else if (impact > 0.f) in += (filtered - in) * impact;
+      return;
+    }
+
+    // in = in * (1 - m) + filtered * m, in a single pass, with m
+    // interpolated between lfo values
+    UInt length = in.getLength() < filtered.getLength() ? in.getLength() : filtered.getLength();
+    Flt * out = in.getPtr();
+    const Flt * f = filtered.getConstPtr();
+    Flt from = lfoOsc->control(type, frequency, 0) * impact;
+    for (UInt pos = 0; pos < length; pos += CONTROL_BLOCKSIZE) {
+      UInt n = length - pos < CONTROL_BLOCKSIZE ? length - pos : CONTROL_BLOCKSIZE;
+      Flt to = lfoOsc->control(type, frequency, n) * impact;
+      Flt step = (to - from) / n;
+      for (UInt i = 0; i < n; i++) {
+        out[pos + i] += (f[pos + i] - out[pos + i]) * (from + step * i);
+      }
+      from = to;
+    }
+    return;
+  }
+
   buffer & lfoImpact = (*lfoOsc)(_lfoType, _lfoFrequency);
   lfoImpact *= _impact;
   buffer & inImpact = (*invertedImpact)(lfoImpact, true);
@@ -35,6 +35,27 @@ namespace YSE {
       virtual void create() = 0;
       virtual void process(MULTICHANNELBUFFER & buffer) = 0;
 
+      // Process the buffer, unless this object is bypassed or dormant: its input is
+      // silent and its own output has decayed. A dormant object is skipped until the
+      // input is not silent anymore. When bypass changes, the output fades between
+      // the processed and the unprocessed signal over one block, starting at the
+      // frame of the change. Use this instead of process() to run a dsp chain.
+      void processOrSleep(MULTICHANNELBUFFER & buffer);
+
+      // Allocate what processOrSleep needs for this number of channels. The sound and
+      // channel interfaces call this before the object is passed to the audio thread,
+      // so that the audio thread does not have to.
+      void prepare(UInt channels);
+
+      // Automatic sleep is off by default. Objects which know how long their output
+      // can stay silent while a tail is still coming (see tailGap) turn it on.
+      dspObject& autoSleep(Bool value) { _autoSleep = value; return *this; }
+      Bool       autoSleep() { return _autoSleep; }
+      Bool       dormant() { return _dormant; }
+
+      // the number of dsp objects which are dormant right now
+      static UInt dormantObjects();
+
       // link the output of this dsp to another dsp.
       // If the dsp is already linked, the new dsp will
       // be put between this object and the current next
@@ -42,9 +63,13 @@ namespace YSE {
       void link(dspObject& next);
       dspObject * link();
 
-      dspObject& bypass(Bool value) { _bypass = value; return *this; }
+      dspObject& bypass(Bool value) { _bypassPending = false; _bypass = value; return *this; }
       Bool       bypass() { return _bypass; }
 
+      // Change bypass at a frame on the device clock (see System().frame()). Only one
+      // timed change is kept: a new one replaces a change that has not happened yet.
+      dspObject& bypass(Bool value, unsigned long long frame);
+
       // impact of this filter. Must be between 0 and 1
       dspObject& impact(Flt value) { _impact = value; return *this; }
       Flt impact() { return _impact; }
@@ -55,6 +80,12 @@ namespace YSE {
       dspObject & lfoFrequency(Flt value) { _lfoFrequency = value; return *this; }
       Flt lfoFrequency() { return _lfoFrequency; }
 
+      // The lfo on the impact is calculated once every CONTROL_BLOCKSIZE frames and
+      // interpolated in between, while the result is mixed. This is on by default.
+      // Turn it off to calculate the lfo for every frame.
+      dspObject & lfoControlRate(Bool value) { _lfoControlRate = value; return *this; }
+      Bool lfoControlRate() { return _lfoControlRate; }
+
       dspObject ** calledfrom; // consider this private for now
 
     protected:
@@ -64,19 +95,39 @@ namespace YSE {
       buffer & getLFO();
       // call this at end of process()
       void calculateImpact(buffer & in, buffer & filtered);
-      
+
+      // The longest time in samples that the output of this object can be silent
+      // while there's still something left to output, like the time of a delay.
+      // The object will not go to sleep before its output has been silent this long.
+      virtual UInt tailGap() { return 0; }
+
+      // Called when the object goes dormant. Clear state here that would otherwise
+      // play back when the object wakes up again.
+      virtual void clearTail() {}
 
     private:
+      // process() with automatic sleep, but without bypass
+      void processIfAwake(MULTICHANNELBUFFER & buffer);
+
       dspObject * next;
       dspObject * previous;
-      Bool _bypass;
+      aBool _bypass;
+      aBool _bypassTarget; // timed bypass change
+      std::atomic<unsigned long long> _bypassFrame;
+      aBool _bypassPending;
+      Flt _dryGain; // the part of the unprocessed signal in the output, at the end of the last block
       Bool _needsCreate;
+      Bool _autoSleep;
+      Bool _dormant;
+      UInt _silentSamples;
       aFlt _impact;
 
       std::shared_ptr<lfo> lfoOsc;
       std::shared_ptr<inverter> invertedImpact;
+      std::shared_ptr<MULTICHANNELBUFFER> unprocessed; // input kept for a bypass fade
       LFO_TYPE _lfoType;
       aFlt _lfoFrequency;
+      aBool _lfoControlRate;
     };
 
     // simple base class for a dsp object with sound generation
@@ -12,56 +12,57 @@
 #include <math.h>
 #include "../utils/misc.hpp"
 
-YSE::DSP::filterBase::filterBase() : freq(0), gain(0), q(0),
-last(0), previous(0),
-coef1(0), coef2(0),
-ff1(0), ff2(0), ff3(0), fb1(0), fb2(0) {
+YSE::DSP::filterBase::filterBase() : freq(0), gain(0), q(0), passThrough(false) {
 }
 
-YSE::DSP::filterBase::filterBase(const YSE::DSP::filterBase & source)  {
+YSE::DSP::filterBase::filterBase(const YSE::DSP::filterBase & source) : bank(source.bank) {
   freq.store(source.freq);
   gain.store(source.gain);
   q = source.q;
-  last = source.last;
-  previous = source.previous;
-  coef1.store(source.coef1);
-  coef2.store(source.coef2);
-  ff1.store(source.ff1);
-  ff2.store(source.ff2);
-  ff3.store(source.ff3);
-  fb1.store(source.fb1);
-  fb2.store(source.fb2);
+  passThrough.store(source.passThrough);
 }
 
+void YSE::DSP::filterBase::setCoefficients(Flt b0, Flt b1, Flt b2, Flt a1, Flt a2) {
+  biQuadBank::coefficients c = { b0, b1, b2, a1, a2 };
+  bank.set(0, c).publish();
+}
+
+YSE::DSP::buffer & YSE::DSP::filterBase::apply(YSE::DSP::buffer & in) {
+  if (passThrough) {
+    bank.clear();
+    return in;
+  }
+  bank.process(in, samples);
+  return samples;
+}
+
+void YSE::DSP::filterBase::process(MULTICHANNELBUFFER & buffer) {
+  if (passThrough) {
+    bank.clear();
+    return;
+  }
+  UInt lanes = buffer.size() < BIQUAD_LANES ? buffer.size() : BIQUAD_LANES;
+  if (lanes > 0 && bank.lanes() != lanes) bank.resize(lanes, 1);
+  bank.process(buffer);
+}
+
+/*******************************************************************************************/
+
 YSE::DSP::highPass& YSE::DSP::highPass::setFrequency(Flt f) {
   if (f < 0) f = 0;
   freq = f;
-  coef1 = 1 - f * (2 * 3.14159f) / SAMPLERATE;
-  Clamp(coef1, 0.f, 1.f);
+  Flt coef = 1 - f * (2 * 3.14159f) / SAMPLERATE;
+  Clamp(coef, 0.f, 1.f);
+
+  // y[n] = x[n] - x[n-1] + coef * y[n-1], which does nothing at all when coef is 1
+  setCoefficients(1, -1, 0, -coef, 0);
+  passThrough = coef >= 1;
 
   return (*this);
 }
 
 YSE::DSP::buffer & YSE::DSP::highPass::operator()(YSE::DSP::buffer & in) {
-  if (in.getLength() != samples.getLength()) samples.resize(in.getLength());
-
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = samples.getPtr();
-  UInt length = in.getLength();
-  Flt coef = coef1;
-  if (coef < 1) {
-    for (UInt i = 0; i < length; i++) {
-      Flt f = *inPtr++ + coef * last;
-      *outPtr++ = f - last;
-      last = f;
-    }
-  }
-  else {
-    last = 0;
-    return in;
-  }
-
-  return samples;
+  return apply(in);
 }
 
 /*******************************************************************************************/
@@ -70,25 +71,17 @@ YSE::DSP::buffer & YSE::DSP::highPass::operator()(YSE::DSP::buffer & in) {
 YSE::DSP::lowPass& YSE::DSP::lowPass::setFrequency(Flt f) {
   if (f < 0) f = 0;
   freq = f;
-  coef1 = f * (2 * 3.14159f) / SAMPLERATE;
-  Clamp(coef1, 0.f, 1.f);
+  Flt coef = f * (2 * 3.14159f) / SAMPLERATE;
+  Clamp(coef, 0.f, 1.f);
+
+  // y[n] = coef * x[n] + (1 - coef) * y[n-1]
+  setCoefficients(coef, 0, 0, coef - 1, 0);
 
   return (*this);
 }
 
 YSE::DSP::buffer & YSE::DSP::lowPass::operator()(YSE::DSP::buffer & in) {
-  if (in.getLength() != samples.getLength()) samples.resize(in.getLength());
-
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = samples.getPtr();
-  UInt length = in.getLength();
-
-  Flt feedback = 1 - coef1;
-  for (UInt i = 0; i < length; i++) {
-    last = *outPtr++ = coef1 * *inPtr++ + feedback * last;
-  }
-
-  return samples;
+  return apply(in);
 }
 
 /*******************************************************************************************/
@@ -122,10 +115,13 @@ void YSE::DSP::bandPass::calcCoef() {
   else oneminusr = omega / q;
   if (oneminusr >  1.0f) oneminusr = 1.0f;
   r = 1.0f - oneminusr;
-  coef1 = 2.0f * qCos(omega) * r;
-  coef2 = -r * r;
+  Flt coef1 = 2.0f * qCos(omega) * r;
+  Flt coef2 = -r * r;
 
   gain = 2 * oneminusr * (oneminusr + r * omega);
+
+  // y[n] = gain * x[n] + coef1 * y[n-1] + coef2 * y[n-2]
+  setCoefficients(gain, 0, 0, -coef1, -coef2);
 }
 
 float YSE::DSP::bandPass::qCos(Flt omega) {
@@ -141,24 +137,7 @@ YSE::DSP::bandPass::bandPass() {
 }
 
 YSE::DSP::buffer & YSE::DSP::bandPass::operator()(YSE::DSP::buffer & in) {
-  if (in.getLength() != samples.getLength()) samples.resize(in.getLength());
-
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = samples.getPtr();
-  UInt length = in.getLength();
-
-  // copy to Flt because we don't want atomic in whole buffer loops
-  Flt cf1 = coef1;
-  Flt cf2 = coef2;
-
-  for (UInt i = 0; i < length; i++) {
-    Flt output = *inPtr++ + cf1 * last + cf2 * previous;
-    *outPtr++ = gain * output;
-    previous = last;
-    last = output;
-  }
-
-  return samples;
+  return apply(in);
 }
 
 /*******************************************************************************************/
@@ -199,6 +178,11 @@ YSE::DSP::biQuad& YSE::DSP::biQuad::set(BQ_TYPE type, Flt frequency, Flt Q, Flt
 }
 
 YSE::DSP::biQuad& YSE::DSP::biQuad::setRaw(Flt fb1, Flt fb2, Flt ff1, Flt ff2, Flt ff3) {
+  publish(fb1, fb2, ff1, ff2, ff3);
+  return (*this);
+}
+
+void YSE::DSP::biQuad::publish(Flt fb1, Flt fb2, Flt ff1, Flt ff2, Flt ff3) {
   Flt discriminant = fb1 * fb1 + 4 * fb2;
   Bool zero = true;
   if (discriminant < 0) {
@@ -208,45 +192,21 @@ YSE::DSP::biQuad& YSE::DSP::biQuad::setRaw(Flt fb1, Flt fb2, Flt ff1, Flt ff2, F
     if (fb1 <= 2.0f && fb1 >= -2.0f && 1.0f - fb1 - fb2 >= 0 && 1.0f + fb1 - fb2 >= 0) zero = false;
   }
   if (zero) fb1 = fb2 = ff1 = ff2 = ff3 = 0;
-  this->fb1 = fb1;
-  this->fb2 = fb2;
-  this->ff1 = ff1;
-  this->ff2 = ff2;
-  this->ff3 = ff3;
 
-  return (*this);
+  // w[n] = x[n] + fb1 * w[n-1] + fb2 * w[n-2]
+  // y[n] = ff1 * w[n] + ff2 * w[n-1] + ff3 * w[n-2]
+  setCoefficients(ff1, ff2, ff3, -fb1, -fb2);
 }
 
 YSE::DSP::buffer & YSE::DSP::biQuad::operator()(YSE::DSP::buffer & in) {
-  if (in.getLength() != samples.getLength()) samples.resize(in.getLength());
-
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = samples.getPtr();
-  UInt length = in.getLength();
-
-  Flt output;
-
-  // copy to float because we don't want atomic to be used in a whole buffer calculation
-  Flt b1 = fb1;
-  Flt b2 = fb2;
-  Flt f1 = ff1;
-  Flt f2 = ff2;
-  Flt f3 = ff3;
-
-  for (UInt i = 0; i < length; i++) {
-    output = *inPtr++ + b1 * last + b2 * previous;
-    *outPtr++ = f1 * output + f2 * last + f3 * previous;
-    previous = last;
-    last = output;
-  }
-
-  return samples;
+  return apply(in);
 }
 
 
 
 void YSE::DSP::biQuad::calc() {
   Flt norm;
+  Flt ff1 = 0, ff2 = 0, ff3 = 0, fb1 = 0, fb2 = 0;
   Flt v = (float)pow(10, std::abs(gain.load()) / 20.0f);
   Flt k = tan(Pi * freq / static_cast<Flt>(SAMPLERATE));
 
@@ -255,7 +215,7 @@ void YSE::DSP::biQuad::calc() {
                      norm = 1 / (1 + k / q + k * k);
                      ff1 = k * k * norm;
                      ff2 = 2 * ff1;
-                     ff3 = ff1.load();
+                     ff3 = ff1;
                      fb1 = 2 * (k * k - 1) * norm;
                      fb2 = (1 - k / q + k * k) * norm;
                      break;
@@ -264,7 +224,7 @@ void YSE::DSP::biQuad::calc() {
                       norm = 1 / (1 + k / q + k * k);
                       ff1 = 1 * norm;
                       ff2 = -2 * ff1;
-                      ff3 = ff1.load();
+                      ff3 = ff1;
                       fb1 = 2 * (k * k - 1) * norm;
                       fb2 = (1 - k / q + k * k) * norm;
                       break;
@@ -282,8 +242,8 @@ void YSE::DSP::biQuad::calc() {
                    norm = 1 / (1 + k / q + k * k);
                    ff1 = (1 + k * k) * norm;
                    ff2 = 2 * (k * k - 1) * norm;
-                   ff3 = ff1.load();
-                   fb1 = ff2.load();
+                   ff3 = ff1;
+                   fb1 = ff2;
                    fb2 = (1 - k / q + k * k) * norm;
                    break;
   }
@@ -293,7 +253,7 @@ void YSE::DSP::biQuad::calc() {
                     ff1 = (1 + v / q * k + k * k) * norm;
                     ff2 = 2 * (k * k - 1) * norm;
                     ff3 = (1 - v / q * k + k * k) * norm;
-                    fb1 = ff2.load();
+                    fb1 = ff2;
                     fb2 = (1 - 1 / q * k + k * k) * norm;
                   }
                   else {
@@ -301,7 +261,7 @@ void YSE::DSP::biQuad::calc() {
                     ff1 = (1 + 1 / q * k + k * k) * norm;
                     ff2 = 2 * (k * k - 1) * norm;
                     ff3 = (1 - 1 / q * k + k * k) * norm;
-                    fb1 = ff2.load();
+                    fb1 = ff2;
                     fb2 = (1 - v / q * k + k * k) * norm;
                   }
                   break;
@@ -346,18 +306,7 @@ void YSE::DSP::biQuad::calc() {
 
   }
   }
-  fb1 = -fb1;
-  fb2 = -fb2;
-
-  Flt discriminant = fb1 * fb1 + 4 * fb2;
-  Bool zero = true;
-  if (discriminant < 0) {
-    if (fb2 >= -1.0f) zero = false;
-  }
-  else {
-    if (fb1 <= 2.0f && fb1 >= -2.0f && 1.0f - fb1 - fb2 >= 0 && 1.0f + fb1 - fb2 >= 0) zero = false;
-  }
-  if (zero) fb1 = fb2 = ff1 = ff2 = ff3 = 0;
+  publish(-fb1, -fb2, ff1, ff2, ff3);
 }
 
 /*******************************************************************************************/
@@ -378,8 +327,8 @@ YSE::DSP::sampleHold& YSE::DSP::sampleHold::set(Flt value) {
 YSE::DSP::buffer & YSE::DSP::sampleHold::operator()(YSE::DSP::buffer & in, YSE::DSP::buffer & signal) {
   if (in.getLength() != samples.getLength()) samples.resize(in.getLength());
 
-  Flt * inPtr = in.getPtr();
-  Flt * sigPtr = signal.getPtr();
+  const Flt * inPtr = in.getConstPtr();
+  const Flt * sigPtr = signal.getConstPtr();
   Flt * outPtr = samples.getPtr();
   UInt length = in.getLength();
 
@@ -12,12 +12,15 @@
 #define FILTERS_H_INCLUDED
 
 #include "buffer.hpp"
+#include "biQuadBank.hpp"
 #include "../headers/enums.hpp"
 
 namespace YSE {
   namespace DSP {
 
     // base class for all filters - don't use
+    // All filters run on a biQuadBank. Settings can be changed from one
+    // other thread and take effect, smoothed, at the next buffer.
     class API filterBase {
     public:
       filterBase();
@@ -25,14 +28,22 @@ namespace YSE {
       
       virtual buffer & operator()(buffer & in) = 0;
 
+      // Filter all channels in place with the same settings. This is cheaper
+      // than a filter per channel, but only the first BIQUAD_LANES channels
+      // are filtered.
+      void process(MULTICHANNELBUFFER & buffer);
+
     protected:
+      // publish new coefficients, as used by biQuadBank
+      void setCoefficients(Flt b0, Flt b1, Flt b2, Flt a1, Flt a2);
+      // filter a mono buffer
+      buffer & apply(buffer & in);
+
       aFlt freq;
       aFlt gain;
       Flt q;
-      Flt last;
-      Flt previous;
-      aFlt coef1, coef2;
-      aFlt ff1, ff2, ff3, fb1, fb2;
+      aBool passThrough;
+      biQuadBank bank;
       buffer samples;
     };
 
@@ -87,6 +98,8 @@ namespace YSE {
 
     private:
       void calc();
+      // check stability and pass the coefficients on to the filter
+      void publish(Flt fb1, Flt fb2, Flt ff1, Flt ff2, Flt ff3);
       BQ_TYPE type;
     };
 
@@ -10,28 +10,27 @@
 
 #include <cassert>
 #include "fft.hpp"
-#include "mayer.h"
+#include "fftPlan.h"
 #include "../math_functions.h"
 
-// flip function for real fft
-static void flip(int length, Flt * in, Flt * out) {
-  while (length--) *(--out) = -*in++;
-}
-
-// zero function for real fft
-static void zero(Flt * in, int length) {
-  for (; length > 7; length -= 8, in += 8) {
-    in[0] = 0; in[1] = 0; in[2] = 0; in[3] = 0;
-    in[4] = 0; in[5] = 0; in[6] = 0; in[7] = 0;
+// Find the plan for a new length and make room for the work arrays. This
+// only allocates when the length changes.
+static const YSE::DSP::fftPlan * prepare(const YSE::DSP::fftPlan * plan, UInt length, std::vector<Flt> & work, UInt workLength) {
+  if (plan == nullptr || plan->length() != length) {
+    plan = YSE::DSP::fftPlan::get(length);
+    assert(plan != nullptr); // length must be a power of two
   }
-
-  while (length--) *in++ = 0;
+  if (work.size() < workLength) work.resize(workLength);
+  return plan;
 }
 
 /******************************************************************
 ** fft
 *******************************************************************/
 
+YSE::DSP::fft::fft() : plan(nullptr) {
+}
+
 YSE::DSP::buffer & YSE::DSP::fft::getReal() {
   return real;
 }
@@ -48,19 +47,22 @@ YSE::DSP::buffer & YSE::DSP::fft::operator()(YSE::DSP::buffer & realIn, YSE::DSP
   if (realIn.getLength() != real.getLength()) real.resize(realIn.getLength());
   if (imaginaryIn.getLength() != imaginary.getLength()) imaginary.resize(imaginaryIn.getLength());
 
-  if (real.getPtr() == imaginaryIn.getPtr() && imaginary.getPtr() == realIn.getPtr()) {
+  if (real.getPtr() == imaginaryIn.getConstPtr() && imaginary.getPtr() == realIn.getConstPtr()) {
     real.swap(imaginary);
   }
-  else if (real.getPtr() == imaginaryIn.getPtr()) {
+  else if (real.getPtr() == imaginaryIn.getConstPtr()) {
     real = realIn;
     imaginary = imaginaryIn;
   }
   else {
-    if (real.getPtr() != realIn.getPtr()) real = realIn;
-    if (imaginary.getPtr() != imaginaryIn.getPtr()) imaginary = imaginaryIn;
+    if (real.getPtr() != realIn.getConstPtr()) real = realIn;
+    if (imaginary.getPtr() != imaginaryIn.getConstPtr()) imaginary = imaginaryIn;
   }
 
-  mayer_fft(real.getLength(), real.getPtr(), imaginary.getPtr());
+  UInt n = real.getLength();
+  plan = prepare(plan, n, work, 2 * n);
+  if (plan == nullptr) return real;
+  plan->forward(real.getPtr(), imaginary.getPtr(), work.data(), work.data() + n);
 
   return real;
 }
@@ -69,6 +71,9 @@ YSE::DSP::buffer & YSE::DSP::fft::operator()(YSE::DSP::buffer & realIn, YSE::DSP
 ** inverseFft
 *******************************************************************/
 
+YSE::DSP::inverseFft::inverseFft() : plan(nullptr) {
+}
+
 YSE::DSP::buffer & YSE::DSP::inverseFft::getReal() {
   return real;
 }
@@ -85,19 +90,22 @@ YSE::DSP::buffer & YSE::DSP::inverseFft::operator()(YSE::DSP::buffer & realIn, Y
   if (realIn.getLength() != real.getLength()) real.resize(realIn.getLength());
   if (imaginaryIn.getLength() != imaginary.getLength()) imaginary.resize(imaginaryIn.getLength());
   
-  if (real.getPtr() == imaginaryIn.getPtr() && imaginary.getPtr() == realIn.getPtr()) {
+  if (real.getPtr() == imaginaryIn.getConstPtr() && imaginary.getPtr() == realIn.getConstPtr()) {
     real.swap(imaginary);
   }
-  else if (real.getPtr() == imaginaryIn.getPtr()) {
+  else if (real.getPtr() == imaginaryIn.getConstPtr()) {
     real = realIn;
     imaginary = imaginaryIn;
   }
   else {
-    if (real.getPtr() != realIn.getPtr()) real = realIn;
-    if (imaginary.getPtr() != imaginaryIn.getPtr()) imaginary = imaginaryIn;
+    if (real.getPtr() != realIn.getConstPtr()) real = realIn;
+    if (imaginary.getPtr() != imaginaryIn.getConstPtr()) imaginary = imaginaryIn;
   }
 
-  mayer_ifft(real.getLength(), real.getPtr(), imaginary.getPtr());
+  UInt n = real.getLength();
+  plan = prepare(plan, n, work, 2 * n);
+  if (plan == nullptr) return real;
+  plan->inverse(real.getPtr(), imaginary.getPtr(), work.data(), work.data() + n);
 
   return real;
 }
@@ -106,6 +114,9 @@ YSE::DSP::buffer & YSE::DSP::inverseFft::operator()(YSE::DSP::buffer & realIn, Y
 ** realFft
 *******************************************************************/
 
+YSE::DSP::realFft::realFft() : plan(nullptr) {
+}
+
 YSE::DSP::buffer & YSE::DSP::realFft::getReal() {
   return real;
 }
@@ -119,23 +130,17 @@ YSE::DSP::buffer & YSE::DSP::realFft::operator()(YSE::DSP::buffer & in) {
   if (in.getLength() != real.getLength()) real.resize(in.getLength());
   if (in.getLength() != imaginary.getLength()) imaginary.resize(in.getLength());
 
-  int n = in.getLength();
-  int n2 = (n >> 1);
+  UInt n = in.getLength();
 
   if (n < 4) {
     assert(false); // minimum length is 4
     return real;
   }
 
-  if (in.getPtr() != real.getPtr()) {
-    real = in;
-  }
-  mayer_realfft(real.getLength(), real.getPtr());
-  flip(n2 - 1, real.getPtr() + (n2 + 1), imaginary.getPtr() + n2);
-  zero(real.getPtr() + (n2 + 1), ((n2 - 1)&(~7)));
-  zero(real.getPtr() + (n2 + 1) + ((n2 - 1)&(~7)), ((n2 - 1) & 7));
-  zero(imaginary.getPtr() + n2, n2);
-  zero(imaginary.getPtr(), 1);
+  plan = prepare(plan, n, work, n);
+  if (plan == nullptr) return real;
+  const YSE::DSP::buffer & source = in;
+  plan->realForward(source.getConstPtr(), real.getPtr(), imaginary.getPtr(), work.data(), work.data() + n / 2);
 
   return real;
 }
@@ -144,6 +149,9 @@ YSE::DSP::buffer & YSE::DSP::realFft::operator()(YSE::DSP::buffer & in) {
 ** inverseRealFft
 *******************************************************************/
 
+YSE::DSP::inverseRealFft::inverseRealFft() : plan(nullptr) {
+}
+
 YSE::DSP::buffer & YSE::DSP::inverseRealFft::getReal() {
   return real;
 }
@@ -155,24 +163,20 @@ YSE::DSP::buffer & YSE::DSP::inverseRealFft::operator()(YSE::DSP::buffer & realI
 
   if (realIn.getLength() != real.getLength()) real.resize(realIn.getLength());
 
-  int n = realIn.getLength();
-  int n2 = (n >> 1);
+  UInt n = realIn.getLength();
 
   if (n < 4) {
     assert(false); // minimum length is 4
     return real;
   }
 
-  if (imaginaryIn.getPtr() == real.getPtr()) {
-    flip(n2 - 1, real.getPtr() + 1, real.getPtr() + n);
-    real.copyFrom(realIn, 0, 0, n2 + 1);
-  }
-  else {
-    if (realIn.getPtr() != real.getPtr()) real.copyFrom(realIn, 0, 0, n2 + 1);
-    flip(n2 - 1, imaginaryIn.getPtr() + 1, real.getPtr() + n);
-  }
-
-  mayer_realifft(real.getLength(), real.getPtr());
+  // the input is read completely before the output is written, so
+  // both may be the result buffer
+  plan = prepare(plan, n, work, 2 * n);
+  if (plan == nullptr) return real;
+  const YSE::DSP::buffer & re = realIn;
+  const YSE::DSP::buffer & im = imaginaryIn;
+  plan->realInverse(re.getPtr(), im.getPtr(), real.getPtr(), work.data(), work.data() + n);
 
   return real;
 }
@@ -194,22 +198,25 @@ void YSE::DSP::fftStats::operator()(YSE::DSP::buffer & real, YSE::DSP::buffer &
     assert(false);
   }
 
-  int n = real.getLength();
-  int n2 = (n >> 1);
+  UInt n = real.getLength();
+  UInt n2 = (n >> 1);
 
   if (n < 4) {
     assert(false);
     return;
   }
 
-  Flt * inReal = real.getPtr();
-  Flt * inImag = imaginary.getPtr();
+  if (frequencies.getLength() != n) frequencies.resize(n);
+  if (amplitudes.getLength() != n) amplitudes.resize(n);
+
+  const Flt * inReal = real.getConstPtr();
+  const Flt * inImag = imaginary.getConstPtr();
   Flt * freq = frequencies.getPtr();
   Flt * amp = amplitudes.getPtr();
 
   Flt lastReal = 0, currentReal = inReal[0], nextReal = inReal[1];
   Flt lastImag = 0, currentImag = inImag[0], nextImag = inImag[1];
-  int m = n2 + 1;
+  UInt m = n2 + 1;
   Flt fbin = 1, oneOverN2 = 1.f / ((Flt)n2 * (Flt)n2);
 
   inReal += 2;
@@ -17,8 +17,17 @@
 namespace YSE {
   namespace DSP {
 
+    class fftPlan;
+
+    /*
+    All transforms need a power of two length and are not normalized. Tables
+    for each length are calculated once and shared by all objects. Memory is
+    only allocated when the length changes.
+    */
+
     class API fft {
     public:
+      fft();
 
       // updates the object and returns real part
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & real, YSE::DSP::buffer & imaginary);
@@ -27,10 +36,13 @@ namespace YSE {
 
     private:
       buffer real, imaginary;
+      const fftPlan * plan;
+      std::vector<Flt> work;
     };
 
     class API inverseFft {
     public:
+      inverseFft();
 
       // updates the object and returns real part
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & real, YSE::DSP::buffer & imaginary);
@@ -39,25 +51,35 @@ namespace YSE {
 
     private:
       buffer real, imaginary;
+      const fftPlan * plan;
+      std::vector<Flt> work;
     };
 
     class API realFft {
     public:
+      realFft();
+
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in);
       YSE::DSP::buffer & getReal();
       YSE::DSP::buffer & getImaginary();
 
     private:
       buffer real, imaginary;
+      const fftPlan * plan;
+      std::vector<Flt> work;
     };
 
     class API inverseRealFft {
     public:
+      inverseRealFft();
+
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & real, YSE::DSP::buffer & imaginary);
       YSE::DSP::buffer & getReal();
 
     private:
       buffer real;
+      const fftPlan * plan;
+      std::vector<Flt> work;
     };
 
     class API fftStats {
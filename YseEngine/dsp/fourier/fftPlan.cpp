@@ -0,0 +1,264 @@
+/*
+  ==============================================================================
+
+    fftPlan.cpp
+    Created: 16 Oct 2026 9:48:05pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include <atomic>
+#include <math.h>
+#include <string.h>
+#include "fftPlan.h"
+
+namespace {
+  const UInt MAX_ORDER = 24;
+  const Dbl PI = 3.14159265358979323846;
+
+  // One plan per power of two. A plan is published with compare_exchange,
+  // so that threads which need the same new plan at the same time agree on
+  // one of them.
+  struct planCache {
+    std::atomic<YSE::DSP::fftPlan*> plans[MAX_ORDER + 1];
+
+    planCache() {
+      for (UInt i = 0; i <= MAX_ORDER; i++) plans[i] = nullptr;
+    }
+
+    ~planCache() {
+      for (UInt i = 0; i <= MAX_ORDER; i++) delete plans[i].load();
+    }
+  };
+
+  planCache & Plans() {
+    static planCache c;
+    return c;
+  }
+
+  Int order(UInt length) {
+    if (length == 0 || (length & (length - 1))) return -1;
+    Int result = 0;
+    while ((1u << result) < length) result++;
+    return result;
+  }
+}
+
+const YSE::DSP::fftPlan * YSE::DSP::fftPlan::get(UInt length) {
+  Int o = order(length);
+  if (o < 0 || o > (Int)MAX_ORDER) return nullptr;
+
+  std::atomic<fftPlan*> & slot = Plans().plans[o];
+  fftPlan * plan = slot.load();
+  if (plan != nullptr) return plan;
+
+  fftPlan * created = new fftPlan(length);
+  if (slot.compare_exchange_strong(plan, created)) return created;
+
+  // another thread was first
+  delete created;
+  return plan;
+}
+
+YSE::DSP::fftPlan::fftPlan(UInt length) : size(length), half(nullptr) {
+  // twiddles for every radix 4 stage, calculated in double precision
+  for (UInt n = length; n >= 4; n /= 4) {
+    UInt m = n / 4;
+    UInt offset = twiddles.size();
+    twiddles.resize(offset + 6 * m);
+    Flt * t = twiddles.data() + offset;
+    for (UInt p = 0; p < m; p++) {
+      Dbl theta = -2.0 * PI * p / n;
+      t[p] = (Flt)cos(theta);
+      t[p + m] = (Flt)sin(theta);
+      t[p + 2 * m] = (Flt)cos(2 * theta);
+      t[p + 3 * m] = (Flt)sin(2 * theta);
+      t[p + 4 * m] = (Flt)cos(3 * theta);
+      t[p + 5 * m] = (Flt)sin(3 * theta);
+    }
+  }
+
+  if (length >= 4) {
+    half = get(length / 2);
+    realCos.resize(length / 4 + 1);
+    realSin.resize(length / 4 + 1);
+    for (UInt k = 0; k <= length / 4; k++) {
+      Dbl theta = -2.0 * PI * k / length;
+      realCos[k] = (Flt)cos(theta);
+      realSin[k] = (Flt)sin(theta);
+    }
+  }
+}
+
+void YSE::DSP::fftPlan::forward(Flt * real, Flt * imaginary, Flt * workReal, Flt * workImaginary) const {
+  Flt * xr = real;
+  Flt * xi = imaginary;
+  Flt * yr = workReal;
+  Flt * yi = workImaginary;
+  const Flt * t = twiddles.data();
+
+  // Every stage splits the transforms of length n in four transforms of
+  // length n / 4, which are interleaved with stride s in the output
+  UInt n = size;
+  UInt s = 1;
+  while (n >= 4) {
+    UInt m = n / 4;
+    const Flt * w1r = t;
+    const Flt * w1i = t + m;
+    const Flt * w2r = t + 2 * m;
+    const Flt * w2i = t + 3 * m;
+    const Flt * w3r = t + 4 * m;
+    const Flt * w3i = t + 5 * m;
+
+    for (UInt p = 0; p < m; p++) {
+      const Flt c1 = w1r[p], s1 = w1i[p];
+      const Flt c2 = w2r[p], s2 = w2i[p];
+      const Flt c3 = w3r[p], s3 = w3i[p];
+      const Flt * ar = xr + s * p;
+      const Flt * ai = xi + s * p;
+      const Flt * br = ar + s * m;
+      const Flt * bi = ai + s * m;
+      const Flt * cr = br + s * m;
+      const Flt * ci = bi + s * m;
+      const Flt * dr = cr + s * m;
+      const Flt * di = ci + s * m;
+      Flt * out0r = yr + s * 4 * p;
+      Flt * out0i = yi + s * 4 * p;
+      Flt * out1r = out0r + s;
+      Flt * out1i = out0i + s;
+      Flt * out2r = out1r + s;
+      Flt * out2i = out1i + s;
+      Flt * out3r = out2r + s;
+      Flt * out3i = out2i + s;
+
+      for (UInt q = 0; q < s; q++) {
+        Flt apcR = ar[q] + cr[q], apcI = ai[q] + ci[q];
+        Flt amcR = ar[q] - cr[q], amcI = ai[q] - ci[q];
+        Flt bpdR = br[q] + dr[q], bpdI = bi[q] + di[q];
+        // j * (b - d)
+        Flt jbmdR = di[q] - bi[q], jbmdI = br[q] - dr[q];
+
+        out0r[q] = apcR + bpdR;
+        out0i[q] = apcI + bpdI;
+
+        Flt r = amcR - jbmdR, i = amcI - jbmdI;
+        out1r[q] = r * c1 - i * s1;
+        out1i[q] = r * s1 + i * c1;
+
+        r = apcR - bpdR; i = apcI - bpdI;
+        out2r[q] = r * c2 - i * s2;
+        out2i[q] = r * s2 + i * c2;
+
+        r = amcR + jbmdR; i = amcI + jbmdI;
+        out3r[q] = r * c3 - i * s3;
+        out3i[q] = r * s3 + i * c3;
+      }
+    }
+
+    t += 6 * m;
+    n = m;
+    s *= 4;
+    Flt * swap = xr; xr = yr; yr = swap;
+    swap = xi; xi = yi; yi = swap;
+  }
+
+  // odd powers of two end with a radix 2 stage
+  if (n == 2) {
+    for (UInt q = 0; q < s; q++) {
+      Flt ar = xr[q], ai = xi[q];
+      Flt br = xr[q + s], bi = xi[q + s];
+      yr[q] = ar + br;
+      yi[q] = ai + bi;
+      yr[q + s] = ar - br;
+      yi[q + s] = ai - bi;
+    }
+    Flt * swap = xr; xr = yr; yr = swap;
+    swap = xi; xi = yi; yi = swap;
+  }
+
+  if (xr != real) {
+    memcpy(real, xr, size * sizeof(Flt));
+    memcpy(imaginary, xi, size * sizeof(Flt));
+  }
+}
+
+void YSE::DSP::fftPlan::inverse(Flt * real, Flt * imaginary, Flt * workReal, Flt * workImaginary) const {
+  // the inverse is the forward transform with real and imaginary swapped
+  forward(imaginary, real, workImaginary, workReal);
+}
+
+void YSE::DSP::fftPlan::realForward(const Flt * in, Flt * real, Flt * imaginary, Flt * workReal, Flt * workImaginary) const {
+  // Even and odd samples are the real and imaginary part of a complex
+  // transform of half the length. The bins are separated afterwards.
+  UInt m = size / 2;
+  for (UInt k = 0; k < m; k++) {
+    Flt even = in[2 * k];
+    Flt odd = in[2 * k + 1];
+    real[k] = even;
+    imaginary[k] = odd;
+  }
+  half->forward(real, imaginary, workReal, workImaginary);
+
+  Flt z0r = real[0], z0i = imaginary[0];
+  real[0] = z0r + z0i;
+  imaginary[0] = 0;
+  real[m] = z0r - z0i;
+  imaginary[m] = 0;
+
+  for (UInt k = 1; k <= m / 2; k++) {
+    Flt zkr = real[k], zki = imaginary[k];
+    Flt zmr = real[m - k], zmi = imaginary[m - k];
+
+    // transforms of the even and odd samples
+    Flt er = 0.5f * (zkr + zmr), ei = 0.5f * (zki - zmi);
+    Flt or_ = 0.5f * (zki + zmi), oi = -0.5f * (zkr - zmr);
+
+    Flt wr = realCos[k], wi = realSin[k];
+    Flt tr = wr * or_ - wi * oi;
+    Flt ti = wr * oi + wi * or_;
+
+    real[k] = er + tr;
+    imaginary[k] = ei + ti;
+    real[m - k] = er - tr;
+    imaginary[m - k] = ti - ei;
+  }
+
+  memset(real + m + 1, 0, (m - 1) * sizeof(Flt));
+  memset(imaginary + m + 1, 0, (m - 1) * sizeof(Flt));
+}
+
+void YSE::DSP::fftPlan::realInverse(const Flt * real, const Flt * imaginary, Flt * out, Flt * workReal, Flt * workImaginary) const {
+  UInt m = size / 2;
+  Flt * zr = workReal;
+  Flt * zi = workImaginary;
+
+  zr[0] = real[0] + real[m];
+  zi[0] = real[0] - real[m];
+
+  for (UInt k = 1; k <= m / 2; k++) {
+    Flt xkr = real[k], xki = imaginary[k];
+    Flt xmr = real[m - k], xmi = imaginary[m - k];
+
+    // e = x[k] + conj(x[m - k]), d = x[k] - conj(x[m - k])
+    Flt er = xkr + xmr, ei = xki - xmi;
+    Flt dr = xkr - xmr, di = xki + xmi;
+
+    // j * conj(w) * d
+    Flt wr = realCos[k], wi = -realSin[k];
+    Flt tr = -(wr * di + wi * dr);
+    Flt ti = wr * dr - wi * di;
+
+    zr[k] = er + tr;
+    zi[k] = ei + ti;
+    zr[m - k] = er - tr;
+    zi[m - k] = ti - ei;
+  }
+
+  half->inverse(zr, zi, workReal + m, workImaginary + m);
+
+  for (UInt k = 0; k < m; k++) {
+    out[2 * k] = zr[k];
+    out[2 * k + 1] = zi[k];
+  }
+}
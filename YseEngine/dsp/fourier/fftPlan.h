@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    fftPlan.h
+    Created: 16 Oct 2026 9:48:05pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef FFTPLAN_H_INCLUDED
+#define FFTPLAN_H_INCLUDED
+
+#include <vector>
+#include "../../headers/types.hpp"
+
+namespace YSE {
+  namespace DSP {
+
+    /*
+    Precomputed twiddle factors for one power of two length. A plan is created
+    the first time its length is used and is then shared by all transforms of
+    that length, on all threads. Plans are never changed or deleted afterwards,
+    so no locking is needed to use them.
+
+    Transforms use split real and imaginary arrays and are not normalized: a
+    forward and inverse transform multiply the input by the length. The
+    complex transform is a radix 4 Stockham autosort FFT, which needs no bit
+    reversal and has contiguous inner loops that the compiler can vectorize.
+    */
+    class fftPlan {
+    public:
+      // returns nullptr if length is not a power of two
+      static const fftPlan * get(UInt length);
+
+      UInt length() const { return size; }
+
+      // Complex transform of length values, in place. The work arrays must
+      // hold length values each.
+      void forward(Flt * real, Flt * imaginary, Flt * workReal, Flt * workImaginary) const;
+      void inverse(Flt * real, Flt * imaginary, Flt * workReal, Flt * workImaginary) const;
+
+      // Transform of length real values. Bins 0 to length / 2 are written to
+      // real and imaginary, which must hold length values each. The other
+      // values are set to zero. The work arrays must hold length / 2 values.
+      // in may be the same array as real.
+      void realForward(const Flt * in, Flt * real, Flt * imaginary, Flt * workReal, Flt * workImaginary) const;
+
+      // Inverse of realForward, using bins 0 to length / 2. The work arrays
+      // must hold length values each. out may be the same array as real
+      // or imaginary.
+      void realInverse(const Flt * real, const Flt * imaginary, Flt * out, Flt * workReal, Flt * workImaginary) const;
+
+    private:
+      fftPlan(UInt length);
+
+      UInt size;
+
+      // per radix 4 stage: the real and imaginary parts of w, w^2 and w^3
+      std::vector<Flt> twiddles;
+
+      // e^(-2 pi i k / length) for k up to length / 4, and the plan of half
+      // this length, which does the work for real transforms
+      std::vector<Flt> realCos, realSin;
+      const fftPlan * half;
+    };
+
+  }
+}
+
+#endif  // FFTPLAN_H_INCLUDED
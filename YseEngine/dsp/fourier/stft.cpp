@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    stft.cpp
+    Created: 16 Oct 2026 10:31:47pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <math.h>
+#include <string.h>
+#include "stft.hpp"
+
+namespace {
+  const Dbl PI = 3.14159265358979323846;
+
+  // periodic windows, because frames overlap
+  Flt windowValue(YSE::WINDOW_TYPE type, UInt n, UInt size) {
+    Dbl phase = 2.0 * PI * n / size;
+    switch (type) {
+      case YSE::WT_HANN: return (Flt)(0.5 - 0.5 * cos(phase));
+      case YSE::WT_HAMMING: return (Flt)(0.54 - 0.46 * cos(phase));
+      case YSE::WT_BLACKMAN: return (Flt)(0.42 - 0.5 * cos(phase) + 0.08 * cos(2 * phase));
+      default: return 1.f;
+    }
+  }
+}
+
+YSE::DSP::stft::stft(UInt fftSize, UInt hop, WINDOW_TYPE window) : size(0), hopSize(0), usePolar(false), position(0) {
+  setup(fftSize, hop, window);
+}
+
+YSE::DSP::stft & YSE::DSP::stft::setup(UInt fftSize, UInt hop, WINDOW_TYPE window) {
+  if (fftSize < 4 || (fftSize & (fftSize - 1))) {
+    assert(false); // fftSize must be a power of two
+    return *this;
+  }
+  if (hop == 0 || hop > fftSize || fftSize % hop) {
+    assert(false); // hop must divide fftSize
+    return *this;
+  }
+
+  size = fftSize;
+  hopSize = hop;
+
+  analysis.resize(size);
+  for (UInt n = 0; n < size; n++) analysis[n] = windowValue(window, n, size);
+
+  // Every output sample is the sum of size / hop frames. Dividing the window
+  // by the sum of the squared windows at that position makes analysis and
+  // resynthesis transparent. The fft scale is included as well.
+  std::vector<Dbl> overlap(hop, 0.0);
+  for (UInt n = 0; n < size; n++) overlap[n % hop] += (Dbl)analysis[n] * analysis[n];
+  synthesis.resize(size);
+  for (UInt n = 0; n < size; n++) {
+    Dbl sum = overlap[n % hop];
+    synthesis[n] = sum > 0 ? (Flt)(analysis[n] / (sum * size)) : 0.f;
+  }
+
+  inFifo.resize(size);
+  outSum.resize(size);
+  outReady.resize(hop);
+  windowed.resize(size);
+
+  // run both transforms once, so that they don't allocate while processing
+  windowed = 0.f;
+  forward(windowed);
+  inverse(forward.getReal(), forward.getImaginary());
+
+  return clear();
+}
+
+YSE::DSP::stft & YSE::DSP::stft::clear() {
+  std::fill(inFifo.begin(), inFifo.end(), 0.f);
+  std::fill(outSum.begin(), outSum.end(), 0.f);
+  std::fill(outReady.begin(), outReady.end(), 0.f);
+  position = size - hopSize;
+  return *this;
+}
+
+void YSE::DSP::stft::process(buffer & in) {
+  if (size == 0) return;
+
+  Flt * ptr = in.getPtr();
+  UInt length = in.getLength();
+  UInt start = size - hopSize;
+
+  for (UInt i = 0; i < length; i++) {
+    inFifo[position] = ptr[i];
+    ptr[i] = outReady[position - start];
+    if (++position == size) {
+      frame();
+      position = start;
+    }
+  }
+}
+
+void YSE::DSP::stft::frame() {
+  Flt * w = windowed.getPtr();
+  for (UInt n = 0; n < size; n++) w[n] = inFifo[n] * analysis[n];
+
+  forward(windowed);
+  buffer & real = forward.getReal();
+  buffer & imaginary = forward.getImaginary();
+  UInt bins = size / 2 + 1;
+
+  if (callback) {
+    if (usePolar) {
+      Flt * re = real.getPtr();
+      Flt * im = imaginary.getPtr();
+      for (UInt k = 0; k < bins; k++) {
+        Flt magnitude = sqrtf(re[k] * re[k] + im[k] * im[k]);
+        im[k] = atan2f(im[k], re[k]);
+        re[k] = magnitude;
+      }
+      callback(real, imaginary);
+      for (UInt k = 0; k < bins; k++) {
+        Flt magnitude = re[k];
+        re[k] = magnitude * cosf(im[k]);
+        im[k] = magnitude * sinf(im[k]);
+      }
+    }
+    else {
+      callback(real, imaginary);
+    }
+  }
+
+  const Flt * out = inverse(real, imaginary).getConstPtr();
+  for (UInt n = 0; n < size; n++) outSum[n] += out[n] * synthesis[n];
+
+  // the first hop is complete, move everything by one hop
+  memcpy(outReady.data(), outSum.data(), hopSize * sizeof(Flt));
+  memmove(outSum.data(), outSum.data() + hopSize, (size - hopSize) * sizeof(Flt));
+  memset(outSum.data() + size - hopSize, 0, hopSize * sizeof(Flt));
+  memmove(inFifo.data(), inFifo.data() + hopSize, (size - hopSize) * sizeof(Flt));
+}
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    stft.hpp
+    Created: 16 Oct 2026 10:31:47pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef STFT_HPP_INCLUDED
+#define STFT_HPP_INCLUDED
+
+#include <functional>
+#include <vector>
+#include "fft.hpp"
+
+namespace YSE {
+  namespace DSP {
+
+    /*
+    Short time fourier analysis and resynthesis of a mono signal.
+    - The input is collected until a hop of new samples is available. The
+    last fftSize samples are then windowed and transformed, passed to the
+    frame callback, transformed back and added to the output.
+    - Any buffer length can be processed, independent of the hop size. The
+    output is delayed by latency() samples.
+    - The synthesis window is calculated so that the output equals the input
+    if the callback doesn't change anything, for every hop that divides
+    fftSize.
+    - Memory is only allocated in setup(). The fft tables are shared with all
+    other transforms of the same size.
+    */
+
+    class API stft {
+    public:
+      // Called for every frame with bins 0 to fftSize / 2. With polar output,
+      // real holds the magnitudes and imaginary the phases. Don't resize them.
+      typedef std::function<void(buffer & real, buffer & imaginary)> frameFunc;
+
+      stft(UInt fftSize = 1024, UInt hop = 256, WINDOW_TYPE window = WT_HANN);
+
+      // fftSize must be a power of two and hop must divide it.
+      // This allocates memory and resets the state.
+      stft & setup(UInt fftSize, UInt hop, WINDOW_TYPE window = WT_HANN);
+
+      stft & onFrame(frameFunc value) { callback = value; return *this; }
+
+      // pass magnitudes and phases to the callback instead of complex bins
+      stft & polar(Bool value) { usePolar = value; return *this; }
+      Bool   polar() { return usePolar; }
+
+      UInt fftSize() const { return size; }
+      UInt hop() const { return hopSize; }
+      UInt latency() const { return size; }
+
+      // forget all collected input and output
+      stft & clear();
+
+      // analyse and resynthesize a buffer in place
+      void process(buffer & in);
+
+    private:
+      void frame();
+
+      UInt size, hopSize;
+      Bool usePolar;
+      frameFunc callback;
+
+      std::vector<Flt> analysis, synthesis;
+
+      // input is collected from position size - hop up to size, output is
+      // read from the start of outReady at the same pace
+      std::vector<Flt> inFifo, outReady, outSum;
+      UInt position;
+
+      buffer windowed;
+      realFft forward;
+      inverseRealFft inverse;
+    };
+
+  }
+}
+
+#endif  // STFT_HPP_INCLUDED
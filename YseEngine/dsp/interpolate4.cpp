@@ -36,7 +36,7 @@ Int YSE::DSP::interpolate4::onset() {
 
 YSE::DSP::buffer & YSE::DSP::interpolate4::operator()(YSE::DSP::buffer & in) {
   Int n = in.getLength();
-  Flt * inData = in.getPtr();
+  const Flt * inData = in.getConstPtr();
   Flt * outData = out.getPtr();
   Flt * wp;
   Int onset = parmOnset.load();
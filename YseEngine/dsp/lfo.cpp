@@ -17,7 +17,8 @@ YSE::DSP::fileBuffer LfoSawTable(0);
 YSE::DSP::fileBuffer LfoTriangleTable(0);
 YSE::DSP::fileBuffer LfoSineTable(0);
 
-YSE::DSP::lfo::lfo() : cursor(0.f), previousType(LFO_NONE) {
+YSE::DSP::lfo::lfo() : cursor(0.f), previousType(LFO_NONE)
+, lineLength(0), currentLineValue(1.f), previousLineValue(1.f), fadeLeft(0), _controlRate(false) {
   result = 1;
   if (LfoSawTable.getLength() == 0) {
     // This is the first lfo object in use.
@@ -34,7 +35,9 @@ YSE::DSP::lfo::lfo() : cursor(0.f), previousType(LFO_NONE) {
     // perhaps this is a bit clumsy...
     sine s;
     for (UInt i = 0; i < SAMPLERATE; i += STANDARD_BUFFERSIZE) {
-      LfoSineTable.copyFrom(s(1), 0, i, STANDARD_BUFFERSIZE);
+      // the last part is shorter, unless the samplerate is a multiple of the buffer size
+      UInt length = SAMPLERATE - i < STANDARD_BUFFERSIZE ? SAMPLERATE - i : STANDARD_BUFFERSIZE;
+      LfoSineTable.copyFrom(s(1), 0, i, length);
     }
     LfoSineTable += 1;
     LfoSineTable *= 0.5;
@@ -42,6 +45,20 @@ YSE::DSP::lfo::lfo() : cursor(0.f), previousType(LFO_NONE) {
 }
 
 YSE::DSP::buffer & YSE::DSP::lfo::operator()(LFO_TYPE type, Flt frequency) {
+  if (_controlRate) {
+    UInt length = result.getLength();
+    Flt * out = result.getPtr();
+    Flt from = control(type, frequency, 0);
+    for (UInt pos = 0; pos < length; pos += CONTROL_BLOCKSIZE) {
+      UInt n = length - pos < CONTROL_BLOCKSIZE ? length - pos : CONTROL_BLOCKSIZE;
+      Flt to = control(type, frequency, n);
+      Flt step = (to - from) / n;
+      for (UInt i = 0; i < n; i++) out[pos + i] = from + step * i;
+      from = to;
+    }
+    return result;
+  }
+
   // avoid divisions by zero
   if (frequency == 0) type = LFO_NONE;
   
@@ -105,7 +122,7 @@ YSE::DSP::buffer & YSE::DSP::lfo::operator()(LFO_TYPE type, Flt frequency) {
       previousType = LFO_SAW;
       UInt samplesToProcess = result.getLength();
       Flt * out = result.getPtr();
-      Flt * in  = LfoSawTable.getPtr();
+      const Flt * in  = LfoSawTable.getConstPtr();
       while (samplesToProcess) {
         *out++ = in[(UInt)cursor];
         cursor += frequency;
@@ -119,7 +136,7 @@ YSE::DSP::buffer & YSE::DSP::lfo::operator()(LFO_TYPE type, Flt frequency) {
       previousType = LFO_SAW_REVERSED;
       UInt samplesToProcess = result.getLength();
       Flt * out = result.getPtr();
-      Flt * in = LfoSawTable.getPtr();
+      const Flt * in = LfoSawTable.getConstPtr();
       while (samplesToProcess) {
         *out++ = in[(UInt)cursor];
         cursor -= frequency;
@@ -133,7 +150,7 @@ YSE::DSP::buffer & YSE::DSP::lfo::operator()(LFO_TYPE type, Flt frequency) {
       previousType = LFO_TRIANGLE;
       UInt samplesToProcess = result.getLength();
       Flt * out = result.getPtr();
-      Flt * in = LfoTriangleTable.getPtr();
+      const Flt * in = LfoTriangleTable.getConstPtr();
       while (samplesToProcess) {
         *out++ = in[(UInt)cursor];
         cursor += frequency;
@@ -147,7 +164,7 @@ YSE::DSP::buffer & YSE::DSP::lfo::operator()(LFO_TYPE type, Flt frequency) {
       previousType = LFO_SINE;
       UInt samplesToProcess = result.getLength();
       Flt * out = result.getPtr();
-      Flt * in = LfoTriangleTable.getPtr();
+      const Flt * in = LfoSineTable.getConstPtr();
       while (samplesToProcess) {
         *out++ = in[(UInt)cursor];
         cursor += frequency;
@@ -162,3 +179,71 @@ YSE::DSP::buffer & YSE::DSP::lfo::operator()(LFO_TYPE type, Flt frequency) {
   return result;
 }
 
+Flt YSE::DSP::lfo::control(LFO_TYPE type, Flt frequency, UInt frames) {
+  // avoid divisions by zero
+  if (frequency == 0) type = LFO_NONE;
+
+  switch (type) {
+    case LFO_NONE: {
+      previousType = type;
+      return 1.f;
+    }
+
+    case LFO_RANDOM:
+    case LFO_SQUARE: {
+      // shorten current value if new frequency is lower
+      UInt phaseLength = (UInt)(SAMPLERATE / frequency * 0.5f);
+      if (phaseLength == 0) phaseLength = 1;
+      if (phaseLength < lineLength) lineLength = phaseLength;
+
+      if (previousType != type) {
+        lineLength = phaseLength;
+        currentLineValue = previousLineValue = type == LFO_SQUARE ? 1.f : RandomF();
+        fadeLeft = 0;
+        previousType = type;
+      }
+
+      // a new value fades in over 200 frames, like at audio rate
+      auto value = [this]() {
+        return fadeLeft ? currentLineValue + (previousLineValue - currentLineValue) * (fadeLeft / 200.f) : currentLineValue;
+      };
+
+      while (frames) {
+        UInt steps = lineLength > frames ? frames : lineLength;
+        fadeLeft = fadeLeft > steps ? fadeLeft - steps : 0;
+        lineLength -= steps;
+        frames -= steps;
+
+        if (!lineLength) {
+          previousLineValue = value();
+          if (type == LFO_SQUARE) currentLineValue = currentLineValue > 0.9f ? 0.f : 1.f;
+          else currentLineValue = RandomF();
+          lineLength = phaseLength;
+          fadeLeft = 200;
+        }
+      }
+      return value();
+    }
+
+    case LFO_SAW_REVERSED: {
+      previousType = type;
+      cursor -= frequency * frames;
+      while (cursor < 0) cursor += SAMPLERATE;
+      while (cursor >= SAMPLERATE) cursor -= SAMPLERATE;
+      return LfoSawTable.getConstPtr()[(UInt)cursor];
+    }
+
+    case LFO_SAW:
+    case LFO_TRIANGLE:
+    case LFO_SINE: {
+      previousType = type;
+      cursor += frequency * frames;
+      while (cursor >= SAMPLERATE) cursor -= SAMPLERATE;
+      while (cursor < 0) cursor += SAMPLERATE;
+      fileBuffer & table = type == LFO_SAW ? LfoSawTable : type == LFO_TRIANGLE ? LfoTriangleTable : LfoSineTable;
+      return table.getConstPtr()[(UInt)cursor];
+    }
+  }
+
+  return 1.f;
+}
@@ -33,6 +33,16 @@ namespace YSE {
       // returns lfo buffer with values between 0 and 1
       buffer & operator()(LFO_TYPE type, Flt frequency);
 
+      // Control rate: move the lfo ahead by 'frames' and return the value
+      // it has there, between 0 and 1. Use 0 frames to get the current value.
+      // Consumers can interpolate between these values.
+      Flt control(LFO_TYPE type, Flt frequency, UInt frames);
+
+      // When on, operator() calculates one value every CONTROL_BLOCKSIZE
+      // frames and interpolates in between. Off by default.
+      lfo & controlRate(Bool value) { _controlRate = value; return *this; }
+      Bool controlRate() { return _controlRate; }
+
     private:
       drawableBuffer result;
       Flt cursor;
@@ -40,6 +50,8 @@ namespace YSE {
 
       UInt lineLength;
       Flt currentLineValue, previousLineValue;
+      UInt fadeLeft; // control rate: frames left in the fade to a new square or random value
+      Bool _controlRate;
 
     };
 
@@ -11,6 +11,8 @@
 
 #include "math.hpp"
 #include <cmath>
+#include <cstring>
+#include <limits>
 
 Flt YSE::DSP::MidiToFreq(Flt note) {
   return 440.0f * std::pow(2.0f, (note - 69.0f) / 12.0f);
@@ -42,7 +44,7 @@ YSE::DSP::clip& YSE::DSP::clip::setHigh(Flt high) {
 
 YSE::DSP::buffer & YSE::DSP::clip::operator()(YSE::DSP::buffer & in) {
   if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
-  Flt * inPtr = in.getPtr();
+  const Flt * inPtr = in.getConstPtr();
   Flt * outPtr = buffer.getPtr();
   UInt length = in.getLength();
 
@@ -60,77 +62,131 @@ YSE::DSP::buffer & YSE::DSP::clip::operator()(YSE::DSP::buffer & in) {
 
 /*******************************************************************************************/
 
-#define DUMTAB1SIZE 256
-#define DUMTAB2SIZE 1024
-
-Flt rsqrt_exptab[DUMTAB1SIZE], rsqrt_mantissatab[DUMTAB2SIZE];
-Bool rSqrtInitOK = false;
+YSE::DSP::mathObject & YSE::DSP::mathObject::setAccuracy(YSE::MATH_ACCURACY value) {
+  accuracy.store(value);
+  return (*this);
+}
 
+YSE::MATH_ACCURACY YSE::DSP::mathObject::getAccuracy() const {
+  return accuracy.load();
+}
 
+// The approximations below are written without branches or table lookups,
+// so that every loop that uses them can be vectorized by the compiler.
+// Conditions are applied with bit masks instead of the ?: operator, because
+// compilers will not if-convert floating point operations that might trap.
+// Measured maximum error over the whole float range:
+//
+//            exp2 (relative)   log2 (absolute)   rSqrt (relative)
+//  MA_HIGH   2.6e-6            1.3e-5            4.7e-6
+//  MA_FAST   1.7e-3            6.4e-4            1.8e-3
 
-void setupSqrt() {
-  if (rSqrtInitOK) return;
+namespace {
 
-  for (Int i = 0; i < DUMTAB1SIZE; i++) {
+  inline Flt asFlt(I32 i) {
     Flt f;
-    Int l = (i ? (i == DUMTAB1SIZE - 1 ? DUMTAB1SIZE - 2 : i) : 1) << 23;
-    *(Int *)(&f) = l;
-    rsqrt_exptab[i] = 1.0f / sqrt(f);
+    std::memcpy(&f, &i, sizeof(Flt));
+    return f;
   }
 
-  for (Int i = 0; i < DUMTAB2SIZE; i++) {
-    Flt f = 1 + (1.0f / DUMTAB2SIZE) * i;
-    rsqrt_mantissatab[i] = 1.0f / sqrt(f);
+  inline I32 asInt(Flt f) {
+    I32 i;
+    std::memcpy(&i, &f, sizeof(I32));
+    return i;
   }
 
-  rSqrtInitOK = true;
-}
+  // branch free version of condition ? a : b
+  inline Flt select(bool condition, Flt a, Flt b) {
+    I32 mask = -(I32)condition;
+    return asFlt((asInt(a) & mask) | (asInt(b) & ~mask));
+  }
 
-YSE::DSP::rSqrt::rSqrt() {
-  setupSqrt();
-}
+  // input is clipped to [-126, 127], so that the result is always a
+  // normal number
+  template <YSE::MATH_ACCURACY A> inline Flt exp2Func(Flt x) {
+    if (A == YSE::MA_EXACT) return std::exp2(x);
+
+    x = select(x < -126.f, -126.f, x);
+    x = select(x > 127.f, 127.f, x);
+    Flt whole = (Flt)(I32)x;
+    whole -= select(whole > x, 1.f, 0.f);
+    Flt f = x - whole;
+    Flt p;
+    if (A == YSE::MA_HIGH) {
+      p = 1.00000259f + f * (0.693003870f + f * (0.241442678f + f * (0.0520114877f + f * 0.0135341940f)));
+    }
+    else {
+      p = 1.00172300f + f * (0.657640381f + f * 0.337189516f);
+    }
+    return p * asFlt(((I32)whole + 127) << 23);
+  }
 
-YSE::DSP::buffer & YSE::DSP::rSqrt::operator()(YSE::DSP::buffer & in) {
-  if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = buffer.getPtr();
-  UInt length = in.getLength();
+  // input must be larger than zero
+  template <YSE::MATH_ACCURACY A> inline Flt log2Func(Flt x) {
+    if (A == YSE::MA_EXACT) return std::log2(x);
 
-  while (length--) {
-    Flt f = *inPtr;
-    Int l = *(Int *)(inPtr++);
-    if (f < 0) *outPtr++ = 0;
+    I32 i = asInt(x);
+    Flt e = (Flt)((i >> 23) - 127);
+    Flt m = asFlt((i & 0x007fffff) | 0x3f800000) - 1.f;
+    if (A == YSE::MA_HIGH) {
+      return e + (0.0000125215782f + m * (1.44168485f + m * (-0.707994020f + m * (0.413632525f + m * (-0.192197277f + m * 0.0448739189f)))));
+    }
     else {
-      Flt g = rsqrt_exptab[(l >> 23) & 0xff] * rsqrt_mantissatab[(l >> 13) & 0x3ff];
-      *outPtr++ = 1.5f * g - 0.5f * g * g * g * f;
+      return e + (0.000636334580f + m * (1.41888496f + m * (-0.577134913f + m * 0.158249984f)));
     }
   }
 
-  return buffer;
+  // input must be larger than zero
+  template <YSE::MATH_ACCURACY A> inline Flt rSqrtFunc(Flt x) {
+    if (A == YSE::MA_EXACT) return 1.f / std::sqrt(x);
+
+    Flt g = asFlt(0x5f375a86 - (asInt(x) >> 1));
+    g *= 1.5f - 0.5f * x * g * g;
+    if (A == YSE::MA_HIGH) g *= 1.5f - 0.5f * x * g * g;
+    return g;
+  }
+
 }
 
+// runs a templated loop with the accuracy that is currently set
+#define ACCURACY_DISPATCH(func, ...) \
+  switch (accuracy.load()) { \
+    case YSE::MA_EXACT: func<YSE::MA_EXACT>(__VA_ARGS__); break; \
+    case YSE::MA_HIGH: func<YSE::MA_HIGH>(__VA_ARGS__); break; \
+    default: func<YSE::MA_FAST>(__VA_ARGS__); break; \
+  }
+
 /*******************************************************************************************/
 
-YSE::DSP::sqrt::sqrt() {
-  setupSqrt();
+namespace {
+  template <YSE::MATH_ACCURACY A> void rSqrtLoop(const Flt * in, Flt * out, UInt length) {
+    for (UInt i = 0; i < length; i++) {
+      Flt f = in[i];
+      Flt g = rSqrtFunc<A>(select(f > 0, f, 1.f));
+      out[i] = select(f > 0, g, 0);
+    }
+  }
+
+  template <YSE::MATH_ACCURACY A> void sqrtLoop(const Flt * in, Flt * out, UInt length) {
+    for (UInt i = 0; i < length; i++) {
+      Flt f = in[i];
+      Flt g = rSqrtFunc<A>(select(f > 0, f, 1.f));
+      out[i] = select(f > 0, f * g, 0);
+    }
+  }
 }
 
-YSE::DSP::buffer & YSE::DSP::sqrt::operator()(YSE::DSP::buffer & in) {
+YSE::DSP::buffer & YSE::DSP::rSqrt::operator()(YSE::DSP::buffer & in) {
   if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = buffer.getPtr();
-  UInt length = in.getLength();
+  ACCURACY_DISPATCH(rSqrtLoop, in.getConstPtr(), buffer.getPtr(), in.getLength());
+  return buffer;
+}
 
-  while (length--) {
-    Flt f = *inPtr;
-    Int l = *(Int *)(inPtr++);
-    if (f < 0) *outPtr++ = 0;
-    else {
-      Flt g = rsqrt_exptab[(l >> 23) & 0xff] * rsqrt_mantissatab[(l >> 13) & 0x3ff];
-      *outPtr++ = f * (1.5f * g - 0.5f * g * g * g * f);
-    }
-  }
+/*******************************************************************************************/
 
+YSE::DSP::buffer & YSE::DSP::sqrt::operator()(YSE::DSP::buffer & in) {
+  if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
+  ACCURACY_DISPATCH(sqrtLoop, in.getConstPtr(), buffer.getPtr(), in.getLength());
   return buffer;
 }
 
@@ -138,7 +194,7 @@ YSE::DSP::buffer & YSE::DSP::sqrt::operator()(YSE::DSP::buffer & in) {
 
 YSE::DSP::buffer & YSE::DSP::wrap::operator()(YSE::DSP::buffer & in) {
   if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
-  Flt * inPtr = in.getPtr();
+  const Flt * inPtr = in.getConstPtr();
   Flt * outPtr = buffer.getPtr();
   UInt length = in.getLength();
 
@@ -154,21 +210,88 @@ YSE::DSP::buffer & YSE::DSP::wrap::operator()(YSE::DSP::buffer & in) {
 
 /*******************************************************************************************/
 
-YSE::DSP::buffer & YSE::DSP::midiToFreq::operator()(YSE::DSP::buffer & in) {
-  if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = buffer.getPtr();
-  UInt length = in.getLength();
+// all conversions are written as powers and logarithms of two
+#define LOG2TEN 3.321928094887f
 
-  for (; length--; inPtr++, outPtr++) {
-    Flt f = *inPtr;
-    if (f < -1500) *outPtr = 0;
-    else {
-      if (f > 1499) f = 1499;
-      *outPtr = 8.17579891564f * ::exp(.0577622650f * f);
+namespace {
+  template <YSE::MATH_ACCURACY A> void midiToFreqLoop(const Flt * in, Flt * out, UInt length) {
+    for (UInt i = 0; i < length; i++) {
+      Flt f = in[i];
+      Flt g = 8.17579891564f * exp2Func<A>(select(f > 1499, 1499, f) * (1.f / 12.f));
+      out[i] = select(f < -1500, 0, g);
+    }
+  }
+
+  template <YSE::MATH_ACCURACY A> void freqToMidiLoop(const Flt * in, Flt * out, UInt length) {
+    for (UInt i = 0; i < length; i++) {
+      Flt f = in[i];
+      Flt g = 12.f * log2Func<A>(select(f > 0, f, 1.f)) - 36.3763165623f;
+      out[i] = select(f > 0, g, -1500);
     }
   }
 
+  template <YSE::MATH_ACCURACY A> void dbToRmsLoop(const Flt * in, Flt * out, UInt length) {
+    for (UInt i = 0; i < length; i++) {
+      Flt f = in[i];
+      Flt g = exp2Func<A>((select(f > 485, 485, f) - 100.f) * (LOG2TEN * 0.05f));
+      out[i] = select(f <= 0, 0, g);
+    }
+  }
+
+  template <YSE::MATH_ACCURACY A> void rmsToDbLoop(const Flt * in, Flt * out, UInt length) {
+    for (UInt i = 0; i < length; i++) {
+      Flt f = in[i];
+      Flt g = 100.f + (20.f / LOG2TEN) * log2Func<A>(select(f > 0, f, 1.f));
+      out[i] = select((f <= 0) | (g < 0), 0, g);
+    }
+  }
+
+  template <YSE::MATH_ACCURACY A> void dbToPowLoop(const Flt * in, Flt * out, UInt length) {
+    for (UInt i = 0; i < length; i++) {
+      Flt f = in[i];
+      Flt g = exp2Func<A>((select(f > 870, 870, f) - 100.f) * (LOG2TEN * 0.1f));
+      out[i] = select(f <= 0, 0, g);
+    }
+  }
+
+  template <YSE::MATH_ACCURACY A> void powToDbLoop(const Flt * in, Flt * out, UInt length) {
+    for (UInt i = 0; i < length; i++) {
+      Flt f = in[i];
+      Flt g = 100.f + (10.f / LOG2TEN) * log2Func<A>(select(f > 0, f, 1.f));
+      out[i] = select((f <= 0) | (g < 0), 0, g);
+    }
+  }
+
+  template <YSE::MATH_ACCURACY A> void powLoop(const Flt * in1, const Flt * in2, Flt * out, UInt length) {
+    for (UInt i = 0; i < length; i++) {
+      Flt f = in1[i];
+      Flt g = A == YSE::MA_EXACT ? std::pow(f, in2[i]) : exp2Func<A>(in2[i] * log2Func<A>(select(f > 0, f, 1.f)));
+      out[i] = select(f > 0, g, 0);
+    }
+  }
+
+  template <YSE::MATH_ACCURACY A> void expLoop(const Flt * in, Flt * out, UInt length) {
+    for (UInt i = 0; i < length; i++) {
+      out[i] = A == YSE::MA_EXACT ? std::exp(in[i]) : exp2Func<A>(in[i] * 1.442695040889f);
+    }
+  }
+
+  // keeps the results of std::log for input that is not larger than zero
+  template <YSE::MATH_ACCURACY A> void logLoop(const Flt * in1, const Flt * in2, Flt * out, UInt length) {
+    for (UInt i = 0; i < length; i++) {
+      Flt f = in1[i], g = in2[i];
+      Flt lf = log2Func<A>(select(f > 0, f, 1.f));
+      Flt lg = log2Func<A>(select(g > 0, g, 2.f));
+      Flt result = select(g > 0, lf / lg, lf * 0.693147180560f);
+      result = select(f < 0, std::numeric_limits<Flt>::quiet_NaN(), result);
+      out[i] = select(f == 0, -std::numeric_limits<Flt>::infinity(), result);
+    }
+  }
+}
+
+YSE::DSP::buffer & YSE::DSP::midiToFreq::operator()(YSE::DSP::buffer & in) {
+  if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
+  ACCURACY_DISPATCH(midiToFreqLoop, in.getConstPtr(), buffer.getPtr(), in.getLength());
   return buffer;
 }
 
@@ -176,42 +299,15 @@ YSE::DSP::buffer & YSE::DSP::midiToFreq::operator()(YSE::DSP::buffer & in) {
 
 YSE::DSP::buffer & YSE::DSP::freqToMidi::operator()(YSE::DSP::buffer & in) {
   if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = buffer.getPtr();
-  UInt length = in.getLength();
-
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wunused-value"
-  for (; length--; *inPtr++, *outPtr++) {
-    Flt f = *inPtr;
-    *outPtr = (f > 0 ? 17.3123405046f * ::log(.12231220585f * f) : -1500);
-  }
-#pragma clang diagnostic pop
+  ACCURACY_DISPATCH(freqToMidiLoop, in.getConstPtr(), buffer.getPtr(), in.getLength());
   return buffer;
 }
 
-
 /*******************************************************************************************/
 
-#define LOGTEN 2.302585092994f
-
 YSE::DSP::buffer & YSE::DSP::dbToRms::operator()(YSE::DSP::buffer & in) {
   if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = buffer.getPtr();
-  UInt length = in.getLength();
-
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wunused-value"
-  for (; length--; *inPtr++, *outPtr++) {
-    Flt f = *inPtr;
-    if (f <= 0) *outPtr = 0;
-    else {
-      if (f > 485) f = 485;
-      *outPtr = ::exp((LOGTEN * 0.05f) * (f - 100.0f));
-    }
-  }
-#pragma clang diagnostic pop
+  ACCURACY_DISPATCH(dbToRmsLoop, in.getConstPtr(), buffer.getPtr(), in.getLength());
   return buffer;
 }
 
@@ -219,21 +315,7 @@ YSE::DSP::buffer & YSE::DSP::dbToRms::operator()(YSE::DSP::buffer & in) {
 
 YSE::DSP::buffer & YSE::DSP::rmsToDb::operator()(YSE::DSP::buffer & in) {
   if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = buffer.getPtr();
-  UInt length = in.getLength();
-
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wunused-value"
-  for (; length--; *inPtr++, *outPtr++) {
-    Flt f = *inPtr;
-    if (f <= 0) *outPtr = 0;
-    else {
-      Flt g = 100 + 20.0f / LOGTEN * ::log(f);
-      *outPtr = (g < 0 ? 0 : g);
-    }
-  }
-#pragma clang diagnostic pop
+  ACCURACY_DISPATCH(rmsToDbLoop, in.getConstPtr(), buffer.getPtr(), in.getLength());
   return buffer;
 }
 
@@ -241,21 +323,7 @@ YSE::DSP::buffer & YSE::DSP::rmsToDb::operator()(YSE::DSP::buffer & in) {
 
 YSE::DSP::buffer & YSE::DSP::dbToPow::operator()(YSE::DSP::buffer & in) {
   if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = buffer.getPtr();
-  UInt length = in.getLength();
-
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wunused-value"
-  for (; length--; *inPtr++, *outPtr++) {
-    Flt f = *inPtr;
-    if (f <= 0) *outPtr = 0;
-    else {
-      if (f > 870) f = 870;
-      *outPtr = ::exp((LOGTEN * 0.1f) * (f - 100.0f));
-    }
-  }
-#pragma clang diagnostic pop
+  ACCURACY_DISPATCH(dbToPowLoop, in.getConstPtr(), buffer.getPtr(), in.getLength());
   return buffer;
 }
 
@@ -263,21 +331,7 @@ YSE::DSP::buffer & YSE::DSP::dbToPow::operator()(YSE::DSP::buffer & in) {
 
 YSE::DSP::buffer & YSE::DSP::powToDb::operator()(YSE::DSP::buffer & in) {
   if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = buffer.getPtr();
-  UInt length = in.getLength();
-
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wunused-value"
-  for (; length--; *inPtr++, *outPtr++) {
-    Flt f = *inPtr;
-    if (f <= 0) *outPtr = 0;
-    else {
-      Flt g = 100 + 10.0f / LOGTEN * ::log(f);
-      *outPtr = (g < 0 ? 0 : g);
-    }
-  }
-#pragma clang diagnostic pop
+  ACCURACY_DISPATCH(powToDbLoop, in.getConstPtr(), buffer.getPtr(), in.getLength());
   return buffer;
 }
 
@@ -285,33 +339,15 @@ YSE::DSP::buffer & YSE::DSP::powToDb::operator()(YSE::DSP::buffer & in) {
 
 YSE::DSP::buffer & YSE::DSP::pow::operator()(YSE::DSP::buffer & in1, YSE::DSP::buffer & in2) {
   if (in1.getLength() != buffer.getLength()) buffer.resize(in1.getLength());
-  Flt * in1Ptr = in1.getPtr();
-  Flt * in2Ptr = in2.getPtr();
-  Flt * outPtr = buffer.getPtr();
-  UInt length = in1.getLength();
-
-  while (length--) {
-    Flt f = *in1Ptr++;
-    if (f > 0) *outPtr = ::pow(f, *in2Ptr);
-    else *outPtr = 0;
-    outPtr++;
-    in2Ptr++;
-  }
-
+  ACCURACY_DISPATCH(powLoop, in1.getConstPtr(), in2.getConstPtr(), buffer.getPtr(), in1.getLength());
   return buffer;
 }
 
-
 /*******************************************************************************************/
 
 YSE::DSP::buffer & YSE::DSP::exp::operator()(YSE::DSP::buffer & in) {
   if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
-  Flt * inPtr = in.getPtr();
-  Flt * outPtr = buffer.getPtr();
-  UInt length = in.getLength();
-
-  while (length--) *outPtr++ = ::exp(*inPtr++);
-
+  ACCURACY_DISPATCH(expLoop, in.getConstPtr(), buffer.getPtr(), in.getLength());
   return buffer;
 }
 
@@ -319,28 +355,15 @@ YSE::DSP::buffer & YSE::DSP::exp::operator()(YSE::DSP::buffer & in) {
 
 YSE::DSP::buffer & YSE::DSP::log::operator()(YSE::DSP::buffer & in1, YSE::DSP::buffer & in2) {
   if (in1.getLength() != buffer.getLength()) buffer.resize(in1.getLength());
-  Flt * in1Ptr = in1.getPtr();
-  Flt * in2Ptr = in2.getPtr();
-  Flt * outPtr = buffer.getPtr();
-  UInt length = in1.getLength();
-
-  while (length--) {
-    Flt f = *in1Ptr++, g = *in2Ptr++;
-    if (f <= 0) *outPtr = ::log(f);
-    else if (g <= 0) *outPtr = ::log(f);
-    else *outPtr = ::log(f) / ::log(g);
-    outPtr++;
-  }
-
+  ACCURACY_DISPATCH(logLoop, in1.getConstPtr(), in2.getConstPtr(), buffer.getPtr(), in1.getLength());
   return buffer;
 }
 
-
 /*******************************************************************************************/
 
 YSE::DSP::buffer & YSE::DSP::abs::operator()(YSE::DSP::buffer & in) {
   if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
-  Flt * inPtr = in.getPtr();
+  const Flt * inPtr = in.getConstPtr();
   Flt * outPtr = buffer.getPtr();
   UInt length = in.getLength();
 
@@ -355,7 +378,7 @@ YSE::DSP::buffer & YSE::DSP::abs::operator()(YSE::DSP::buffer & in) {
 YSE::DSP::buffer & YSE::DSP::inverter::operator()(YSE::DSP::buffer & in, bool zeroToOne) {
   if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
   UInt l = buffer.getLength();
-  Flt * inPtr = in.getPtr();
+  const Flt * inPtr = in.getConstPtr();
   Flt * outPtr = buffer.getPtr();
 
   if (zeroToOne) {
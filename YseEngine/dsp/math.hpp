@@ -12,6 +12,7 @@
 #define MATH_H_INCLUDED
 
 #include "../headers/types.hpp"
+#include "../headers/enums.hpp"
 #include "buffer.hpp"
 
 namespace YSE {
@@ -38,24 +39,42 @@ namespace YSE {
       YSE::DSP::buffer buffer;
     };
 
-    // reciprocal square root good to 8 mantissa bits
+    // base for the math objects below that can trade accuracy for speed.
+    // MA_EXACT calls the standard library for every sample. MA_HIGH and
+    // MA_FAST use polynomials that the compiler can vectorize. MA_EXACT
+    // is the default, so that results stay the same as before.
+    class API mathObject {
+    public:
+      // use from anywhere
+      mathObject & setAccuracy(MATH_ACCURACY value);
+      MATH_ACCURACY getAccuracy() const;
+
+      // the atomic is not copyable, so the accuracy is copied by value
+      mathObject(const mathObject & other) : accuracy(other.accuracy.load()), buffer(other.buffer) {}
+      mathObject & operator=(const mathObject & other) {
+        accuracy.store(other.accuracy.load());
+        buffer = other.buffer;
+        return *this;
+      }
+
+    protected:
+      mathObject() : accuracy(MA_EXACT) {}
+      std::atomic<MATH_ACCURACY> accuracy;
+      YSE::DSP::buffer buffer;
+    };
+
+    // reciprocal square root, negative input yields zero
     // use in DSP only
-    class API rSqrt {
+    class API rSqrt : public mathObject {
     public:
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in);
-      rSqrt();
-    private:
-      YSE::DSP::buffer buffer;
     };
 
-    // square root good to 8 mantissa bits
+    // square root, negative input yields zero
     // use in DSP only
-    class API sqrt {
+    class API sqrt : public mathObject {
     public:
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in);
-      sqrt();
-    private:
-      YSE::DSP::buffer buffer;
     };
 
     // calculates difference between signal and first exceeding integer
@@ -68,75 +87,57 @@ namespace YSE {
     };
 
     // use in DSP only
-    class API midiToFreq {
+    class API midiToFreq : public mathObject {
     public:
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in);
-    private:
-      YSE::DSP::buffer buffer;
     };
 
     // use in DSP only
-    class API freqToMidi {
+    class API freqToMidi : public mathObject {
     public:
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in);
-    private:
-      YSE::DSP::buffer buffer;
     };
 
     // use in DSP only
-    class API dbToRms {
+    class API dbToRms : public mathObject {
     public:
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in);
-    private:
-      YSE::DSP::buffer buffer;
     };
 
     // use in DSP only
-    class API rmsToDb {
+    class API rmsToDb : public mathObject {
     public:
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in);
-    private:
-      YSE::DSP::buffer buffer;
     };
 
     // use in DSP only
-    class API dbToPow {
+    class API dbToPow : public mathObject {
     public:
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in);
-    private:
-      YSE::DSP::buffer buffer;
     };
 
     // use in DSP only
-    class API powToDb {
+    class API powToDb : public mathObject {
     public:
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in);
-    private:
-      YSE::DSP::buffer buffer;
     };
 
     // use in DSP only
-    class API pow {
+    class API pow : public mathObject {
     public:
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in1, YSE::DSP::buffer & in2);
-    private:
-      YSE::DSP::buffer buffer;
     };
 
     // use in DSP only
-    class API exp {
+    class API exp : public mathObject {
     public:
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in);
-    private:
-      YSE::DSP::buffer buffer;
     };
 
     // use in DSP only
-    class API log {
+    class API log : public mathObject {
     public:
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in1, YSE::DSP::buffer & in2);
-    private:
-      YSE::DSP::buffer buffer;
     };
 
     // use in DSP only
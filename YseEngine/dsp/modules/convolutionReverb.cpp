@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    convolutionReverb.cpp
+    Created: 16 Oct 2026 8:12:40pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include "convolutionReverb.hpp"
+#include "../../internalHeaders.h"
+
+YSE::DSP::MODULES::convolutionReverb::convolutionReverb() : parmWet(1.f), parmDry(0.f), requested(nullptr) {
+  autoSleep(true);
+}
+
+void YSE::DSP::MODULES::convolutionReverb::create() {
+  engine.reset(new INTERNAL::convolver);
+}
+
+YSE::DSP::MODULES::convolutionReverb & YSE::DSP::MODULES::convolutionReverb::load(const std::string & fileName) {
+  requested.store(INTERNAL::ImpulseResponses().get(fileName));
+  return *this;
+}
+
+YSE::DSP::MODULES::convolutionReverb & YSE::DSP::MODULES::convolutionReverb::wet(Flt value) {
+  if (value < 0) value = 0;
+  parmWet.store(value);
+  return *this;
+}
+
+Flt YSE::DSP::MODULES::convolutionReverb::wet() {
+  return parmWet;
+}
+
+YSE::DSP::MODULES::convolutionReverb & YSE::DSP::MODULES::convolutionReverb::dry(Flt value) {
+  if (value < 0) value = 0;
+  parmDry.store(value);
+  return *this;
+}
+
+Flt YSE::DSP::MODULES::convolutionReverb::dry() {
+  return parmDry;
+}
+
+UInt YSE::DSP::MODULES::convolutionReverb::tailGap() {
+  return engine ? engine->tail() : 0;
+}
+
+void YSE::DSP::MODULES::convolutionReverb::clearTail() {
+  if (engine) engine->clear();
+}
+
+void YSE::DSP::MODULES::convolutionReverb::process(MULTICHANNELBUFFER & buffer) {
+  createIfNeeded();
+  if (buffer.empty() || buffer[0].getLength() != INTERNAL::CONVOLUTION_HEAD_SIZE) return;
+
+  // switch once the new response is ready
+  INTERNAL::impulseResponse * response = requested.load();
+  if (response != nullptr && response->getState() == INTERNAL::READY) {
+    if (response != engine->current() || buffer.size() != engine->channels()) {
+      engine->prepare(response, buffer.size());
+    }
+  }
+  if (engine->current() == nullptr) return;
+
+  engine->process(buffer, parmWet, parmDry);
+}
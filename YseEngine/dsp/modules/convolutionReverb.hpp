@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    convolutionReverb.hpp
+    Created: 16 Oct 2026 8:12:40pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef CONVOLUTIONREVERB_HPP_INCLUDED
+#define CONVOLUTIONREVERB_HPP_INCLUDED
+
+#include "../dspObject.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace YSE {
+  namespace INTERNAL {
+    class impulseResponse;
+    class convolver;
+  }
+
+  namespace DSP {
+    namespace MODULES {
+
+      /**
+        Convolution with a measured impulse response. The start of the response
+        is convolved without latency in the audio thread, while the rest is done
+        in larger blocks on a worker thread.
+
+        Every output channel uses the same channel of the response, or the first
+        one if the response has less channels.
+      */
+      class API convolutionReverb : public dspObject {
+      public:
+        convolutionReverb();
+        virtual ~convolutionReverb() {};
+
+        /** Load an impulse response from an audio file. The file is loaded in the
+            background and the previous response is used until it is ready.
+            Responses are kept in memory, so loading a file again is instant.
+        */
+        convolutionReverb & load(const std::string & fileName);
+
+        // level of the convolved signal, default is 1
+        convolutionReverb & wet(Flt value);
+        Flt                 wet();
+
+        // level of the original signal, default is 0
+        convolutionReverb & dry(Flt value);
+        Flt                 dry();
+
+        virtual void create();
+        virtual void process(MULTICHANNELBUFFER & buffer);
+
+      protected:
+        // the response can start with silence, and the tail is calculated in blocks
+        virtual UInt tailGap();
+        virtual void clearTail();
+
+      private:
+        aFlt parmWet;
+        aFlt parmDry;
+
+        std::atomic<INTERNAL::impulseResponse*> requested;
+        std::shared_ptr<INTERNAL::convolver> engine;
+      };
+
+    }
+  }
+}
+
+
+
+#endif  // CONVOLUTIONREVERB_HPP_INCLUDED
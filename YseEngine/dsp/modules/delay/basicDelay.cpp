@@ -10,7 +10,9 @@
 
 #include "basicDelay.hpp"
 
-YSE::DSP::MODULES::basicDelay::basicDelay() : time0(0.f), time1(0.f), time2(0.f), gain0(0.f), gain1(0.f), gain2(0.f) {}
+YSE::DSP::MODULES::basicDelay::basicDelay() : time0(0.f), time1(0.f), time2(0.f), gain0(0.f), gain1(0.f), gain2(0.f) {
+  autoSleep(true);
+}
 
 YSE::DSP::MODULES::basicDelay & YSE::DSP::MODULES::basicDelay::set(basicDelay::DELAY_NR nr, Flt time, Flt gain) {
   switch (nr) {
@@ -47,6 +49,14 @@ void YSE::DSP::MODULES::basicDelay::create() {
   createPreFilter();
 }
 
+UInt YSE::DSP::MODULES::basicDelay::tailGap() {
+  Flt result = 0;
+  if (gain0 > 0 && time0 > result) result = time0;
+  if (gain1 > 0 && time1 > result) result = time1;
+  if (gain2 > 0 && time2 > result) result = time2;
+  return static_cast<UInt>(result * SAMPLERATE * 0.001f);
+}
+
 void YSE::DSP::MODULES::basicDelay::createPreFilter() {}
 void YSE::DSP::MODULES::basicDelay::applyPreFilter(DSP::buffer & buffer) {}
 
@@ -64,26 +74,16 @@ void YSE::DSP::MODULES::basicDelay::process(MULTICHANNELBUFFER & buffer) {
   delayBuffer->process(buffer[0]);
   Int delayCount = 1; // the original signal
 
-  // add delays to signal
-  if (gain0 > 0) {
-    delayBuffer->read(*reader, (UInt)time0);
-    (*reader) *= gain0;
-    (*result) += (*reader);
-    delayCount++;
-  }
-
-  if (gain1 > 0) {
-    delayBuffer->read(*reader, (UInt)time1);
-    (*reader) *= gain1;
-    (*result) += (*reader);
-    delayCount++;
+  // add delays to signal, all read in one pass
+  Flt times[3] = { time0, time1, time2 };
+  Flt gains[3] = { gain0, gain1, gain2 };
+  for (Int i = 0; i < 3; i++) {
+    if (gains[i] > 0) delayCount++;
+    else gains[i] = 0;
   }
-
-  if (gain2 > 0) {
-    delayBuffer->read(*reader, (UInt)time2);
-    (*reader) *= gain2;
+  if (delayCount > 1) {
+    delayBuffer->readTaps(*reader, 3, times, times, gains);
     (*result) += (*reader);
-    delayCount++;
   }
 
   // adjust total gain
@@ -48,6 +48,9 @@ namespace YSE {
         virtual void createPreFilter();
         virtual void applyPreFilter(DSP::buffer & buffer);
 
+        // the output is silent until the longest delay has passed (in samples)
+        virtual UInt tailGap();
+
         aFlt time0, time1, time2;
         aFlt gain0, gain1, gain2;
 
@@ -10,7 +10,10 @@
 
 #include "bandpass.hpp"
 
-YSE::DSP::MODULES::bandPassFilter::bandPassFilter() : parmFrequency(400.f), parmQ(1.f) {}
+YSE::DSP::MODULES::bandPassFilter::bandPassFilter() : parmFrequency(400.f), parmQ(1.f) {
+  // the filter has no tail to wait for
+  autoSleep(true);
+}
 
 YSE::DSP::MODULES::bandPassFilter & YSE::DSP::MODULES::bandPassFilter::frequency(Flt value) {
   parmFrequency.store(value);
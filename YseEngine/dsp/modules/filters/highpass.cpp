@@ -11,7 +11,10 @@
 #include "highpass.hpp"
 
 
-YSE::DSP::MODULES::highPassFilter::highPassFilter() : parmFrequency(400.f) {}
+YSE::DSP::MODULES::highPassFilter::highPassFilter() : parmFrequency(400.f) {
+  // the filter has no tail to wait for
+  autoSleep(true);
+}
 
 YSE::DSP::MODULES::highPassFilter & YSE::DSP::MODULES::highPassFilter::frequency(Flt value) {
   parmFrequency.store(value);
@@ -10,7 +10,10 @@
 
 #include "lowpass.hpp"
 
-YSE::DSP::MODULES::lowPassFilter::lowPassFilter() : parmFrequency(1000.f) {}
+YSE::DSP::MODULES::lowPassFilter::lowPassFilter() : parmFrequency(1000.f) {
+  // the filter has no tail to wait for
+  autoSleep(true);
+}
 
 YSE::DSP::MODULES::lowPassFilter & YSE::DSP::MODULES::lowPassFilter::frequency(Flt value) {
   parmFrequency.store(value);
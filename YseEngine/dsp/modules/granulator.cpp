@@ -9,197 +9,337 @@
 */
 
 #include "granulator.hpp"
-#include "../../utils/misc.hpp"
-#include "../math_functions.h"
-#include <iostream>
-
-namespace YSE {
-  namespace DSP {
-    namespace MODULES {
-      enum GRAIN_STATE {
-        GS_START,
-        GS_FADE_IN,
-        GS_FADE_OUT,
-        GS_SUSTAIN,
-        GS_STOPPED,
-      };
-
-      class grain {
-      public:
-        grain(bool value) : needsInfo(value), state(GS_STOPPED) {}
-
-        void start(UInt grainLength, UInt waitTime, Flt pitch, DSP::buffer * pool) {
-          state = GS_START;
-          this->grainLength = grainLength;
-          this->waitTime = waitTime;
-          this->pool = pool;
-          this->pitch = pitch;
-
-          // determine start position
-          int offset = pool->cursor - pool->getPtr();
-          int min = offset + this->waitTime;
-          int max = offset + this->waitTime + pool->getLength() - grainLength;
-          poolPos = min + BigRandom(max - min);
-          while (poolPos > pool->getLength()) poolPos -= pool->getLength();
-
-          this->currentGain = 0;
-        }
-
-        void process(DSP::buffer * pool, DSP::buffer * output) {
-          if (state == GS_STOPPED) return;
-          Flt * poolPtr = pool->getPtr();
-
-          Flt * outPtr = output->getPtr();
-          UInt n = output->getLength();
-
-          if (state == GS_START) {
-            while (n-- && --waitTime) outPtr++;
-            if (waitTime <= 0) {
-              state = GS_FADE_IN;
-              n++;
-            }
-            else return;
-          }
-
-          if (state == GS_FADE_IN) {
-            while (n-- && currentGain < 1 && (grainLength - 100) > 0) {
-              *outPtr++ += poolPtr[(UInt)poolPos] * currentGain;
-              currentGain += 0.005;
-              poolPos += pitch;
-              if (poolPos >= pool->getLength()) poolPos -= pool->getLength();
-              grainLength--;
-            }
-            if (currentGain >= 1) {
-              if (grainLength - 100 > 0) state = GS_SUSTAIN;
-              else state = GS_FADE_OUT;
-              n++;
-            }
-          }
-
-          if (state == GS_SUSTAIN) {
-            while (n-- && (grainLength - 100) > 0) {
-              *outPtr++ += poolPtr[(UInt)poolPos];
-              poolPos += pitch;
-              if (poolPos >= pool->getLength()) poolPos -= pool->getLength();
-              grainLength--;
-            }
-            if (grainLength  <= 100) {
-              state = GS_FADE_OUT;
-              n++;
-            }
-          }
-
-          if (state == GS_FADE_OUT) {
-            while (n-- && currentGain > 0) {
-              *outPtr++ += poolPtr[(UInt)poolPos] * currentGain;
-              currentGain -= 0.01;
-              poolPos += pitch;
-              if (poolPos >= pool->getLength()) poolPos -= pool->getLength();
-              grainLength--;
-            }
-            if (currentGain <= 0) {
-              state = GS_STOPPED;
-            }
-          }
-         
-        }
-
-        bool needsInfo;
-        UInt grainLength;
-        Int waitTime;
-        Flt pitch;
-        DSP::buffer * pool;
-        Flt poolPos;
-        Flt currentGain;
-        GRAIN_STATE state;
-      };
+#include "../../internalHeaders.h"
+#include <cmath>
+
+// number of points in the window tables. Grains interpolate between them.
+#define GRAIN_WINDOW_SIZE 1024
+// the most grains that can start within one buffer
+#define GRAIN_MAX_STARTS 256
+
+namespace {
+
+  /* One table for every GRAIN_WINDOW. The tables have two extra points, so
+     that interpolation near the end of a grain never reads past the table.
+  */
+  class windowTables {
+  public:
+    windowTables() {
+      const Flt fade = 0.5f; // tukey: the part of the grain used to fade in and out
+      const Flt width = 0.2f; // gaussian: standard deviation, relative to the grain length
+      const Flt edge = expf(-0.5f * (0.5f / width) * (0.5f / width));
+
+      for (UInt i = 0; i <= GRAIN_WINDOW_SIZE; i++) {
+        Flt x = i / static_cast<Flt>(GRAIN_WINDOW_SIZE);
+        table[YSE::GW_HANN][i] = 0.5f - 0.5f * cosf(YSE::Pi2 * x);
+
+        Flt t = x < 0.5f ? x : 1.f - x; // distance to the nearest edge
+        table[YSE::GW_TUKEY][i] = t < fade * 0.5f ? 0.5f - 0.5f * cosf(YSE::Pi2 * t / fade) : 1.f;
+
+        // shifted down so that it starts and ends at zero
+        Flt g = (x - 0.5f) / width;
+        table[YSE::GW_GAUSSIAN][i] = (expf(-0.5f * g * g) - edge) / (1.f - edge);
+      }
+
+      for (UInt w = 0; w < 3; w++) table[w][GRAIN_WINDOW_SIZE + 1] = 0.f;
+    }
+
+    const Flt * get(YSE::GRAIN_WINDOW type) const { return table[type]; }
+
+  private:
+    Flt table[3][GRAIN_WINDOW_SIZE + 2];
+  };
+
+  const windowTables & Windows() {
+    static windowTables w;
+    return w;
+  }
+
+  // Every granulator gets its own seed, so that granulators with the same
+  // settings don't play the same grains.
+  UInt newSeed() {
+    static std::atomic<UInt> instances(0);
+    UInt seed = (++instances * 0x9e3779b9u) ^ static_cast<UInt>(rand());
+    return seed ? seed : 1;
+  }
+
+  // xorshift
+  inline UInt nextRandom(UInt & state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+
+  inline Flt randomF(UInt & state, Flt min, Flt max) {
+    return min + (nextRandom(state) >> 8) * (1.f / 16777216.f) * (max - min);
+  }
+
+  /* Read 'length' frames of a grain and apply the window. The source is
+     interpolated between two samples, so 'in' must have one sample after the
+     last position that is read. The read position should not wrap around the
+     pool within these frames. Without branches or state carried between
+     frames, the compiler can vectorize this loop.
+  */
+  inline void readGrain(Flt * out, const Flt * in, const Flt * window, Flt pos, Flt speed, Flt phase, Flt inc, UInt length) {
+    for (UInt i = 0; i < length; i++) {
+      Flt p = pos + speed * i;
+      Flt w = phase + inc * i;
+      UInt wi = static_cast<UInt>(w);
+      Flt f = w - static_cast<Flt>(wi);
+      UInt pi = static_cast<UInt>(p);
+      Flt pf = p - static_cast<Flt>(pi);
+      Flt s = in[pi] + (in[pi + 1] - in[pi]) * pf;
+      out[i] = s * (window[wi] + (window[wi + 1] - window[wi]) * f);
     }
   }
 }
 
+/* The grains of a granulator. The state of every grain is kept in arrays,
+   and the grains which are playing are always at the front.
+*/
+class YSE::DSP::MODULES::granulator::grainSet {
+public:
+  grainSet(granulator * parent, UInt size, UInt seed)
+    : parent(parent), size(size), count(0), starts(0), random(seed), table(nullptr)
+    , position(size), speed(size), phase(size), phaseInc(size)
+    , framesLeft(size), delay(size), source(size), left(size), right(size)
+    , gainLeft(size), gainRight(size) {}
+
+  // start a grain at this frame in the next buffer
+  void schedule(UInt onset) {
+    if (starts < GRAIN_MAX_STARTS) onsets[starts++] = onset;
+  }
+
+  // stop all grains
+  void reset() {
+    count = 0;
+    starts = 0;
+  }
+
+  UInt playing() const { return count; }
+
+  // start the scheduled grains and add all grains to out
+  void run(MULTICHANNELBUFFER & out) {
+    table = Windows().get(parent->parmWindow);
+    for (UInt i = 0; i < starts; i++) start(onsets[i]);
+    starts = 0;
+
+    UInt i = 0;
+    while (i < count) {
+      if (render(i, out)) i++;
+      else remove(i);
+    }
+  }
+
+private:
+  void start(UInt onset) {
+    // all grains are playing
+    if (count == size) return;
+
+    UInt channels = static_cast<UInt>(parent->pool->size());
+    UInt poolLength = parent->poolSize;
+
+    Int length = parent->parmLength;
+    Int lengthRandom = parent->parmLengthRandom;
+    if (lengthRandom) length += static_cast<Int>(nextRandom(random) % (2 * lengthRandom + 1)) - lengthRandom;
+    Clamp(length, 16, static_cast<Int>(poolLength / 2));
+
+    Flt pitch = 1 + parent->parmTranspose;
+    Flt pitchRandom = parent->parmTransposeRandom;
+    if (pitchRandom > 0) pitch += randomF(random, -pitchRandom, pitchRandom);
+    if (pitch < 0.01f) pitch = 0.01f;
+
+    // Start far enough behind the write position, so that a fast grain never
+    // catches up with it, and a slow grain never reads what is overwritten.
+    // Interpolation reads one sample ahead.
+    Flt faster = pitch > 1.f ? (pitch - 1.f) * length : 0.f;
+    Flt slower = pitch < 1.f ? (1.f - pitch) * length : 0.f;
+    Flt minDistance = faster + 2.f;
+    Flt maxDistance = poolLength - slower - STANDARD_BUFFERSIZE;
+    Flt distance = maxDistance > minDistance ? randomF(random, minDistance, maxDistance) : minDistance;
+    Flt pos = static_cast<Flt>(parent->poolPosition) - distance;
+    while (pos < 0) pos += poolLength;
+    if (pos >= poolLength) pos -= poolLength; // rounding
+
+    // place the grain between two output channels
+    UInt from = channels > 1 ? nextRandom(random) % channels : 0;
+    Flt place = static_cast<Flt>(from);
+    Flt pan = parent->parmPan;
+    if (pan > 0 && channels > 1) place += randomF(random, -pan, pan) * channels * 0.5f;
+    while (place < 0) place += channels;
+    while (place >= channels) place -= channels;
+    UInt l = static_cast<UInt>(place);
+    if (l >= channels) l = 0;
+    Flt f = place - l;
+
+    UInt i = count++;
+    position[i] = pos;
+    speed[i] = pitch;
+    phase[i] = 0.f;
+    phaseInc[i] = GRAIN_WINDOW_SIZE / static_cast<Flt>(length);
+    framesLeft[i] = static_cast<UInt>(length);
+    delay[i] = onset;
+    source[i] = from;
+    left[i] = l;
+    right[i] = (l + 1) % channels;
+    gainLeft[i] = cosf(f * Pi_2);
+    gainRight[i] = channels > 1 ? sinf(f * Pi_2) : 0.f;
+  }
+
+  // returns false when the grain has ended
+  bool render(UInt i, MULTICHANNELBUFFER & out) {
+    UInt offset = delay[i];
+    delay[i] = 0;
+    UInt n = STANDARD_BUFFERSIZE - offset;
+    if (n > framesLeft[i]) n = framesLeft[i];
+
+    const MULTICHANNELBUFFER & pool = *parent->pool;
+    const Flt * in = pool[source[i]].getConstPtr();
+    const Flt poolLength = static_cast<Flt>(parent->poolSize);
+    const Flt s = speed[i];
+    const Flt inc = phaseInc[i];
+    Flt pos = position[i];
+    Flt ph = phase[i];
+
+    Flt grain[STANDARD_BUFFERSIZE];
+    UInt done = 0;
+    while (done < n) {
+      // frames before the read position wraps around the pool
+      Flt room = poolLength - pos;
+      UInt k = room > 1.f ? static_cast<UInt>((room - 1.f) / s) + 1 : 1;
+      if (k > n - done) k = n - done;
+      readGrain(grain + done, in, table, pos, s, ph, inc, k);
+      pos += s * k;
+      ph += inc * k;
+      if (pos >= poolLength) pos -= poolLength;
+      done += k;
+    }
+
+    Flt * ptr = out[left[i]].getPtr() + offset;
+    Flt g = gainLeft[i];
+    for (UInt j = 0; j < n; j++) ptr[j] += grain[j] * g;
+
+    if (gainRight[i] > 0) {
+      ptr = out[right[i]].getPtr() + offset;
+      g = gainRight[i];
+      for (UInt j = 0; j < n; j++) ptr[j] += grain[j] * g;
+    }
+
+    position[i] = pos;
+    phase[i] = ph;
+    framesLeft[i] -= n;
+    return framesLeft[i] > 0;
+  }
+
+  // move the last playing grain to this place
+  void remove(UInt i) {
+    UInt last = --count;
+    position[i] = position[last];
+    speed[i] = speed[last];
+    phase[i] = phase[last];
+    phaseInc[i] = phaseInc[last];
+    framesLeft[i] = framesLeft[last];
+    delay[i] = delay[last];
+    source[i] = source[last];
+    left[i] = left[last];
+    right[i] = right[last];
+    gainLeft[i] = gainLeft[last];
+    gainRight[i] = gainRight[last];
+  }
+
+  granulator * parent;
+  UInt size;
+  UInt count;
+  UInt starts;
+  UInt random;
+  UInt onsets[GRAIN_MAX_STARTS];
+  const Flt * table;
+
+  std::vector<Flt> position; // read position in the pool
+  std::vector<Flt> speed;
+  std::vector<Flt> phase; // position in the window table
+  std::vector<Flt> phaseInc;
+  std::vector<UInt> framesLeft;
+  std::vector<UInt> delay; // frames before the grain starts in the next buffer
+  std::vector<UInt> source; // pool channel
+  std::vector<UInt> left, right; // output channels
+  std::vector<Flt> gainLeft, gainRight;
+};
+
 YSE::DSP::MODULES::granulator::granulator(UInt poolSize, UInt maxGrains) 
-: poolSize(poolSize), parmTranspose(0), parmTransposeRandom(0), parmGain(1.0f)
-, leftOverStarts(0.f)
-, maxGrains(maxGrains)
+: poolSize(poolSize), poolPosition(0)
+, parmFrequency(20), parmLength(2205), parmLengthRandom(0)
+, parmTranspose(0), parmTransposeRandom(0), parmPan(0), parmWindow(GW_HANN), parmGain(1.0f)
+, nextStart(0.f), random(newSeed())
+, maxGrains(maxGrains), active(0)
 {
-  limiter.set(-0.97, 0.97);
+  autoSleep(true);
 }
 
 void YSE::DSP::MODULES::granulator::create() {
-  pool.reset(new DSP::buffer(poolSize));
-  (*pool) = 0;
+  // the pool is created in process, when the number of channels is known
+  pool.reset(new MULTICHANNELBUFFER);
   poolPosition = 0;
-  readPos = 4000;
 
-  grainPool.reset(new std::vector<grain>);
-  for (unsigned int i = 0; i < maxGrains; i++) {
-    grainPool->emplace_back(true);
-  }
+  // make sure the tables exist before grains start
+  Windows();
+
+  grains.reset(new grainSet(this, maxGrains, nextRandom(random) | 1));
 }
 
 void YSE::DSP::MODULES::granulator::process(MULTICHANNELBUFFER & buffer) {
   createIfNeeded();
-  
-  // add current buffer to pool
-  if (pool->getLength() - poolPosition >= buffer[0].getLength()) {
-    pool->copyFrom(buffer[0], 0, poolPosition, buffer[0].getLength());
-    poolPosition += buffer[0].getLength();
-    if (poolPosition == pool->getLength()) poolPosition = 0;
-  }
-  else {
-    UInt length = pool->getLength() - poolPosition;
-    pool->copyFrom(buffer[0], 0, poolPosition, length);
-    poolPosition = 0;
-    pool->copyFrom(buffer[0], length, poolPosition, buffer[0].getLength() - length);
-    poolPosition = buffer[0].getLength() - length;
-  }
+  if (buffer.empty()) return;
 
-  pool->cursor = pool->getPtr() + poolPosition;
-
-  
-  // see how many grains should be started during this buffer
-  Flt newGrains = parmFrequency / (SAMPLERATE / static_cast<Flt>(buffer[0].getLength()));
-  leftOverStarts += newGrains - static_cast<Int>(newGrains);
-  if (leftOverStarts > 1) {
-    newGrains++;
-    leftOverStarts--;
+  UInt channels = static_cast<UInt>(buffer.size());
+  if (pool->size() != channels) {
+    // this only allocates when the number of channels changes. The extra
+    // sample repeats the first one, for interpolation at the end of the pool.
+    pool->assign(channels, DSP::buffer(poolSize, 1));
+    for (UInt c = 0; c < channels; c++) (*pool)[c] = 0;
+    poolPosition = 0;
+    grains->reset();
   }
 
-  // activate grains if needed
-  UInt num = static_cast<Int>(newGrains);
-  if(num) for (UInt i = 0; i < grainPool->size(); i++) {
-    if (grainPool->at(i).state == GS_STOPPED) {
-      UInt length = parmLength;
-      if (parmLengthRandom) length += Random(-(int)parmLengthRandom, parmLengthRandom);
-      Int wait = YSE::BigRandom(poolSize);
-      Flt pitch = 1 + parmTranspose;
-      if (parmTransposeRandom > 0) pitch += RandomF(-parmTransposeRandom, parmTransposeRandom);
-      grainPool->at(i).start(length, wait, pitch, pool.get());
-      num--;
-      if (!num) break;
+  // add current buffer to pool
+  UInt length = buffer[0].getLength();
+  for (UInt c = 0; c < channels; c++) {
+    DSP::buffer & p = (*pool)[c];
+    if (p.getLength() - poolPosition >= length) {
+      p.copyFrom(buffer[c], 0, poolPosition, length);
     }
+    else {
+      UInt part = p.getLength() - poolPosition;
+      p.copyFrom(buffer[c], 0, poolPosition, part);
+      p.copyFrom(buffer[c], part, 0, length - part);
+    }
+    p.copyOverflow();
   }
+  poolPosition += length;
+  if (poolPosition >= poolSize) poolPosition -= poolSize;
 
-  // create new grains if needed
-  while (num--) {
-    grainPool->emplace_back(true);
-    UInt length = parmLength;
-    if (parmLengthRandom) length += Random(-(int)parmLengthRandom, parmLengthRandom);
-    Flt pitch = 1 + parmTranspose;
-    if (parmTransposeRandom > 0) pitch += RandomF(-parmTransposeRandom, parmTransposeRandom);
-    grainPool->back().start(length, YSE::BigRandom(poolSize), pitch, pool.get());
-  }
-
-  // zero input buffer
-  buffer[0] = 0;
+  // schedule new grains at random intervals around the grain frequency
+  Flt frequency = static_cast<Flt>(parmFrequency);
+  if (frequency > 0) {
+    Flt interval = SAMPLERATE / frequency;
+    if (interval < 1.f) interval = 1.f;
+    if (nextStart > interval * 1.5f) nextStart = interval * 1.5f;
 
-  // process grains
-  for (UInt i = 0; i < grainPool->size(); i++) {
-    grainPool->at(i).process(pool.get(), &buffer[0]);
+    while (nextStart < length) {
+      grains->schedule(static_cast<UInt>(nextStart));
+      nextStart += interval * randomF(random, 0.5f, 1.5f);
+    }
+    nextStart -= length;
   }
 
+  // the input is in the pool now, so the grains replace it
+  for (UInt c = 0; c < channels; c++) buffer[c] = 0.f;
+  grains->run(buffer);
+  active = grains->playing();
+
   // adjust gain
-  buffer[0] *= parmGain;  
+  for (UInt c = 0; c < channels; c++) buffer[c] *= parmGain;
 }
 
 YSE::DSP::MODULES::granulator & YSE::DSP::MODULES::granulator::grainLength(UInt samples, UInt random ) {
@@ -219,7 +359,18 @@ YSE::DSP::MODULES::granulator & YSE::DSP::MODULES::granulator::grainTranspose(Fl
   return *this;
 }
 
+YSE::DSP::MODULES::granulator & YSE::DSP::MODULES::granulator::grainPan(Flt spread) {
+  Clamp(spread, 0.f, 1.f);
+  parmPan = spread;
+  return *this;
+}
+
+YSE::DSP::MODULES::granulator & YSE::DSP::MODULES::granulator::window(GRAIN_WINDOW value) {
+  parmWindow = value;
+  return *this;
+}
+
 YSE::DSP::MODULES::granulator & YSE::DSP::MODULES::granulator::gain(Flt value) {
   parmGain = value;
   return *this;
-}
\ No newline at end of file
+}
@@ -12,6 +12,7 @@
 #define GRANULATOR_HPP_INCLUDED
 
 #include "../../headers/defines.hpp"
+#include "../../headers/enums.hpp"
 #include "../dspObject.hpp"
 #include "../math.hpp"
 #include "../fileBuffer.hpp"
@@ -20,11 +21,14 @@
 namespace YSE {
   namespace DSP {
     namespace MODULES {
-      class grain;
 
+      /* The granulator keeps the last poolSize samples of every input channel
+         and plays them back as short grains. All grains are allocated when the
+         object is created: when maxGrains are playing, new grains are skipped.
+      */
       class API granulator : public dspObject {
       public:
-        granulator(UInt poolSize = 44100 * 5, UInt maxGrains = 16);
+        granulator(UInt poolSize = 44100 * 5, UInt maxGrains = 512);
         virtual ~granulator() {};
 
         virtual void create();
@@ -42,27 +46,47 @@ namespace YSE {
         granulator & grainTranspose(Flt pitch, Flt random = 0);
         Flt grainTranspose() { return parmTranspose; }
 
+        /* Random panning of grains. At 0 every grain stays on the channel
+           it reads from, at 1 grains are spread over all channels.
+        */
+        granulator & grainPan(Flt spread);
+        Flt grainPan() { return parmPan; }
+
+        /* The window that fades each grain in and out */
+        granulator & window(GRAIN_WINDOW value);
+        GRAIN_WINDOW window() { return parmWindow; }
+
         granulator & gain(Flt value);
         Flt gain() { return parmGain; }
 
+        /* Number of grains that played in the last buffer */
+        UInt activeGrains() { return active; }
+
+      protected:
+        // grains can read anywhere in the pool
+        virtual UInt tailGap() { return poolSize; }
+
       private:
+        class grainSet;
+
         UInt poolSize;
         UInt poolPosition;
-        std::shared_ptr<DSP::buffer> pool;
-        clip limiter;
+        std::shared_ptr<MULTICHANNELBUFFER> pool; // one ring buffer per input channel
         
         aUInt parmFrequency;
         aUInt parmLength;
         aUInt parmLengthRandom;
         aFlt parmTranspose;
         aFlt parmTransposeRandom;
+        aFlt parmPan;
+        std::atomic<GRAIN_WINDOW> parmWindow;
         aFlt parmGain;
 
-        Flt leftOverStarts;
+        Flt nextStart; // frames until the next grain starts
+        UInt random; // state of the random generator for the scheduler
         UInt maxGrains;
-        std::shared_ptr<std::vector<grain> > grainPool;
-
-        UInt readPos;
+        aUInt active;
+        std::shared_ptr<grainSet> grains;
       };
 
     }
@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+    oscillatorBank.cpp
+    Created: 16 Oct 2026 11:58:21pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include <string.h>
+#include "oscillatorBank.hpp"
+
+namespace {
+  const Flt TWO_PI = 6.28318530717958647692f;
+
+  // Everything below is written with selects instead of branches, so that
+  // it can be vectorized over the lanes of a group.
+
+  // fractional part, also for negative values
+  inline Flt fraction(Flt x) {
+    Flt f = x - (Flt)(Int)x;
+    return f < 0.f ? f + 1.f : f;
+  }
+
+  // Residual of a band limited step, for a discontinuity at phase 0.
+  // idt is 1 / dt, where dt is the phase increment per sample.
+  inline Flt blep(Flt t, Flt dt, Flt idt) {
+    Flt a = t * idt;
+    Flt b = (t - 1.f) * idt;
+    Flt before = a + a - a * a - 1.f;
+    Flt after = b * b + b + b + 1.f;
+    return t < dt ? before : (t > 1.f - dt ? after : 0.f);
+  }
+
+  // residual of a band limited ramp, for a change of slope at phase 0
+  inline Flt blamp(Flt t, Flt dt, Flt idt) {
+    Flt a = t * idt - 1.f;
+    Flt b = (t - 1.f) * idt + 1.f;
+    Flt before = a * a * a * (-1.f / 6.f);
+    Flt after = b * b * b * (1.f / 6.f);
+    return t < dt ? before : (t > 1.f - dt ? after : 0.f);
+  }
+
+  template <YSE::OSCILLATOR_SHAPE S>
+  inline Flt waveform(Flt t, Flt dt, Flt idt);
+
+  template <>
+  inline Flt waveform<YSE::OS_SINE>(Flt t, Flt, Flt) {
+    // sin(2 pi t) = -sin(2 pi x), folded to |x| <= 0.25
+    Flt x = t - 0.5f;
+    x = x > 0.25f ? 0.5f - x : x;
+    x = x < -0.25f ? -0.5f - x : x;
+    Flt a = x * TWO_PI;
+    Flt a2 = a * a;
+    return -a * (0.99999661f + a2 * (-0.16664824f + a2 * (0.00830629f + a2 * -0.00018363f)));
+  }
+
+  template <>
+  inline Flt waveform<YSE::OS_SAW>(Flt t, Flt dt, Flt idt) {
+    return 2.f * t - 1.f - blep(t, dt, idt);
+  }
+
+  template <>
+  inline Flt waveform<YSE::OS_SQUARE>(Flt t, Flt dt, Flt idt) {
+    Flt naive = t < 0.5f ? 1.f : -1.f;
+    Flt half = t < 0.5f ? t + 0.5f : t - 0.5f;
+    return naive + blep(t, dt, idt) - blep(half, dt, idt);
+  }
+
+  template <>
+  inline Flt waveform<YSE::OS_TRIANGLE>(Flt t, Flt dt, Flt idt) {
+    // starts at zero and rises, like the sine
+    Flt u = t < 0.75f ? t + 0.25f : t - 0.75f;
+    Flt d = u - 0.5f;
+    Flt naive = 1.f - 4.f * (d < 0.f ? -d : d);
+    Flt half = u < 0.5f ? u + 0.5f : u - 0.5f;
+    return naive + 8.f * dt * (blamp(u, dt, idt) - blamp(half, dt, idt));
+  }
+}
+
+YSE::DSP::oscillatorBank::oscillatorBank(UInt count, OSCILLATOR_SHAPE shape) : count(0), waveShape(shape) {
+  resize(count);
+}
+
+YSE::DSP::oscillatorBank & YSE::DSP::oscillatorBank::resize(UInt count) {
+  UInt oldGroups = groups.size();
+  UInt newGroups = (count + OSCILLATOR_LANES - 1) / OSCILLATOR_LANES;
+  groups.resize(newGroups);
+
+  // new oscillators, and unused lanes in the last group
+  for (UInt i = count < this->count ? count : this->count; i < newGroups * OSCILLATOR_LANES; i++) {
+    group & g = groups[i / OSCILLATOR_LANES];
+    UInt l = i % OSCILLATOR_LANES;
+    if (i / OSCILLATOR_LANES >= oldGroups || l == 0) g.modulated = false;
+    Bool used = i < count;
+    g.phase[l] = 0.f;
+    g.frequency[l] = used ? 440.f : 0.f;
+    g.amplitude[l] = used ? 1.f : 0.f;
+    g.target[l] = g.amplitude[l];
+    g.fmDepth[l] = g.pmDepth[l] = 0.f;
+    g.fm[l] = g.pm[l] = nullptr;
+  }
+
+  this->count = count;
+  return *this;
+}
+
+YSE::DSP::oscillatorBank & YSE::DSP::oscillatorBank::frequency(UInt index, Flt value) {
+  if (index < count) groups[index / OSCILLATOR_LANES].frequency[index % OSCILLATOR_LANES] = value;
+  return *this;
+}
+
+Flt YSE::DSP::oscillatorBank::frequency(UInt index) const {
+  return index < count ? groups[index / OSCILLATOR_LANES].frequency[index % OSCILLATOR_LANES] : 0.f;
+}
+
+YSE::DSP::oscillatorBank & YSE::DSP::oscillatorBank::amplitude(UInt index, Flt value) {
+  if (index < count) groups[index / OSCILLATOR_LANES].target[index % OSCILLATOR_LANES] = value;
+  return *this;
+}
+
+Flt YSE::DSP::oscillatorBank::amplitude(UInt index) const {
+  return index < count ? groups[index / OSCILLATOR_LANES].target[index % OSCILLATOR_LANES] : 0.f;
+}
+
+YSE::DSP::oscillatorBank & YSE::DSP::oscillatorBank::phase(UInt index, Flt value) {
+  if (index < count) groups[index / OSCILLATOR_LANES].phase[index % OSCILLATOR_LANES] = fraction(value);
+  return *this;
+}
+
+YSE::DSP::oscillatorBank & YSE::DSP::oscillatorBank::fm(UInt index, const YSE::DSP::buffer * source, Flt depth) {
+  if (index >= count) return *this;
+  group & g = groups[index / OSCILLATOR_LANES];
+  UInt l = index % OSCILLATOR_LANES;
+  g.fm[l] = source;
+  g.fmDepth[l] = source == nullptr ? 0.f : depth;
+
+  g.modulated = false;
+  for (UInt i = 0; i < OSCILLATOR_LANES; i++) {
+    if (g.fm[i] != nullptr || g.pm[i] != nullptr) g.modulated = true;
+  }
+  return *this;
+}
+
+YSE::DSP::oscillatorBank & YSE::DSP::oscillatorBank::pm(UInt index, const YSE::DSP::buffer * source, Flt depth) {
+  if (index >= count) return *this;
+  group & g = groups[index / OSCILLATOR_LANES];
+  UInt l = index % OSCILLATOR_LANES;
+  g.pm[l] = source;
+  g.pmDepth[l] = source == nullptr ? 0.f : depth;
+
+  g.modulated = false;
+  for (UInt i = 0; i < OSCILLATOR_LANES; i++) {
+    if (g.fm[i] != nullptr || g.pm[i] != nullptr) g.modulated = true;
+  }
+  return *this;
+}
+
+YSE::DSP::buffer & YSE::DSP::oscillatorBank::operator()(UInt length) {
+  if (length != buffer.getLength()) buffer.resize(length);
+  Flt * mix = buffer.getPtr();
+  memset(mix, 0, length * sizeof(Flt));
+
+  for (UInt i = 0; i < groups.size(); i++) render(groups[i], length, mix, nullptr);
+  return buffer;
+}
+
+void YSE::DSP::oscillatorBank::process(MULTICHANNELBUFFER & out, UInt length) {
+  Flt * ptr[OSCILLATOR_LANES];
+  for (UInt i = 0; i < groups.size(); i++) {
+    for (UInt l = 0; l < OSCILLATOR_LANES; l++) {
+      UInt index = i * OSCILLATOR_LANES + l;
+      ptr[l] = nullptr;
+      if (index >= count || index >= out.size()) continue;
+      if (out[index].getLength() != length) out[index].resize(length);
+      ptr[l] = out[index].getPtr();
+    }
+    render(groups[i], length, nullptr, ptr);
+  }
+}
+
+void YSE::DSP::oscillatorBank::render(group & g, UInt length, Flt * mix, Flt * const * out) {
+  // a single oscillator doesn't need a whole group
+  if (count == 1) {
+    switch (waveShape) {
+      case OS_SINE: g.modulated ? run<1, OS_SINE, true>(g, length, mix, out) : run<1, OS_SINE, false>(g, length, mix, out); break;
+      case OS_SAW: g.modulated ? run<1, OS_SAW, true>(g, length, mix, out) : run<1, OS_SAW, false>(g, length, mix, out); break;
+      case OS_SQUARE: g.modulated ? run<1, OS_SQUARE, true>(g, length, mix, out) : run<1, OS_SQUARE, false>(g, length, mix, out); break;
+      case OS_TRIANGLE: g.modulated ? run<1, OS_TRIANGLE, true>(g, length, mix, out) : run<1, OS_TRIANGLE, false>(g, length, mix, out); break;
+    }
+    return;
+  }
+
+  const UInt L = OSCILLATOR_LANES;
+  switch (waveShape) {
+    case OS_SINE: g.modulated ? run<L, OS_SINE, true>(g, length, mix, out) : run<L, OS_SINE, false>(g, length, mix, out); break;
+    case OS_SAW: g.modulated ? run<L, OS_SAW, true>(g, length, mix, out) : run<L, OS_SAW, false>(g, length, mix, out); break;
+    case OS_SQUARE: g.modulated ? run<L, OS_SQUARE, true>(g, length, mix, out) : run<L, OS_SQUARE, false>(g, length, mix, out); break;
+    case OS_TRIANGLE: g.modulated ? run<L, OS_TRIANGLE, true>(g, length, mix, out) : run<L, OS_TRIANGLE, false>(g, length, mix, out); break;
+  }
+}
+
+template <UInt L, YSE::OSCILLATOR_SHAPE S, Bool MODULATED>
+void YSE::DSP::oscillatorBank::run(group & g, UInt length, Flt * mix, Flt * const * out) {
+  // Like biQuadBank, samples are interleaved per lane in a small frame and
+  // the state is copied to locals, so that the inner loop runs over the
+  // lanes with contiguous data.
+  Flt frame[STANDARD_BUFFERSIZE][L];
+  Flt fmFrame[MODULATED ? STANDARD_BUFFERSIZE : 1][L];
+  Flt pmFrame[MODULATED ? STANDARD_BUFFERSIZE : 1][L];
+  Flt phase[L], increment[L], amplitude[L], step[L];
+
+  const Flt conv = 1.f / SAMPLERATE;
+  for (UInt l = 0; l < L; l++) {
+    phase[l] = g.phase[l];
+    increment[l] = g.frequency[l] * conv;
+    amplitude[l] = g.amplitude[l];
+    step[l] = length > 0 ? (g.target[l] - g.amplitude[l]) / length : 0.f;
+  }
+
+  for (UInt start = 0; start < length; start += STANDARD_BUFFERSIZE) {
+    UInt n = length - start < STANDARD_BUFFERSIZE ? length - start : STANDARD_BUFFERSIZE;
+
+    if (MODULATED) {
+      for (UInt l = 0; l < L; l++) {
+        const YSE::DSP::buffer * f = g.fm[l];
+        if (f == nullptr || f->getLength() < start + n) {
+          for (UInt i = 0; i < n; i++) fmFrame[i][l] = 0.f;
+        }
+        else {
+          const Flt * ptr = f->getConstPtr() + start;
+          Flt depth = g.fmDepth[l] * conv;
+          for (UInt i = 0; i < n; i++) fmFrame[i][l] = ptr[i] * depth;
+        }
+
+        const YSE::DSP::buffer * p = g.pm[l];
+        if (p == nullptr || p->getLength() < start + n) {
+          for (UInt i = 0; i < n; i++) pmFrame[i][l] = 0.f;
+        }
+        else {
+          const Flt * ptr = p->getConstPtr() + start;
+          Flt depth = g.pmDepth[l];
+          for (UInt i = 0; i < n; i++) pmFrame[i][l] = ptr[i] * depth;
+        }
+      }
+    }
+
+    for (UInt i = 0; i < n; i++) {
+      for (UInt l = 0; l < L; l++) {
+        Flt inc = MODULATED ? increment[l] + fmFrame[i][l] : increment[l];
+        Flt t = MODULATED ? fraction(phase[l] + pmFrame[i][l]) : phase[l];
+
+        // the width of the correction, which has to stay below half a cycle
+        Flt dt = inc < 0.f ? -inc : inc;
+        dt = dt < 1e-6f ? 1e-6f : (dt > 0.5f ? 0.5f : dt);
+
+        frame[i][l] = waveform<S>(t, dt, 1.f / dt) * amplitude[l];
+        amplitude[l] += step[l];
+        phase[l] = fraction(phase[l] + inc);
+      }
+    }
+
+    if (mix != nullptr) {
+      Flt * ptr = mix + start;
+      for (UInt i = 0; i < n; i++) {
+        Flt s = 0.f;
+        for (UInt l = 0; l < L; l++) s += frame[i][l];
+        ptr[i] += s;
+      }
+    }
+    else {
+      for (UInt l = 0; l < L; l++) {
+        if (out[l] == nullptr) continue;
+        Flt * ptr = out[l] + start;
+        for (UInt i = 0; i < n; i++) ptr[i] = frame[i][l];
+      }
+    }
+  }
+
+  for (UInt l = 0; l < L; l++) {
+    g.phase[l] = phase[l];
+    g.amplitude[l] = g.target[l];
+  }
+}
@@ -40,7 +40,7 @@ namespace YSE {
     YSE::DSP::buffer & saw::operator()(YSE::DSP::buffer & in) {
       if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
 
-      inPtr = in.getPtr();
+      inPtr = in.getConstPtr();
       calc(false);
 
       return buffer;
@@ -115,7 +115,7 @@ namespace YSE {
         buffer.resize(in.getLength());
       }
 
-      Flt * inPtr = in.getPtr();
+      const Flt * inPtr = in.getConstPtr();
       Flt * outPtr = buffer.getPtr();
       UInt  length = in.getLength();
 
@@ -164,7 +164,7 @@ namespace YSE {
     YSE::DSP::buffer & sine::operator()(YSE::DSP::buffer & in) {
       if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
 
-      inPtr = in.getPtr();
+      inPtr = in.getConstPtr();
       calc(false);
 
       return buffer;
@@ -230,7 +230,7 @@ namespace YSE {
       oscillator
     **********************************************************************************/
 
-    oscillator::oscillator() : phase(0), conv(0), table(nullptr) {}
+    oscillator::oscillator() : phase(0), conv(0), table(nullptr), set(nullptr) {}
 
     void oscillator::reset() {
       phase = 0;
@@ -239,12 +239,18 @@ namespace YSE {
 
     void oscillator::initialize(wavetable & source) {
       table = &source;
+      set = nullptr;
+    }
+
+    void oscillator::initialize(wavetableSet & source) {
+      set = &source;
+      table = nullptr;
     }
 
     YSE::DSP::buffer & oscillator::operator()(YSE::DSP::buffer & in) {
       if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
 
-      inPtr = in.getPtr();
+      inPtr = in.getConstPtr();
       calc(false);
 
       return buffer;
@@ -260,6 +266,11 @@ namespace YSE {
     }
 
     void oscillator::calc(Bool useFrequency) {
+      if (set != nullptr) {
+        calcSet(useFrequency);
+        return;
+      }
+
       Flt * outPtr = buffer.getPtr();
       UInt bufferLength = buffer.getLength();
       Flt * tablePtr = table->getPtr();
@@ -284,6 +295,97 @@ namespace YSE {
 
     }
 
+    void oscillator::calcSet(Bool useFrequency) {
+      if (!set->ready()) {
+        buffer = 0.f;
+        return;
+      }
+
+      Flt * outPtr = buffer.getPtr();
+      UInt bufferLength = buffer.getLength();
+      UInt tableLength = set->length();
+      Flt increase = tableLength / static_cast<Flt>(SAMPLERATE);
+
+      Flt highest = fabsf(frequency);
+      if (!useFrequency) {
+        highest = 0.f;
+        for (UInt i = 0; i < bufferLength; i++) {
+          Flt f = fabsf(inPtr[i]);
+          highest = f > highest ? f : highest;
+        }
+      }
+
+      const Flt * lower, *upper;
+      Flt fade;
+      set->select(highest, lower, upper, fade);
+
+      // Positions are accumulated first, so that the interpolation loop has
+      // no dependency between samples and can be vectorized. Index and fraction
+      // come from the double phase: as a float, a phase just below tableLength
+      // can round up to tableLength and read past the table.
+      Int index[STANDARD_BUFFERSIZE];
+      Flt frac[STANDARD_BUFFERSIZE];
+
+      while (bufferLength > 0) {
+        UInt length = bufferLength < STANDARD_BUFFERSIZE ? bufferLength : STANDARD_BUFFERSIZE;
+
+        for (UInt i = 0; i < length; i++) {
+          index[i] = static_cast<Int>(phase);
+          frac[i] = static_cast<Flt>(phase - index[i]);
+          phase += (useFrequency ? frequency : *inPtr++) * increase;
+          while (phase >= tableLength) phase -= tableLength;
+          while (phase < 0) phase += tableLength;
+        }
+
+        if (fade == 0.f) {
+          for (UInt i = 0; i < length; i++) {
+            Int n = index[i];
+            outPtr[i] = lower[n] + frac[i] * (lower[n + 1] - lower[n]);
+          }
+        }
+        else {
+          for (UInt i = 0; i < length; i++) {
+            Int n = index[i];
+            Flt a = lower[n] + frac[i] * (lower[n + 1] - lower[n]);
+            Flt b = upper[n] + frac[i] * (upper[n + 1] - upper[n]);
+            outPtr[i] = a + fade * (b - a);
+          }
+        }
+
+        outPtr += length;
+        bufferLength -= length;
+      }
+    }
+
+    /**********************************************************************************
+      blepOscillator
+    **********************************************************************************/
+
+    blepOscillator::blepOscillator(OSCILLATOR_SHAPE shape) : bank(1, shape) {}
+
+    blepOscillator & blepOscillator::shape(OSCILLATOR_SHAPE value) {
+      bank.shape(value);
+      return (*this);
+    }
+
+    void blepOscillator::reset() {
+      bank.phase(0, 0.f);
+    }
+
+    YSE::DSP::buffer & blepOscillator::operator()(Flt frequency, UInt length) {
+      bank.frequency(0, frequency);
+      return bank(length);
+    }
+
+    YSE::DSP::buffer & blepOscillator::operator()(YSE::DSP::buffer & in) {
+      // the input is used as frequency modulation of 0 Hz
+      bank.frequency(0, 0.f);
+      bank.fm(0, &in);
+      YSE::DSP::buffer & result = bank(in.getLength());
+      bank.fm(0, nullptr);
+      return result;
+    }
+
     /**********************************************************************************/
 
     noise::noise() : value(307 * 1319) {}
@@ -317,8 +419,8 @@ namespace YSE {
       if (in.getLength() != buffer.getLength()) buffer.resize(in.getLength());
       if (in.getLength() != out2.getLength()) out2.resize(in.getLength());
 
-      Flt * inPtr = in.getPtr();
-      Flt * centerPtr = center.getPtr();
+      const Flt * inPtr = in.getConstPtr();
+      const Flt * centerPtr = center.getConstPtr();
       Flt * out1Ptr = buffer.getPtr();
       Flt * out2Ptr = out2.getPtr();
       UInt length = in.getLength();
@@ -16,6 +16,8 @@
 #include "../headers/constants.hpp"
 #include "buffer.hpp"
 #include "wavetable.hpp"
+#include "wavetableSet.hpp"
+#include "oscillatorBank.hpp"
 
 /* Constructor aside, all these objects should be used in dsp mode only */
 
@@ -34,7 +36,7 @@ namespace YSE {
       Flt frequency;
       YSE::DSP::buffer buffer;
 
-      Flt *inPtr;
+      const Flt *inPtr;
       void calc(Bool useFrequency);
     };
 
@@ -60,7 +62,7 @@ namespace YSE {
       Flt conv;
       Flt frequency;
 
-      Flt *inPtr;
+      const Flt *inPtr;
       void calc(Bool useFrequency);
     };
 
@@ -72,6 +74,9 @@ namespace YSE {
       YSE::DSP::buffer & operator()(YSE::DSP::buffer & in);
 
       void initialize(wavetable & source);
+      // Play a band limited set. The levels are chosen once per block, for
+      // the highest frequency in it.
+      void initialize(wavetableSet & source);
       void reset(); // set the phase back to zero 
 
     private:
@@ -80,9 +85,25 @@ namespace YSE {
       Flt conv;
       Flt frequency;
       wavetable * table;
+      wavetableSet * set;
 
-      Flt *inPtr;
+      const Flt *inPtr;
       void calc(Bool useFrequency);
+      void calcSet(Bool useFrequency);
+    };
+
+    /* A single band limited saw, square, triangle or sine, see oscillatorBank.
+    */
+    class API blepOscillator {
+    public:
+      YSE::DSP::buffer & operator()(Flt frequency, UInt length = STANDARD_BUFFERSIZE);
+      YSE::DSP::buffer & operator()(YSE::DSP::buffer & in);
+      blepOscillator(OSCILLATOR_SHAPE shape = OS_SAW);
+      blepOscillator & shape(OSCILLATOR_SHAPE value);
+      void reset(); // set the phase back to zero
+
+    private:
+      oscillatorBank bank;
     };
 
     class API noise {
@@ -11,26 +11,24 @@
 #include "ramp.hpp"
 #include "../utils/misc.hpp"
 
-YSE::DSP::ramp::ramp() : target(0), time(0), current(0), ticksLeft(0), reTarget(false)  {
-  _1overN = 1.0f / getLength();
-  _dspTickToMSEC = SAMPLERATE / (1000.0f * getLength());
+YSE::DSP::ramp::ramp() : target(0), time(0), current(0), samplesLeft(0), reTarget(false), inc(0)  {
+  _msecToSamples = SAMPLERATE / 1000.0f;
 }
 
-YSE::DSP::ramp::ramp(YSE::DSP::ramp & source) {
-  ticksLeft.store(source.ticksLeft);
+YSE::DSP::ramp::ramp(YSE::DSP::ramp & source) : inc(0) {
+  samplesLeft.store(source.samplesLeft);
   reTarget.store(source.reTarget);
   current.store(source.current);
   target.store(source.target);
   time.store(source.time);
-  _1overN = 1.0f / getLength();
-  _dspTickToMSEC = SAMPLERATE / (1000.0f * getLength());
+  _msecToSamples = SAMPLERATE / 1000.0f;
 }
 
 YSE::DSP::ramp& YSE::DSP::ramp::set(Flt target, Int time) {
   if (time <= 0) {
     this->target = target;
     this->current = target;
-    this->ticksLeft = 0;
+    this->samplesLeft = 0;
     this->reTarget = false;
   }
   else {
@@ -48,39 +46,69 @@ YSE::DSP::ramp& YSE::DSP::ramp::setIfNew(Flt target, Int time) {
 
 YSE::DSP::ramp& YSE::DSP::ramp::stop() {
   target = current.load();
-  ticksLeft = 0;
+  samplesLeft = 0;
   reTarget = false;
   return (*this);
 }
 
 YSE::DSP::ramp& YSE::DSP::ramp::update() {
+  return update(0, getLength());
+}
+
+void YSE::DSP::ramp::retarget() {
   if (reTarget) {
-    nTicks = (Int)(time * _dspTickToMSEC);
-    if (!nTicks) nTicks = 1;
-    ticksLeft = nTicks;
-    bigInc = (target - current) / static_cast<Flt>(nTicks);
-    inc = _1overN * bigInc;
+    Int n = (Int)(time * _msecToSamples);
+    if (!n) n = 1;
+    samplesLeft = n;
+    inc = (target - current) / static_cast<Flt>(n);
     reTarget = false;
   }
+}
 
-  l = getLength();
-  ptr = getPtr();
-  if (ticksLeft) {
-    f = current;
+YSE::DSP::ramp& YSE::DSP::ramp::update(UInt from, UInt to) {
+  if (to > getLength()) to = getLength();
+  if (from >= to) return (*this);
 
-    while (l--) *ptr++ = f, f += inc;
-    current.store(current.load() + bigInc);
-    ticksLeft--;
+  retarget();
+
+  Flt * ptr = getPtr() + from;
+  UInt l = to - from;
+  Flt f = current;
+
+  if (samplesLeft > 0) {
+    UInt n = static_cast<UInt>(samplesLeft.load()) < l ? static_cast<UInt>(samplesLeft.load()) : l;
+    for (UInt i = 0; i < n; i++) ptr[i] = f + inc * i;
+    samplesLeft -= n;
+    ptr += n;
+    l -= n;
+    f = samplesLeft > 0 ? f + inc * n : target.load();
   }
   else {
-    f = current = target.load();
-    for (; l > 7; l -= 8, ptr += 8) {
-      ptr[0] = f; ptr[1] = f; ptr[2] = f; ptr[3] = f;
-      ptr[4] = f; ptr[5] = f; ptr[6] = f; ptr[7] = f;
-    }
-    while (l--) *ptr++ = f;
+    f = target;
   }
 
+  // the rest of the segment is at the target
+  for (; l > 7; l -= 8, ptr += 8) {
+    ptr[0] = f; ptr[1] = f; ptr[2] = f; ptr[3] = f;
+    ptr[4] = f; ptr[5] = f; ptr[6] = f; ptr[7] = f;
+  }
+  while (l--) *ptr++ = f;
+
+  current = f;
+  return (*this);
+}
+
+YSE::DSP::ramp& YSE::DSP::ramp::advance(UInt frames) {
+  retarget();
+
+  if (samplesLeft > 0) {
+    UInt n = static_cast<UInt>(samplesLeft.load()) < frames ? static_cast<UInt>(samplesLeft.load()) : frames;
+    samplesLeft -= n;
+    current = samplesLeft > 0 ? current + inc * n : target.load();
+  }
+  else {
+    current = target.load();
+  }
   return (*this);
 }
 
@@ -152,7 +180,7 @@ void YSE::DSP::ChangeGain(YSE::DSP::buffer & s, Flt currentGain, Flt newGain, UI
 
 /************************************************************************/
 
-YSE::DSP::lint::lint() : targetValue(0), currentValue(0), step(0), up(false), calculate(false) {
+YSE::DSP::lint::lint() : targetValue(0), currentValue(0), previousValue(0), step(0), up(false), calculate(false) {
   stepSecond = SAMPLERATE / static_cast<Flt>(STANDARD_BUFFERSIZE);
 }
 
@@ -165,11 +193,23 @@ Flt YSE::DSP::lint::target() {
   return targetValue;
 }
 
+Flt YSE::DSP::lint::previous() {
+  return previousValue;
+}
+
 YSE::DSP::lint& YSE::DSP::lint::update() {
+  return update(STANDARD_BUFFERSIZE);
+}
+
+YSE::DSP::lint& YSE::DSP::lint::update(UInt frames) {
+  previousValue = currentValue.load();
   if (calculate) {
-    currentValue = currentValue + step;
-    if (up && currentValue >= targetValue) calculate = false;
-    if (!up && currentValue <= targetValue) calculate = false;
+    // step is the change for a whole buffer
+    currentValue = currentValue + step * (frames / static_cast<Flt>(STANDARD_BUFFERSIZE));
+    if ((up && currentValue >= targetValue) || (!up && currentValue <= targetValue)) {
+      currentValue = targetValue.load();
+      calculate = false;
+    }
   }
   return *this;
 }
@@ -23,6 +23,19 @@ namespace YSE {
       ramp& setIfNew(Flt target, Int time = 0);
       ramp& stop();
       ramp& update();
+
+      /** Render only the samples from 'from' up to (not including) 'to'. A new
+          target takes effect at 'from', so changes can start at any frame in
+          the buffer. Render the segments of a buffer in order.
+      */
+      ramp& update(UInt from, UInt to);
+
+      /** Control rate: move the ramp ahead by 'frames' without rendering
+          them. getValue() then returns the value at that frame, so that
+          consumers can interpolate or apply a constant themselves.
+      */
+      ramp& advance(UInt frames);
+
       // TODO: check update and operator functions for consistency with other DSP objects
       YSE::DSP::buffer & operator()();
       YSE::DSP::buffer & getSample();
@@ -32,19 +45,17 @@ namespace YSE {
       ramp(ramp &);
 
     private:
+      // start a new ramp if the target has changed
+      void retarget();
+
       aFlt target;
       aFlt time;
       aFlt current;
-      aInt ticksLeft;
+      aInt samplesLeft;
       aBool reTarget;
 
-      Flt _1overN;
-      Flt _dspTickToMSEC;
-      Flt inc, bigInc;
-      Int nTicks;
-      Int l;
-      Flt * ptr;
-      Flt f;
+      Flt _msecToSamples;
+      Flt inc;
     };
 
     class API lint {
@@ -57,11 +68,13 @@ namespace YSE {
       lint& setIfNew(Flt target, Int time); // set only if target is different from current target
       lint& stop(); // sets target to current value
       lint& update(); // call this once for every buffer update
+      lint& update(UInt frames); // control rate: move ahead by a part of a buffer
+      Flt previous(); // value before the last update, to interpolate from
       Flt target(); // returns target
       Flt operator()(); // returns current value
       lint();
     private:
-      aFlt targetValue, currentValue, step;
+      aFlt targetValue, currentValue, previousValue, step;
       aBool up, calculate;
       Flt stepSecond;
     };
@@ -20,8 +20,8 @@ YSE::DSP::buffer & YSE::DSP::realOnePole::operator()(buffer & in1, buffer & in2)
   }
 
   UInt n = in1.getLength();
-  Flt * in1Ptr = in1.getPtr();
-  Flt * in2Ptr = in2.getPtr();
+  const Flt * in1Ptr = in1.getConstPtr();
+  const Flt * in2Ptr = in2.getConstPtr();
   Flt * outPtr = out.getPtr();
 
   for (UInt i = 0; i < n; i++) {
@@ -44,8 +44,8 @@ YSE::DSP::buffer & YSE::DSP::realOneZero::operator()(buffer & in1, buffer & in2)
   }
 
   UInt n = in1.getLength();
-  Flt * in1Ptr = in1.getPtr();
-  Flt * in2Ptr = in2.getPtr();
+  const Flt * in1Ptr = in1.getConstPtr();
+  const Flt * in2Ptr = in2.getConstPtr();
   Flt * outPtr = out.getPtr();
 
   for (UInt i = 0; i < n; i++) {
@@ -69,8 +69,8 @@ YSE::DSP::buffer & YSE::DSP::realOneZeroReversed::operator()(buffer & in1, buffe
   }
 
   UInt n = in1.getLength();
-  Flt * in1Ptr = in1.getPtr();
-  Flt * in2Ptr = in2.getPtr();
+  const Flt * in1Ptr = in1.getConstPtr();
+  const Flt * in2Ptr = in2.getConstPtr();
   Flt * outPtr = out.getPtr();
 
   for (UInt i = 0; i < n; i++) {
@@ -109,11 +109,11 @@ MULTICHANNELBUFFER & YSE::DSP::complexOnePole::operator()(MULTICHANNELBUFFER & i
     return out;
   }
 
-  Flt * realIn1 = in1[0].getPtr();
-  Flt * realIn2 = in2[0].getPtr();
+  const Flt * realIn1 = in1[0].getConstPtr();
+  const Flt * realIn2 = in2[0].getConstPtr();
   Flt * realOut = out[0].getPtr();
-  Flt * imaginaryIn1 = in1[1].getPtr();
-  Flt * imaginaryIn2 = in2[1].getPtr();
+  const Flt * imaginaryIn1 = in1[1].getConstPtr();
+  const Flt * imaginaryIn2 = in2[1].getConstPtr();
   Flt * imaginaryOut = out[1].getPtr();
 
   UInt n = in1[0].getLength();
@@ -157,11 +157,11 @@ MULTICHANNELBUFFER & YSE::DSP::complexOneZero::operator()(MULTICHANNELBUFFER & i
     return out;
   }
 
-  Flt * realIn1 = in1[0].getPtr();
-  Flt * realIn2 = in2[0].getPtr();
+  const Flt * realIn1 = in1[0].getConstPtr();
+  const Flt * realIn2 = in2[0].getConstPtr();
   Flt * realOut = out[0].getPtr();
-  Flt * imaginaryIn1 = in1[1].getPtr();
-  Flt * imaginaryIn2 = in2[1].getPtr();
+  const Flt * imaginaryIn1 = in1[1].getConstPtr();
+  const Flt * imaginaryIn2 = in2[1].getConstPtr();
   Flt * imaginaryOut = out[1].getPtr();
 
   UInt n = in1[0].getLength();
@@ -206,11 +206,11 @@ MULTICHANNELBUFFER & YSE::DSP::complexOneZeroReversed::operator()(MULTICHANNELBU
     return out;
   }
 
-  Flt * realIn1 = in1[0].getPtr();
-  Flt * realIn2 = in2[0].getPtr();
+  const Flt * realIn1 = in1[0].getConstPtr();
+  const Flt * realIn2 = in2[0].getConstPtr();
   Flt * realOut = out[0].getPtr();
-  Flt * imaginaryIn1 = in1[1].getPtr();
-  Flt * imaginaryIn2 = in2[1].getPtr();
+  const Flt * imaginaryIn1 = in1[1].getConstPtr();
+  const Flt * imaginaryIn2 = in2[1].getConstPtr();
   Flt * imaginaryOut = out[1].getPtr();
 
   UInt n = in1[0].getLength();
@@ -48,7 +48,7 @@ void YSE::DSP::wavetable::createFourierTable(const std::vector<Flt> & harmonics,
   phase *= YSE::Pi2;
 
   for (UInt i = 0; i < harmonics.size(); i++) {
-    Flt * ptr = storage.data();
+    Flt * ptr = getPtr();
     Flt amplitude = harmonics[i];
 
     for (int j = 0; j < length; j++) {
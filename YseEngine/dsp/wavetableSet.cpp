@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    wavetableSet.cpp
+    Created: 16 Oct 2026 12:41:07am
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <math.h>
+#include "wavetableSet.hpp"
+#include "fourier/fftPlan.h"
+#include "../utils/misc.hpp"
+#include "../internalHeaders.h"
+
+
+class YSE::DSP::wavetableSet::loadJob : public YSE::INTERNAL::threadPoolJob {
+public:
+  loadJob(wavetableSet * owner) : owner(owner) {}
+  virtual void run() { owner->load(); }
+
+private:
+  wavetableSet * owner;
+};
+
+YSE::DSP::wavetableSet::wavetableSet(UInt length) : size(4), numLevels(0), isReady(false), job(new loadJob(this)) {
+  while (size < length) size <<= 1;
+
+  // level 0 has size / 4 harmonics, the last level only one
+  for (UInt h = size / 4; h > 0; h >>= 1) numLevels++;
+}
+
+YSE::DSP::wavetableSet::~wavetableSet() {}
+
+YSE::DSP::wavetableSet & YSE::DSP::wavetableSet::createSaw() {
+  std::vector<Flt> amps;
+  for (UInt i = 0; i < size / 4; i++) {
+    amps.emplace_back(1.f / (i + 1));
+  }
+  return createFourierTable(amps, -0.25f);
+}
+
+YSE::DSP::wavetableSet & YSE::DSP::wavetableSet::createSquare() {
+  std::vector<Flt> amps;
+  for (UInt i = 0; i < size / 4; i++) {
+    if (i % 2 != 0) amps.emplace_back(0);
+    else amps.emplace_back(1.f / (i + 1));
+  }
+  return createFourierTable(amps, -0.25f);
+}
+
+YSE::DSP::wavetableSet & YSE::DSP::wavetableSet::createTriangle() {
+  std::vector<Flt> amps;
+  for (UInt i = 0; i < size / 4; i++) {
+    if (i % 2 != 0) amps.emplace_back(0);
+    else amps.emplace_back(1.f / ((i + 1) * (i + 1)));
+  }
+  return createFourierTable(amps, 0);
+}
+
+YSE::DSP::wavetableSet & YSE::DSP::wavetableSet::createFourierTable(const std::vector<Flt> & harmonics, Flt phase) {
+  job->join();
+  real.assign(size, 0.f);
+  imaginary.assign(size, 0.f);
+
+  Flt re = cosf(phase * YSE::Pi2);
+  Flt im = sinf(phase * YSE::Pi2);
+  for (UInt i = 0; i < harmonics.size() && i < size / 4; i++) {
+    real[i + 1] = harmonics[i] * re;
+    imaginary[i + 1] = harmonics[i] * im;
+  }
+
+  queue();
+  return *this;
+}
+
+Bool YSE::DSP::wavetableSet::create(const wavetable & source) {
+  UInt length = source.getLength();
+  const fftPlan * plan = fftPlan::get(length);
+  if (plan == nullptr || length < 4) return false;
+
+  job->join();
+  real.assign(size, 0.f);
+  imaginary.assign(size, 0.f);
+
+  // This is only done once per waveform, so the work arrays are not kept.
+  // Bin h of any length is harmonic h, only the scale differs.
+  std::vector<Flt> re(length), im(length), workRe(length / 2), workIm(length / 2);
+  plan->realForward(source.getConstPtr(), re.data(), im.data(), workRe.data(), workIm.data());
+
+  UInt bins = std::min(length / 2 - 1, size / 4);
+  for (UInt i = 0; i <= bins; i++) {
+    real[i] = re[i];
+    imaginary[i] = im[i];
+  }
+
+  queue();
+  return true;
+}
+
+void YSE::DSP::wavetableSet::queue() {
+  isReady = false;
+  INTERNAL::Global().addSlowJob(job.get());
+}
+
+void YSE::DSP::wavetableSet::load() {
+  const fftPlan * plan = fftPlan::get(size);
+  std::vector<Flt> re(size), im(size), workRe(size), workIm(size);
+
+  tables.assign(numLevels * (size + 1), 0.f);
+
+  UInt harmonics = size / 4;
+  for (UInt l = 0; l < numLevels; l++) {
+    std::fill(re.begin(), re.end(), 0.f);
+    std::fill(im.begin(), im.end(), 0.f);
+    for (UInt i = 0; i <= harmonics; i++) {
+      re[i] = real[i];
+      im[i] = imaginary[i];
+    }
+
+    Flt * table = tables.data() + l * (size + 1);
+    plan->realInverse(re.data(), im.data(), table, workRe.data(), workIm.data());
+    table[size] = table[0];
+    harmonics >>= 1;
+  }
+
+  // All levels get the gain that normalizes level 0, so that they are equally
+  // loud. Fewer harmonics never add up to a much higher peak.
+  Flt peak = 0.f;
+  for (UInt i = 0; i < size; i++) {
+    if (fabsf(tables[i]) > peak) peak = fabsf(tables[i]);
+  }
+  if (peak > 0.f) {
+    Flt gain = 1.f / peak;
+    for (UInt i = 0; i < tables.size(); i++) tables[i] *= gain;
+  }
+
+  isReady = true;
+}
+
+void YSE::DSP::wavetableSet::select(Flt frequency, const Flt * & lower, const Flt * & upper, Flt & fade) const {
+  // Level l is free of aliasing up to nyquist / ((size / 4) >> l). This is
+  // the position of the frequency in those octaves.
+  Flt octave = log2f(fabsf(frequency) * (size / 4) / (SAMPLERATE * 0.5f) + 1e-9f);
+
+  Int l = static_cast<Int>(ceilf(octave));
+  if (l < 0) l = 0;
+
+  if (l >= static_cast<Int>(numLevels) - 1) {
+    lower = upper = level(numLevels - 1);
+    fade = 0.f;
+    return;
+  }
+
+  lower = level(l);
+  upper = level(l + 1);
+  fade = (octave - (l - 0.5f)) * 2.f;
+  if (fade < 0.f) fade = 0.f;
+  if (fade > 1.f) fade = 1.f;
+}
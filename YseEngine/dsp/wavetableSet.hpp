@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    wavetableSet.hpp
+    Created: 16 Oct 2026 12:41:07am
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef WAVETABLESET_HPP_INCLUDED
+#define WAVETABLESET_HPP_INCLUDED
+
+#include <vector>
+#include <memory>
+#include "wavetable.hpp"
+
+namespace YSE {
+  namespace DSP {
+
+    /*
+    A single cycle waveform at several bandwidths, one per octave, so that an
+    oscillator can play it at any pitch without aliasing and without losing
+    the high harmonics at low pitches.
+    - Level 0 holds length / 4 harmonics, every next level half of the
+    harmonics of the previous one, down to a sine. All levels have the same
+    length, so an oscillator can read two of them at the same position.
+    - Levels are calculated with an inverse fft on the slow thread pool. The
+    create functions only queue that job and return immediately. Oscillators
+    stay silent until ready() returns true.
+    - A set is meant to be shared: initialize any number of oscillators with
+    the same set. It must outlive them, and it should not be created again
+    while they are playing it.
+    - Memory: 4 * length bytes per level, or 80kB for the default length of
+    2048.
+    */
+
+    class API wavetableSet {
+    public:
+      // length is rounded up to a power of two
+      wavetableSet(UInt length = 2048);
+      ~wavetableSet();
+
+      wavetableSet & createSaw();
+      wavetableSet & createSquare();
+      wavetableSet & createTriangle();
+
+      // amplitude per harmonic, starting at the fundamental, with a phase
+      // (in cycles) that is added to all harmonics, as in wavetable
+      wavetableSet & createFourierTable(const std::vector<Flt> & harmonics, Flt phase);
+
+      // Uses the spectrum of one cycle of any waveform. The length of source
+      // must be a power of two, otherwise this returns false.
+      Bool create(const wavetable & source);
+
+      Bool ready() const { return isReady; }
+
+      UInt length() const { return size; }
+      UInt levels() const { return numLevels; }
+
+      // A level holds length() + 1 values, the last one is a copy of the first.
+      const Flt * level(UInt index) const { return tables.data() + index * (size + 1); }
+
+      /* The levels to use for a frequency in Hz. Lower is the brightest level
+         that does not alias at this frequency. In the upper half of the octave
+         of a level, the next level is faded in, so that switching to it doesn't
+         change the sound abruptly. Fade is the weight of upper.
+      */
+      void select(Flt frequency, const Flt * & lower, const Flt * & upper, Flt & fade) const;
+
+    private:
+      class loadJob;
+
+      void queue();
+      void load();
+
+      UInt size, numLevels;
+      aBool isReady;
+
+      // spectrum of the waveform, used by the job
+      std::vector<Flt> real, imaginary;
+
+      std::vector<Flt> tables;
+
+      std::unique_ptr<loadJob> job;
+    };
+
+  }
+}
+
+#endif  // WAVETABLESET_HPP_INCLUDED
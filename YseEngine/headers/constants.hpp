@@ -16,6 +16,7 @@
 namespace YSE {
   const UInt STANDARD_BUFFERSIZE = 128;
   const UInt STREAM_BUFFERSIZE = 44100;
+  const UInt CONTROL_BLOCKSIZE = 32; // frames per value for modulation at control rate
   extern UInt SAMPLERATE; // this used to be a constant. It is now declared in devicemanager
 }
   
@@ -26,6 +26,7 @@ namespace YSE {
     CT_61,
     CT_71,
     CT_CUSTOM, // custom type, you need to set speaker positions yourself if you choose this
+    CT_BINAURAL, // headphone output. Sounds are rendered with the hrtf set loaded with System().loadHRTF()
   };
 
   enum REVERB_PRESET {
@@ -54,6 +55,11 @@ namespace YSE {
     REVERB_UNDERWATER,
   };
 
+  enum REVERB_ENGINE {
+    RE_FREEVERB, // a set of comb and allpass filters for every output
+    RE_FDN, // a feedback delay network, shared by all outputs
+  };
+
   enum SOUND_STATUS {
     SS_STOPPED,
     SS_PAUSED,
@@ -187,6 +193,42 @@ namespace YSE {
     BQ_HIGHSHELF,
   };
 
+  // used by stft
+  enum WINDOW_TYPE {
+    WT_RECTANGLE,
+    WT_HANN,
+    WT_HAMMING,
+    WT_BLACKMAN,
+  };
+
+  // used by oscillatorBank and blepOscillator
+  enum OSCILLATOR_SHAPE {
+    OS_SINE,
+    OS_SAW,
+    OS_SQUARE,
+    OS_TRIANGLE,
+  };
+
+  // accuracy of the DSP math objects
+  enum MATH_ACCURACY {
+    MA_EXACT, // standard library
+    MA_HIGH,  // polynomial, error around 1e-5
+    MA_FAST,  // polynomial, error around 1e-3
+  };
+
+  // window used to fade a grain in and out
+  enum GRAIN_WINDOW {
+    GW_HANN,     // smooth fade in and out
+    GW_TUKEY,    // full volume in the middle, short fades
+    GW_GAUSSIAN, // narrow, for softer textures
+  };
+
+  // how a sound changes tempo and pitch independently
+  enum STRETCH_MODE {
+    SM_WSOLA,   // overlap-add of similar segments, for speech and transients
+    SM_VOCODER, // phase vocoder, for tonal material
+  };
+
   namespace MIDI { // don't let these clutter up the interface
     enum M_PITCH {
       CM1, // 0   -- C minus 1
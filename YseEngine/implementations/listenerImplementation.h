@@ -34,6 +34,7 @@ namespace YSE {
       aPos vel;
 
       friend class SOUND::implementationObject;
+      friend class SOUND::spatialBatch;
       friend class channelImplementation;
       friend class underWaterEffect;
       friend class YSE::listener;
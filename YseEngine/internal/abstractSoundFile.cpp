@@ -19,6 +19,7 @@ YSE::INTERNAL::abstractSoundFile::abstractSoundFile(bool interleaved)
   , state(NEW)
   , _sampleRateAdjustment(1.f)
   , _channels(0)
+  , _streaming(false)
   , idleTime(0)
 {
 }
@@ -118,11 +119,11 @@ Bool YSE::INTERNAL::abstractSoundFile::readNonInterleaved(abstractSoundFile * fi
     const Flt * in;
     
     if (file->_audioBuffer) {
-      in = file->_audioBuffer->getPtr();
+      in = file->_audioBuffer->getConstPtr();
       file->_length = file->_audioBuffer->getLength();
     }
     else if (file->_multiChannelBuffer) {
-      in = file->_multiChannelBuffer->at(i).getPtr();
+      in = file->_multiChannelBuffer->at(i).getConstPtr();
       file->_length = file->_multiChannelBuffer->at(i).getLength();
     }
     else  {
@@ -386,7 +387,7 @@ Bool YSE::INTERNAL::abstractSoundFile::readInterleaved(abstractSoundFile * file,
     const Flt * in;
 
     if (file->_audioBuffer) {
-      in = file->_audioBuffer->getPtr();
+      in = file->_audioBuffer->getConstPtr();
       file->_length = file->_audioBuffer->getLength();
     }
     else {
@@ -579,6 +580,49 @@ YSE::INTERNAL::FILESTATE YSE::INTERNAL::abstractSoundFile::getState() {
   return state;
 }
 
+Bool YSE::INTERNAL::abstractSoundFile::getChannel(UInt channel, std::vector<Flt> & result) {
+  if (state != READY || _streaming) return false;
+
+  const Flt * in = nullptr;
+  UInt stride = 1;
+  UInt length = _length;
+  if (_audioBuffer) {
+    if (channel > 0) return false;
+    in = _audioBuffer->getConstPtr();
+    length = _audioBuffer->getLength();
+  }
+  else if (_multiChannelBuffer) {
+    if (channel >= _multiChannelBuffer->size()) return false;
+    in = _multiChannelBuffer->at(channel).getConstPtr();
+    length = _multiChannelBuffer->at(channel).getLength();
+  }
+  else {
+    if ((Int)channel >= _channels) return false;
+    if (useInterleavedBuffer) {
+      in = _iBuffer + channel;
+      stride = _channels;
+    }
+    else {
+      in = _buffer[channel];
+    }
+  }
+
+  // resample with linear interpolation
+  result.resize(static_cast<UInt>(length / _sampleRateAdjustment));
+  for (UInt i = 0; i < result.size(); i++) {
+    Flt pos = i * _sampleRateAdjustment;
+    UInt index = static_cast<UInt>(pos);
+    if (index >= length) {
+      result.resize(i);
+      break;
+    }
+    Flt fraction = pos - index;
+    Flt next = index + 1 < length ? in[(index + 1) * stride] : 0.f;
+    result[i] = in[index * stride] * (1 - fraction) + next * fraction;
+  }
+  return true;
+}
+
 YSE::INTERNAL::abstractSoundFile & YSE::INTERNAL::abstractSoundFile::reset() {
   _needsReset = true;
   return *this;
@@ -59,6 +59,12 @@ namespace YSE {
       UInt      length  (); // length of the source in frames
       FILESTATE getState(); // current state of the file, (ready, invalid or loading)
 
+      /** Copy one channel of a file which is fully loaded in memory, converted
+          to the current sample rate. Returns false if the file is not ready, is
+          streaming or doesn't have this channel.
+      */
+      Bool getChannel(UInt channel, std::vector<Flt> & result);
+
       // set
       abstractSoundFile & reset(); // indicate that stream needs to reset (after stop)
 
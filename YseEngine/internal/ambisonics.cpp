@@ -0,0 +1,264 @@
+/*
+  ==============================================================================
+
+    ambisonics.cpp
+    Created: 16 Oct 2026 4:47:12pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include "../internalHeaders.h"
+
+namespace {
+  // the order of every ACN channel
+  const UInt channelOrder[YSE::INTERNAL::AMBISONICS_MAX_CHANNELS] = {
+    0, 1, 1, 1, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3
+  };
+
+  // the volume of every channel is interpolated when it changes
+  inline void mixGain(Flt * out, const Flt * in, UInt length, Flt start, Flt end) {
+    if (start == end) {
+      UInt l = length;
+      for (; l > 7; l -= 8, out += 8, in += 8) {
+        out[0] += in[0] * end; out[1] += in[1] * end;
+        out[2] += in[2] * end; out[3] += in[3] * end;
+        out[4] += in[4] * end; out[5] += in[5] * end;
+        out[6] += in[6] * end; out[7] += in[7] * end;
+      }
+      while (l--) *out++ += *in++ * end;
+    }
+    else {
+      Flt step = (end - start) / length;
+      Flt gain = start;
+      for (UInt i = 0; i < length; i++) {
+        out[i] += in[i] * gain;
+        gain += step;
+      }
+    }
+  }
+}
+
+void YSE::INTERNAL::sphericalHarmonics(UInt order, Flt angle, Flt elevation, Flt * result) {
+  // the usual ambisonic coordinates: x to the front, y to the left, z up
+  Flt x = cos(elevation) * cos(angle);
+  Flt y = -cos(elevation) * sin(angle);
+  Flt z = sin(elevation);
+
+  result[0] = 1.f;
+  if (order < 1) return;
+
+  result[1] = 1.7320508f * y;
+  result[2] = 1.7320508f * z;
+  result[3] = 1.7320508f * x;
+  if (order < 2) return;
+
+  result[4] = 3.8729833f * x * y;
+  result[5] = 3.8729833f * y * z;
+  result[6] = 1.1180340f * (3.f * z * z - 1.f);
+  result[7] = 3.8729833f * x * z;
+  result[8] = 1.9364917f * (x * x - y * y);
+  if (order < 3) return;
+
+  result[9] = 2.0916500f * y * (3.f * x * x - y * y);
+  result[10] = 10.246951f * x * y * z;
+  result[11] = 1.6201852f * y * (5.f * z * z - 1.f);
+  result[12] = 1.3228757f * z * (5.f * z * z - 3.f);
+  result[13] = 1.6201852f * x * (5.f * z * z - 1.f);
+  result[14] = 5.1234754f * z * (x * x - y * y);
+  result[15] = 2.0916500f * x * (x * x - 3.f * y * y);
+}
+
+/******************************************************************
+** ambisonicBus
+*******************************************************************/
+
+YSE::INTERNAL::ambisonicBus::ambisonicBus()
+  : order(0)
+  , numChannels(0)
+  , used(false)
+  , yaw(0)
+  , decodedYaw(0)
+  , dirty(true)
+  , normalize(1.f)
+  , binaural(false)
+  , silentBlocks(0) {
+  weights[0] = 1.f;
+
+  // virtual speakers on the vertices of an icosahedron, the most regular
+  // layout with enough speakers for third order
+  const Flt g = 1.618034f;
+  const Flt v[12][3] = {
+    { 0,  1,  g }, { 0,  1, -g }, { 0, -1,  g }, { 0, -1, -g },
+    { 1,  g,  0 }, { 1, -g,  0 }, { -1,  g,  0 }, { -1, -g,  0 },
+    { g,  0,  1 }, { g,  0, -1 }, { -g,  0,  1 }, { -g,  0, -1 },
+  };
+  for (UInt i = 0; i < 12; i++) {
+    Flt length = sqrt(v[i][0] * v[i][0] + v[i][1] * v[i][1] + v[i][2] * v[i][2]);
+    virtualAngles.push_back(atan2(v[i][0], v[i][2]));
+    virtualElevations.push_back(asin(v[i][1] / length));
+  }
+  virtualVoices.resize(virtualAngles.size());
+}
+
+void YSE::INTERNAL::ambisonicBus::setOrder(UInt order) {
+  if (order > AMBISONICS_MAX_ORDER) order = AMBISONICS_MAX_ORDER;
+  this->order = order;
+  numChannels = (order + 1) * (order + 1);
+
+  bus.resize(numChannels);
+  for (UInt i = 0; i < numChannels; i++) {
+    bus[i] = 0.f;
+  }
+  used = false;
+  dirty = true;
+}
+
+void YSE::INTERNAL::ambisonicBus::calculateWeights(UInt speakers, Bool horizontal) {
+  // a layout can't reproduce more detail than its number of speakers allows,
+  // so higher orders are left out of the decoder
+  UInt decodeOrder = horizontal ? (speakers - 1) / 2 : AMBISONICS_MAX_ORDER;
+  if (decodeOrder > order) decodeOrder = order;
+  if (decodeOrder < 1) decodeOrder = 1;
+
+  // max-rE weights reduce the side lobes of the decoded sound field
+  Flt x = cos(137.9f * ToRadians / (decodeOrder + 1.51f));
+  weights[1] = x;
+  weights[2] = (3.f * x * x - 1.f) * 0.5f;
+  weights[3] = (5.f * x * x * x - 3.f * x) * 0.5f;
+  for (UInt i = decodeOrder + 1; i <= AMBISONICS_MAX_ORDER; i++) {
+    weights[i] = 0.f;
+  }
+}
+
+void YSE::INTERNAL::ambisonicBus::setLayout(const std::vector<Flt> & angles) {
+  speakerAngles = angles;
+  speakerElevations.assign(angles.size(), 0.f);
+  dirty = true;
+}
+
+void YSE::INTERNAL::ambisonicBus::begin(Flt listenerAngle) {
+  yaw = listenerAngle;
+  if (!used) return;
+  for (UInt i = 0; i < numChannels; i++) {
+    bus[i] = 0.f;
+  }
+  used = false;
+}
+
+void YSE::INTERNAL::ambisonicBus::calculateDecoder(const std::vector<Flt> & angles, const std::vector<Flt> & elevations, std::vector<Flt> & result) {
+  Flt sh[AMBISONICS_MAX_CHANNELS];
+  result.resize(angles.size() * AMBISONICS_MAX_CHANNELS);
+  for (UInt j = 0; j < angles.size(); j++) {
+    // the sound field is rotated by evaluating the speaker directions in world orientation
+    sphericalHarmonics(order, angles[j] + yaw, elevations[j], sh);
+    Flt * d = result.data() + j * AMBISONICS_MAX_CHANNELS;
+    for (UInt k = 0; k < numChannels; k++) {
+      d[k] = sh[k] * weights[channelOrder[k]] * normalize;
+    }
+  }
+}
+
+void YSE::INTERNAL::ambisonicBus::normalizeDecoder(const std::vector<Flt> & angles, const std::vector<Flt> & elevations) {
+  // scale the decoder so that a source in the horizontal plane has unit power on average
+  Flt sh[AMBISONICS_MAX_CHANNELS];
+  Flt source[AMBISONICS_MAX_CHANNELS];
+  Flt power = 0;
+  for (UInt a = 0; a < 72; a++) {
+    sphericalHarmonics(order, Pi2 * a / 72, 0, source);
+    for (UInt j = 0; j < angles.size(); j++) {
+      sphericalHarmonics(order, angles[j], elevations[j], sh);
+      Flt gain = 0;
+      for (UInt k = 0; k < numChannels; k++) {
+        gain += sh[k] * weights[channelOrder[k]] * source[k];
+      }
+      power += gain * gain;
+    }
+  }
+  power /= 72;
+  normalize = power > 0 ? 1.f / sqrt(power) : 1.f;
+}
+
+void YSE::INTERNAL::ambisonicBus::updateDecoder(const std::vector<Flt> & angles, const std::vector<Flt> & elevations) {
+  if (dirty) {
+    calculateWeights(angles.size(), !binaural);
+    normalizeDecoder(angles, elevations);
+    calculateDecoder(angles, elevations, decoder);
+    lastDecoder = decoder;
+    decodedYaw = yaw;
+    dirty = false;
+  }
+  else if (yaw != decodedYaw) {
+    calculateDecoder(angles, elevations, decoder);
+    decodedYaw = yaw;
+  }
+}
+
+void YSE::INTERNAL::ambisonicBus::mixOutput(UInt speaker, DSP::buffer & result, Bool add) {
+  if (!add) result = 0.f;
+  const Flt * start = lastDecoder.data() + speaker * AMBISONICS_MAX_CHANNELS;
+  const Flt * end = decoder.data() + speaker * AMBISONICS_MAX_CHANNELS;
+  for (UInt k = 0; k < numChannels; k++) {
+    if (start[k] == 0 && end[k] == 0) continue;
+    mixGain(result.getPtr(), bus[k].getConstPtr(), result.getLength(), start[k], end[k]);
+  }
+}
+
+void YSE::INTERNAL::ambisonicBus::decode(std::vector<DSP::buffer> & out) {
+  if (!used) return;
+  if (binaural) {
+    binaural = false;
+    dirty = true;
+  }
+
+  updateDecoder(speakerAngles, speakerElevations);
+  for (UInt j = 0; j < speakerAngles.size() && j < out.size(); j++) {
+    mixOutput(j, out[j], true);
+  }
+  lastDecoder = decoder;
+}
+
+void YSE::INTERNAL::ambisonicBus::decode(hrtfSet * set, hrtfMix & mix) {
+  if (set == nullptr) return;
+  // keep decoding until the hrtf convolution has faded out
+  if (used) silentBlocks = 0;
+  else if (silentBlocks > set->partitions()) return;
+  else silentBlocks++;
+
+  if (!binaural) {
+    binaural = true;
+    dirty = true;
+  }
+
+  updateDecoder(virtualAngles, virtualElevations);
+  for (UInt j = 0; j < virtualAngles.size(); j++) {
+    mixOutput(j, virtualBuffer, false);
+    virtualVoices[j].process(set, virtualBuffer, virtualAngles[j], virtualElevations[j], mix);
+  }
+  lastDecoder = decoder;
+}
+
+/******************************************************************
+** ambisonicVoice
+*******************************************************************/
+
+void YSE::INTERNAL::ambisonicVoice::process(ambisonicBus & bus, DSP::buffer & input, UInt source, Flt angle, Flt elevation, Flt gain) {
+  if (lastGains.size() < (source + 1) * AMBISONICS_MAX_CHANNELS) {
+    lastGains.resize((source + 1) * AMBISONICS_MAX_CHANNELS, 0.f);
+  }
+
+  Flt sh[AMBISONICS_MAX_CHANNELS];
+  sphericalHarmonics(bus.order, angle, elevation, sh);
+
+  Flt * last = lastGains.data() + source * AMBISONICS_MAX_CHANNELS;
+  for (UInt k = 0; k < bus.numChannels; k++) {
+    Flt target = sh[k] * gain;
+    // very small changes are ignored, so that a sound which doesn't move
+    // is mixed without interpolation
+    if (fabs(target - last[k]) < 0.0001f) target = last[k];
+    if (target == 0 && last[k] == 0) continue;
+    mixGain(bus.bus[k].getPtr(), input.getConstPtr(), input.getLength(), last[k], target);
+    last[k] = target;
+  }
+  bus.used = true;
+}
@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    ambisonics.h
+    Created: 16 Oct 2026 4:47:12pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef AMBISONICS_H_INCLUDED
+#define AMBISONICS_H_INCLUDED
+
+#include <vector>
+#include "../headers/types.hpp"
+#include "../dsp/buffer.hpp"
+#include "hrtf.h"
+
+namespace YSE {
+  namespace INTERNAL {
+
+    const UInt AMBISONICS_MAX_ORDER = 3;
+    const UInt AMBISONICS_MAX_CHANNELS = (AMBISONICS_MAX_ORDER + 1) * (AMBISONICS_MAX_ORDER + 1);
+
+    /** Real spherical harmonics in ACN order with N3D normalization. Angles use
+        the same convention as sounds and speakers: 0 is in front, positive
+        angles are to the right and positive elevation is up.
+
+        @param result   must have room for (order + 1)^2 values
+    */
+    void sphericalHarmonics(UInt order, Flt angle, Flt elevation, Flt * result);
+
+    /**
+      An ambisonic bus mixes all sounds of a channel into (order + 1)^2 signals,
+      independent of the number of speakers. The bus is decoded to the speaker
+      layout, or to virtual speakers for binaural output, once per block.
+
+      Sounds are encoded in world orientation. The rotation of the listener is
+      applied to the decoder matrix, so sounds that don't move keep the same
+      encoding gains when the listener turns.
+    */
+    class ambisonicBus {
+    public:
+      ambisonicBus();
+
+      /** Set the ambisonic order. 0 disables the bus.
+      */
+      void setOrder(UInt order);
+      UInt getOrder() const { return order; }
+      UInt channels() const { return numChannels; }
+      Bool active() const { return order > 0; }
+
+      /** Set the direction of the outputs to decode to. Outputs beyond the
+          number of angles (like an LFE channel) receive nothing.
+      */
+      void setLayout(const std::vector<Flt> & angles);
+
+      /** Clear the bus before sounds are encoded.
+          @param listenerAngle  the orientation of the listener for this block
+      */
+      void begin(Flt listenerAngle);
+
+      /** The angle that must be added to a sound's angle relative to the
+          listener to get its world orientation.
+      */
+      Flt rotation() const { return yaw; }
+
+      /** Decode to the speaker layout and add the result to the outputs.
+      */
+      void decode(std::vector<DSP::buffer> & out);
+
+      /** Decode to virtual speakers, which are convolved with the hrtf set
+          and added to the binaural mix.
+      */
+      void decode(hrtfSet * set, hrtfMix & mix);
+
+    private:
+      void calculateWeights(UInt speakers, Bool horizontal);
+      void calculateDecoder(const std::vector<Flt> & angles, const std::vector<Flt> & elevations, std::vector<Flt> & result);
+      void normalizeDecoder(const std::vector<Flt> & angles, const std::vector<Flt> & elevations);
+      void updateDecoder(const std::vector<Flt> & angles, const std::vector<Flt> & elevations);
+      void mixOutput(UInt speaker, DSP::buffer & result, Bool add);
+
+      UInt order;
+      UInt numChannels;
+      std::vector<DSP::buffer> bus;
+      Bool used;
+
+      // max-rE weight for every order
+      Flt weights[AMBISONICS_MAX_ORDER + 1];
+
+      Flt yaw;
+      Flt decodedYaw;
+      Bool dirty;
+      Flt normalize;
+
+      // speaker directions
+      std::vector<Flt> speakerAngles, speakerElevations;
+
+      // virtual speakers for binaural output
+      std::vector<Flt> virtualAngles, virtualElevations;
+      std::vector<hrtfVoice> virtualVoices;
+      DSP::buffer virtualBuffer;
+      Bool binaural;
+      UInt silentBlocks;
+
+      // decoder matrices, speakers x AMBISONICS_MAX_CHANNELS. The previous matrix
+      // is kept to interpolate changes over a block.
+      std::vector<Flt> decoder, lastDecoder;
+
+      friend class ambisonicVoice;
+    };
+
+    /**
+      The encoding state of a single sound. Gains are kept for every source
+      channel so that changes can be interpolated.
+    */
+    class ambisonicVoice {
+    public:
+      /** Encode one source channel and add it to the bus.
+      */
+      void process(ambisonicBus & bus, DSP::buffer & input, UInt source, Flt angle, Flt elevation, Flt gain);
+
+    private:
+      std::vector<Flt> lastGains;
+    };
+
+  }
+}
+
+
+
+#endif  // AMBISONICS_H_INCLUDED
@@ -0,0 +1,355 @@
+/*
+  ==============================================================================
+
+    convolution.cpp
+    Created: 16 Oct 2026 8:12:40pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include "../internalHeaders.h"
+#include <string.h>
+#include <thread>
+#include <algorithm>
+
+namespace {
+  // complex multiply and add for one partition
+  inline void multiplyAdd(Flt * outR, Flt * outI, const Flt * xr, const Flt * xi, const Flt * hr, const Flt * hi, UInt bins) {
+    for (UInt k = 0; k < bins; k++) {
+      outR[k] += xr[k] * hr[k] - xi[k] * hi[k];
+      outI[k] += xr[k] * hi[k] + xi[k] * hr[k];
+    }
+  }
+}
+
+/******************************************************************
+** impulseResponse
+*******************************************************************/
+
+YSE::INTERNAL::impulseResponse::impulseResponse(const std::string & fileName)
+  : fileName(fileName)
+  , sampleRate(SAMPLERATE)
+  , state(NEW)
+  , numChannels(0)
+  , numSamples(0)
+  , numHeadPartitions(0)
+  , numTailPartitions(0) {
+}
+
+Bool YSE::INTERNAL::impulseResponse::contains(const std::string & fileName) const {
+  return this->fileName == fileName && sampleRate == SAMPLERATE;
+}
+
+void YSE::INTERNAL::impulseResponse::run() {
+  state = LOADING;
+
+  // the file is read right away, because this already runs on the slow thread
+  soundFile file(fileName);
+  file.loadNonStreaming();
+  if (file.getState() != READY || file.channels() < 1) {
+    LogImpl().emit(E_FILE_ERROR, "impulse response not loaded: " + fileName);
+    state = INVALID;
+    return;
+  }
+
+  numChannels = file.channels();
+  std::vector<std::vector<Flt>> ir(numChannels);
+  UInt length = 0;
+  for (UInt c = 0; c < numChannels; c++) {
+    file.getChannel(c, ir[c]);
+    if (ir[c].size() > length) length = ir[c].size();
+  }
+  numSamples = length;
+
+  numHeadPartitions = (length + CONVOLUTION_HEAD_SIZE - 1) / CONVOLUTION_HEAD_SIZE;
+  if (numHeadPartitions > CONVOLUTION_HEAD_PARTITIONS) numHeadPartitions = CONVOLUTION_HEAD_PARTITIONS;
+  if (numHeadPartitions == 0) numHeadPartitions = 1;
+
+  UInt tailStart = CONVOLUTION_HEAD_PARTITIONS * CONVOLUTION_HEAD_SIZE;
+  numTailPartitions = length > tailStart ? (length - tailStart + CONVOLUTION_TAIL_SIZE - 1) / CONVOLUTION_TAIL_SIZE : 0;
+
+  headSpectraReal.assign(numChannels * numHeadPartitions * CONVOLUTION_HEAD_BINS, 0.f);
+  headSpectraImaginary.assign(numChannels * numHeadPartitions * CONVOLUTION_HEAD_BINS, 0.f);
+  tailSpectraReal.assign(numChannels * numTailPartitions * CONVOLUTION_TAIL_BINS, 0.f);
+  tailSpectraImaginary.assign(numChannels * numTailPartitions * CONVOLUTION_TAIL_BINS, 0.f);
+
+  for (UInt c = 0; c < numChannels; c++) {
+    partition(ir[c], 0, CONVOLUTION_HEAD_SIZE, numHeadPartitions,
+      headSpectraReal.data() + c * numHeadPartitions * CONVOLUTION_HEAD_BINS,
+      headSpectraImaginary.data() + c * numHeadPartitions * CONVOLUTION_HEAD_BINS);
+    partition(ir[c], tailStart, CONVOLUTION_TAIL_SIZE, numTailPartitions,
+      tailSpectraReal.data() + c * numTailPartitions * CONVOLUTION_TAIL_BINS,
+      tailSpectraImaginary.data() + c * numTailPartitions * CONVOLUTION_TAIL_BINS);
+  }
+
+  state = READY;
+}
+
+void YSE::INTERNAL::impulseResponse::partition(const std::vector<Flt> & ir, UInt start, UInt size, UInt count, Flt * real, Flt * imaginary) {
+  // every partition is zero padded to twice its size. The inverse fft
+  // is not normalized, so the scale is applied here.
+  DSP::buffer segment(size * 2);
+  DSP::realFft fft;
+  const Flt scale = 1.f / (size * 2);
+  for (UInt p = 0; p < count; p++) {
+    segment = 0.f;
+    Flt * ptr = segment.getPtr();
+    for (UInt i = 0; i < size; i++) {
+      UInt index = start + p * size + i;
+      if (index >= ir.size()) break;
+      ptr[i] = ir[index] * scale;
+    }
+    fft(segment);
+    memcpy(real + p * (size + 1), fft.getReal().getConstPtr(), (size + 1) * sizeof(Flt));
+    memcpy(imaginary + p * (size + 1), fft.getImaginary().getConstPtr(), (size + 1) * sizeof(Flt));
+  }
+}
+
+const Flt * YSE::INTERNAL::impulseResponse::headReal(UInt channel, UInt partition) const {
+  return headSpectraReal.data() + (channel * numHeadPartitions + partition) * CONVOLUTION_HEAD_BINS;
+}
+
+const Flt * YSE::INTERNAL::impulseResponse::headImaginary(UInt channel, UInt partition) const {
+  return headSpectraImaginary.data() + (channel * numHeadPartitions + partition) * CONVOLUTION_HEAD_BINS;
+}
+
+const Flt * YSE::INTERNAL::impulseResponse::tailReal(UInt channel, UInt partition) const {
+  return tailSpectraReal.data() + (channel * numTailPartitions + partition) * CONVOLUTION_TAIL_BINS;
+}
+
+const Flt * YSE::INTERNAL::impulseResponse::tailImaginary(UInt channel, UInt partition) const {
+  return tailSpectraImaginary.data() + (channel * numTailPartitions + partition) * CONVOLUTION_TAIL_BINS;
+}
+
+/******************************************************************
+** impulseResponseManager
+*******************************************************************/
+
+YSE::INTERNAL::impulseResponseManager & YSE::INTERNAL::ImpulseResponses() {
+  static impulseResponseManager m;
+  return m;
+}
+
+YSE::INTERNAL::impulseResponse * YSE::INTERNAL::impulseResponseManager::get(const std::string & fileName) {
+  for (auto i = responses.begin(); i != responses.end(); ++i) {
+    // try again if the file could not be loaded before
+    if (i->contains(fileName) && i->getState() != INVALID) return &(*i);
+  }
+
+  responses.emplace_front(fileName);
+  Global().addSlowJob(&responses.front());
+  return &responses.front();
+}
+
+/******************************************************************
+** convolver
+*******************************************************************/
+
+YSE::INTERNAL::convolver::convolver()
+  : response(nullptr)
+  , numChannels(0)
+  , headSlot(0)
+  , tailSlot(0)
+  , tailPhase(0)
+  , job(this)
+  , tailClaimed(true)
+  , tailReady(false)
+  , tailPending(false) {
+}
+
+YSE::INTERNAL::convolver::~convolver() {
+  finishTail();
+}
+
+void YSE::INTERNAL::convolver::prepare(impulseResponse * response, UInt channels) {
+  finishTail();
+  this->response = response;
+  numChannels = channels;
+
+  UInt headLength = channels * response->headPartitions() * CONVOLUTION_HEAD_BINS;
+  headInputReal.assign(headLength, 0.f);
+  headInputImaginary.assign(headLength, 0.f);
+  headFrames.resize(channels);
+  for (UInt c = 0; c < channels; c++) {
+    headFrames[c].resize(CONVOLUTION_HEAD_SIZE * 2);
+    headFrames[c] = 0.f;
+  }
+  headReal.resize(CONVOLUTION_HEAD_SIZE * 2);
+  headImaginary.resize(CONVOLUTION_HEAD_SIZE * 2);
+  headResult.resize(CONVOLUTION_HEAD_SIZE);
+  headSlot = 0;
+
+  UInt tailLength = channels * response->tailPartitions() * CONVOLUTION_TAIL_BINS;
+  tailInputReal.assign(tailLength, 0.f);
+  tailInputImaginary.assign(tailLength, 0.f);
+  tailInput.resize(channels);
+  tailFrames.resize(channels);
+  tailResult.resize(channels);
+  tailOutput.resize(channels);
+  for (UInt c = 0; c < channels; c++) {
+    tailInput[c].resize(CONVOLUTION_TAIL_SIZE);
+    tailInput[c] = 0.f;
+    tailFrames[c].resize(CONVOLUTION_TAIL_SIZE * 2);
+    tailFrames[c] = 0.f;
+    tailResult[c].resize(CONVOLUTION_TAIL_SIZE);
+    tailResult[c] = 0.f;
+    tailOutput[c].resize(CONVOLUTION_TAIL_SIZE);
+    tailOutput[c] = 0.f;
+  }
+  tailReal.resize(CONVOLUTION_TAIL_SIZE * 2);
+  tailImaginary.resize(CONVOLUTION_TAIL_SIZE * 2);
+  tailSlot = 0;
+  tailPhase = 0;
+}
+
+UInt YSE::INTERNAL::convolver::tail() const {
+  if (response == nullptr) return 0;
+  return response->length() + CONVOLUTION_TAIL_SIZE;
+}
+
+void YSE::INTERNAL::convolver::clear() {
+  if (response == nullptr) return;
+  finishTail();
+
+  std::fill(headInputReal.begin(), headInputReal.end(), 0.f);
+  std::fill(headInputImaginary.begin(), headInputImaginary.end(), 0.f);
+  std::fill(tailInputReal.begin(), tailInputReal.end(), 0.f);
+  std::fill(tailInputImaginary.begin(), tailInputImaginary.end(), 0.f);
+  for (UInt c = 0; c < numChannels; c++) {
+    headFrames[c] = 0.f;
+    tailInput[c] = 0.f;
+    tailFrames[c] = 0.f;
+    tailResult[c] = 0.f;
+    tailOutput[c] = 0.f;
+  }
+  headSlot = 0;
+  tailSlot = 0;
+  tailPhase = 0;
+}
+
+void YSE::INTERNAL::convolver::process(MULTICHANNELBUFFER & buffer, Flt wet, Flt dry) {
+  if (response == nullptr) return;
+
+  // the newest input spectrum moves to the next slot, so that older
+  // spectra line up with later partitions
+  UInt partitions = response->headPartitions();
+  headSlot = (headSlot + partitions - 1) % partitions;
+
+  UInt channels = buffer.size() < numChannels ? buffer.size() : numChannels;
+  for (UInt c = 0; c < channels; c++) {
+    DSP::buffer & input = buffer[c];
+    tailInput[c].copyFrom(input, 0, tailPhase * CONVOLUTION_HEAD_SIZE, CONVOLUTION_HEAD_SIZE);
+    head(c, input, headResult);
+
+    Flt * out = input.getPtr();
+    const Flt * h = headResult.getConstPtr();
+    const Flt * t = tailOutput[c].getConstPtr() + tailPhase * CONVOLUTION_HEAD_SIZE;
+    for (UInt i = 0; i < CONVOLUTION_HEAD_SIZE; i++) {
+      out[i] = out[i] * dry + (h[i] + t[i]) * wet;
+    }
+  }
+
+  // a full tail block of input is collected
+  if (++tailPhase * CONVOLUTION_HEAD_SIZE == CONVOLUTION_TAIL_SIZE) {
+    tailPhase = 0;
+    finishTail();
+    startTail();
+  }
+}
+
+void YSE::INTERNAL::convolver::head(UInt channel, DSP::buffer & input, DSP::buffer & result) {
+  // overlap-save: the frame holds the previous and the current block
+  Flt * f = headFrames[channel].getPtr();
+  memmove(f, f + CONVOLUTION_HEAD_SIZE, CONVOLUTION_HEAD_SIZE * sizeof(Flt));
+  memcpy(f + CONVOLUTION_HEAD_SIZE, input.getConstPtr(), CONVOLUTION_HEAD_SIZE * sizeof(Flt));
+
+  UInt partitions = response->headPartitions();
+  Flt * inputReal = headInputReal.data() + channel * partitions * CONVOLUTION_HEAD_BINS;
+  Flt * inputImaginary = headInputImaginary.data() + channel * partitions * CONVOLUTION_HEAD_BINS;
+  headFft(headFrames[channel]);
+  memcpy(inputReal + headSlot * CONVOLUTION_HEAD_BINS, headFft.getReal().getConstPtr(), CONVOLUTION_HEAD_BINS * sizeof(Flt));
+  memcpy(inputImaginary + headSlot * CONVOLUTION_HEAD_BINS, headFft.getImaginary().getConstPtr(), CONVOLUTION_HEAD_BINS * sizeof(Flt));
+
+  headReal = 0.f;
+  headImaginary = 0.f;
+  UInt source = channel % response->channels();
+  for (UInt p = 0; p < partitions; p++) {
+    UInt slot = (headSlot + p) % partitions;
+    multiplyAdd(headReal.getPtr(), headImaginary.getPtr(),
+      inputReal + slot * CONVOLUTION_HEAD_BINS, inputImaginary + slot * CONVOLUTION_HEAD_BINS,
+      response->headReal(source, p), response->headImaginary(source, p), CONVOLUTION_HEAD_BINS);
+  }
+
+  // only the second half of the result is valid
+  DSP::buffer & r = headIfft(headReal, headImaginary);
+  result.copyFrom(r, CONVOLUTION_HEAD_SIZE, 0, CONVOLUTION_HEAD_SIZE);
+}
+
+Bool YSE::INTERNAL::convolver::claimTail() {
+  Bool expected = false;
+  return tailClaimed.compare_exchange_strong(expected, true);
+}
+
+void YSE::INTERNAL::convolver::startTail() {
+  for (UInt c = 0; c < numChannels; c++) {
+    Flt * f = tailFrames[c].getPtr();
+    memmove(f, f + CONVOLUTION_TAIL_SIZE, CONVOLUTION_TAIL_SIZE * sizeof(Flt));
+    memcpy(f + CONVOLUTION_TAIL_SIZE, tailInput[c].getConstPtr(), CONVOLUTION_TAIL_SIZE * sizeof(Flt));
+  }
+  if (response->tailPartitions() == 0) return;
+
+  tailReady = false;
+  tailPending = true;
+  tailClaimed = false;
+
+  // if the job is still queued because the audio thread took over the
+  // previous block, the queued job will pick up this one
+  if (!job.isQueued()) Global().addFastJob(&job);
+}
+
+void YSE::INTERNAL::convolver::runTail() {
+  UInt partitions = response->tailPartitions();
+  tailSlot = (tailSlot + partitions - 1) % partitions;
+
+  for (UInt c = 0; c < numChannels; c++) {
+    Flt * inputReal = tailInputReal.data() + c * partitions * CONVOLUTION_TAIL_BINS;
+    Flt * inputImaginary = tailInputImaginary.data() + c * partitions * CONVOLUTION_TAIL_BINS;
+    tailFft(tailFrames[c]);
+    memcpy(inputReal + tailSlot * CONVOLUTION_TAIL_BINS, tailFft.getReal().getConstPtr(), CONVOLUTION_TAIL_BINS * sizeof(Flt));
+    memcpy(inputImaginary + tailSlot * CONVOLUTION_TAIL_BINS, tailFft.getImaginary().getConstPtr(), CONVOLUTION_TAIL_BINS * sizeof(Flt));
+
+    tailReal = 0.f;
+    tailImaginary = 0.f;
+    UInt source = c % response->channels();
+    for (UInt p = 0; p < partitions; p++) {
+      UInt slot = (tailSlot + p) % partitions;
+      multiplyAdd(tailReal.getPtr(), tailImaginary.getPtr(),
+        inputReal + slot * CONVOLUTION_TAIL_BINS, inputImaginary + slot * CONVOLUTION_TAIL_BINS,
+        response->tailReal(source, p), response->tailImaginary(source, p), CONVOLUTION_TAIL_BINS);
+    }
+
+    DSP::buffer & r = tailIfft(tailReal, tailImaginary);
+    tailResult[c].copyFrom(r, CONVOLUTION_TAIL_SIZE, 0, CONVOLUTION_TAIL_SIZE);
+  }
+
+  tailReady = true;
+}
+
+void YSE::INTERNAL::convolver::finishTail() {
+  if (!tailPending) return;
+
+  // The result is due now. If no worker has started yet, the audio thread
+  // does the work itself instead of waiting for a worker to pick it up.
+  if (claimTail()) runTail();
+  else while (!tailReady) std::this_thread::yield();
+
+  tailPending = false;
+  for (UInt c = 0; c < numChannels; c++) {
+    tailOutput[c].swap(tailResult[c]);
+  }
+}
+
+void YSE::INTERNAL::convolver::tailJob::run() {
+  if (owner->claimTail()) owner->runTail();
+}
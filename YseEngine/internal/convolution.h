@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+    convolution.h
+    Created: 16 Oct 2026 8:12:40pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef CONVOLUTION_H_INCLUDED
+#define CONVOLUTION_H_INCLUDED
+
+#include <atomic>
+#include <forward_list>
+#include <string>
+#include <vector>
+#include "../headers/types.hpp"
+#include "../dsp/buffer.hpp"
+#include "../dsp/fourier/fft.hpp"
+#include "abstractSoundFile.h"
+#include "threadPool.h"
+
+namespace YSE {
+  namespace INTERNAL {
+
+    /* The impulse response is split in two parts. The head is convolved on the
+       audio thread with partitions of one block, which adds no latency. The tail
+       uses partitions of CONVOLUTION_TAIL_SIZE and is convolved on a worker thread.
+       A tail block is due one tail block after its input is complete, so the head
+       has to cover the first two tail blocks of the response.
+    */
+    const UInt CONVOLUTION_HEAD_SIZE = STANDARD_BUFFERSIZE;
+    const UInt CONVOLUTION_HEAD_BINS = CONVOLUTION_HEAD_SIZE + 1;
+    const UInt CONVOLUTION_TAIL_SIZE = STANDARD_BUFFERSIZE * 16;
+    const UInt CONVOLUTION_TAIL_BINS = CONVOLUTION_TAIL_SIZE + 1;
+    const UInt CONVOLUTION_HEAD_PARTITIONS = 2 * CONVOLUTION_TAIL_SIZE / CONVOLUTION_HEAD_SIZE;
+
+    /**
+      An impulse response, converted to partitioned spectra for the head and the
+      tail of the convolution. Responses are loaded on the slow thread pool with
+      the regular sound file reader.
+    */
+    class impulseResponse : public threadPoolJob {
+    public:
+      impulseResponse(const std::string & fileName);
+
+      virtual void run();
+
+      Bool contains(const std::string & fileName) const;
+      FILESTATE getState() const { return state; }
+
+      UInt channels() const { return numChannels; }
+      UInt length() const { return numSamples; } // in samples, at the current sample rate
+      UInt headPartitions() const { return numHeadPartitions; }
+      UInt tailPartitions() const { return numTailPartitions; }
+
+      const Flt * headReal(UInt channel, UInt partition) const;
+      const Flt * headImaginary(UInt channel, UInt partition) const;
+      const Flt * tailReal(UInt channel, UInt partition) const;
+      const Flt * tailImaginary(UInt channel, UInt partition) const;
+
+    private:
+      // convert a part of the response to the spectra of its partitions
+      void partition(const std::vector<Flt> & ir, UInt start, UInt size, UInt count, Flt * real, Flt * imaginary);
+
+      std::string fileName;
+      UInt sampleRate;
+      std::atomic<FILESTATE> state;
+
+      UInt numChannels;
+      UInt numSamples;
+      UInt numHeadPartitions;
+      UInt numTailPartitions;
+
+      // spectra, ordered by channel and partition
+      std::vector<Flt> headSpectraReal, headSpectraImaginary;
+      std::vector<Flt> tailSpectraReal, tailSpectraImaginary;
+    };
+
+    /**
+      Impulse responses stay in memory once loaded, so that loading the same file
+      again doesn't need any calculations. This is only used from the calling
+      thread.
+    */
+    class impulseResponseManager {
+    public:
+      impulseResponse * get(const std::string & fileName);
+
+    private:
+      std::forward_list<impulseResponse> responses;
+    };
+
+    impulseResponseManager & ImpulseResponses();
+
+    /**
+      Non uniformly partitioned convolution of a multichannel buffer with an
+      impulse response. Output channel c uses channel c of the response, or
+      wraps around when the response has less channels.
+    */
+    class convolver {
+    public:
+      convolver();
+      ~convolver();
+
+      /** Prepare for a new response. This allocates memory, but only when
+          the response or the number of channels changes.
+      */
+      void prepare(impulseResponse * response, UInt channels);
+      impulseResponse * current() const { return response; }
+      UInt channels() const { return numChannels; }
+
+      /** The longest time in samples that the output can be silent while the
+          convolution of earlier input is still to come: the length of the
+          response plus the latency of the tail partitions.
+      */
+      UInt tail() const;
+
+      /** Forget all earlier input, so that none of it is played back later.
+          This does not allocate.
+      */
+      void clear();
+
+      /** Convolve a block of CONVOLUTION_HEAD_SIZE samples and mix the result
+          with the input.
+      */
+      void process(MULTICHANNELBUFFER & buffer, Flt wet, Flt dry);
+
+    private:
+      class tailJob : public threadPoolJob {
+      public:
+        tailJob(convolver * owner) : owner(owner) {}
+        virtual void run();
+
+      private:
+        convolver * owner;
+      };
+
+      void head(UInt channel, DSP::buffer & input, DSP::buffer & result);
+
+      // the tail is calculated by whoever claims it first: a worker thread, or
+      // the audio thread when the result is due and no worker has started yet
+      Bool claimTail();
+      void runTail();
+      void finishTail();
+      void startTail();
+
+      impulseResponse * response;
+      UInt numChannels;
+
+      // head, processed on the audio thread
+      std::vector<DSP::buffer> headFrames;
+      std::vector<Flt> headInputReal, headInputImaginary;
+      UInt headSlot;
+      DSP::buffer headReal, headImaginary;
+      DSP::buffer headResult;
+      DSP::realFft headFft;
+      DSP::inverseRealFft headIfft;
+
+      // tail input is collected on the audio thread and handed to the job
+      // once a full tail block is available
+      std::vector<DSP::buffer> tailInput;
+      std::vector<DSP::buffer> tailFrames;
+      std::vector<Flt> tailInputReal, tailInputImaginary;
+      UInt tailSlot;
+      UInt tailPhase;
+      DSP::buffer tailReal, tailImaginary;
+      DSP::realFft tailFft;
+      DSP::inverseRealFft tailIfft;
+
+      // the job writes to tailResult, which is swapped with tailOutput when due
+      std::vector<DSP::buffer> tailResult;
+      std::vector<DSP::buffer> tailOutput;
+
+      tailJob job;
+      aBool tailClaimed;
+      aBool tailReady;
+      Bool tailPending;
+    };
+
+  }
+}
+
+
+
+#endif  // CONVOLUTION_H_INCLUDED
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    denormal.h
+    Created: 16 Oct 2026 7:21:48pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef DENORMAL_H_INCLUDED
+#define DENORMAL_H_INCLUDED
+
+#include <cmath>
+#include <limits>
+#include <stdint.h>
+#include "../headers/types.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define YSE_FTZ
+#elif defined(__aarch64__) || (defined(__arm__) && defined(__ARM_FP))
+#define YSE_FTZ
+#endif
+
+namespace YSE {
+  namespace INTERNAL {
+
+    /** From now on, denormals are flushed to zero by the cpu on the calling thread.
+        This is called by the audio callback and by every thread pool thread, so that
+        recursive filters don't slow down on decaying tails. Where the cpu can't do
+        this, flushDenormal() must be used on filter state.
+    */
+    inline void disableDenormals() {
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+      _mm_setcsr(_mm_getcsr() | 0x8040); // FTZ | DAZ
+#elif defined(__aarch64__)
+      uint64_t fpcr;
+      __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+      __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | (1 << 24))); // FZ
+#elif defined(__arm__) && defined(__ARM_FP)
+      uint32_t fpscr;
+      __asm__ __volatile__("vmrs %0, fpscr" : "=r"(fpscr));
+      __asm__ __volatile__("vmsr fpscr, %0" : : "r"(fpscr | (1 << 24))); // FZ
+#endif
+    }
+
+    inline Flt flushDenormal(Flt v) {
+#ifdef YSE_FTZ
+      return v;
+#else
+      return fabsf(v) < std::numeric_limits<float>::min() ? 0.f : v;
+#endif
+    }
+
+  }
+}
+
+
+
+#endif  // DENORMAL_H_INCLUDED
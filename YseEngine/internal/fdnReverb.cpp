@@ -0,0 +1,290 @@
+/*
+  ==============================================================================
+
+    fdnReverb.cpp
+    Created: 16 Oct 2026 7:03:25pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include "fdnReverb.h"
+#include "denormal.h"
+#include "../reverb/reverbInterface.hpp"
+#include "../utils/misc.hpp"
+
+// these match the scaling of the freeverb engine, so that presets sound alike
+#define scalewet    1.5f
+#define scaledry    2.0f
+#define scaledamp   0.4f
+
+// level of the network input and output, so that the wet level is close to
+// that of the freeverb engine
+#define inputgain   0.35f
+#define outputgain  0.7f
+
+// maximum modulation depth in samples
+#define maxdepth    32
+
+namespace {
+  // delay lengths in milliseconds. They are converted to the nearest prime number
+  // of samples, so that the lines have no common resonances.
+  const Flt lineTimes[FDN_LINES] = { 25.3f, 29.1f, 33.7f, 37.9f, 42.1f, 46.7f, 51.1f, 55.9f };
+
+  // sign of every line in the input and in the hadamard matrix
+  inline Flt hadamardSign(UInt row, UInt column) {
+    UInt v = row & column;
+    UInt bits = 0;
+    while (v) { bits += v & 1; v >>= 1; }
+    return (bits & 1) ? -1.f : 1.f;
+  }
+
+  inline Bool isPrime(UInt value) {
+    if (value < 2) return false;
+    for (UInt i = 2; i * i <= value; i++) {
+      if (value % i == 0) return false;
+    }
+    return true;
+  }
+
+  /* The roomsize is mapped to the decay time of the freeverb comb filters:
+     a feedback of roomsize * 0.28 + 0.7 with an average comb length of 31.7ms.
+  */
+  inline Flt decayTime(Flt roomsize) {
+    Flt feedback = roomsize * 0.28f + 0.7f;
+    if (feedback > 0.999f) feedback = 0.999f;
+    return 3.f * 0.0317f / -log10(feedback);
+  }
+
+  /* Orthogonal 8 point hadamard matrix as a fast walsh-hadamard transform.
+     It mixes every line into every other line without changing the energy.
+  */
+  inline void hadamard(Flt * v) {
+    Flt a0 = v[0] + v[1], a1 = v[0] - v[1], a2 = v[2] + v[3], a3 = v[2] - v[3];
+    Flt a4 = v[4] + v[5], a5 = v[4] - v[5], a6 = v[6] + v[7], a7 = v[6] - v[7];
+    Flt b0 = a0 + a2, b1 = a1 + a3, b2 = a0 - a2, b3 = a1 - a3;
+    Flt b4 = a4 + a6, b5 = a5 + a7, b6 = a4 - a6, b7 = a5 - a7;
+    const Flt scale = 0.35355339f; // 1 / sqrt(8)
+    v[0] = (b0 + b4) * scale; v[1] = (b1 + b5) * scale;
+    v[2] = (b2 + b6) * scale; v[3] = (b3 + b7) * scale;
+    v[4] = (b0 - b4) * scale; v[5] = (b1 - b5) * scale;
+    v[6] = (b2 - b6) * scale; v[7] = (b3 - b7) * scale;
+  }
+}
+
+YSE::INTERNAL::fdnReverb::fdnReverb()
+  : enabled(false)
+  , sampleRate(0)
+  , write(0)
+  , mask(0)
+  , damp(0)
+  , modPhase(0)
+  , early(3000) {
+  for (Int i = 0; i < FDN_LINES; i++) {
+    gain[i] = 0;
+    filterStore[i] = 0;
+    lastMod[i] = 0;
+  }
+  modFrequency.set(0, 0);
+  modWidth.set(0, 0);
+  init();
+}
+
+void YSE::INTERNAL::fdnReverb::init() {
+  sampleRate = SAMPLERATE;
+
+  // delay lengths depend on the sample rate
+  UInt longest = 0;
+  for (Int i = 0; i < FDN_LINES; i++) {
+    UInt samples = static_cast<UInt>(lineTimes[i] * 0.001f * sampleRate);
+    while (!isPrime(samples)) samples++;
+    length[i] = static_cast<Flt>(samples);
+    if (samples > longest) longest = samples;
+  }
+
+  UInt size = 1;
+  while (size <= longest + 2 * maxdepth + 2) size <<= 1;
+  mask = size - 1;
+  lines.assign(size * FDN_LINES, 0.f);
+  write = 0;
+  clear();
+}
+
+void YSE::INTERNAL::fdnReverb::clear() {
+  lines.assign(lines.size(), 0.f);
+  early.clear();
+  for (Int i = 0; i < FDN_LINES; i++) {
+    filterStore[i] = 0;
+  }
+}
+
+void YSE::INTERNAL::fdnReverb::channels(Int value) {
+  if (sampleRate != SAMPLERATE) init();
+  if ((Int)earlyOffset.size() != value) {
+    earlyOffset.resize(value);
+    for (Int i = 0; i < value; i++) {
+      earlyOffset[i] = Random(30);
+    }
+  }
+}
+
+void YSE::INTERNAL::fdnReverb::set(reverb & params) {
+  if (!params.getActive()) {
+    if (enabled) clear();
+    enabled = false;
+    return;
+  }
+
+  enabled = true;
+  roomsizeFader.setIfNew(params.getRoomSize(), 1000);
+  dampFader.setIfNew(params.getDamping() * scaledamp, 1000);
+  wetFader.setIfNew(params.getWet() * scalewet, 1000);
+  dryFader.setIfNew(params.getDry() * scaledry, 1000);
+  Flt frequency = params.getModulationFrequency();
+  if (frequency < 0) frequency = 0;
+  modFrequency.setIfNew(frequency, 1000);
+  modWidth.setIfNew(params.getModulationWidth(), 1000);
+
+  for (Int i = 0; i < 4; i++) {
+    earlyPtr[i].setIfNew((Flt)params.getReflectionTime(i), 1000);
+    earlyVolume[i].setIfNew(params.getReflectionGain(i), 1000);
+  }
+}
+
+void YSE::INTERNAL::fdnReverb::update() {
+  roomsizeFader.update();
+  dampFader.update();
+  wetFader.update();
+  dryFader.update();
+  modFrequency.update();
+  modWidth.update();
+  for (Int i = 0; i < 4; i++) {
+    earlyPtr[i].update();
+    earlyVolume[i].update();
+  }
+
+  // the gain of every line is set so that all lines decay 60dB in the same time
+  Flt rt60 = decayTime(roomsizeFader());
+  for (Int i = 0; i < FDN_LINES; i++) {
+    gain[i] = pow(10.f, -3.f * length[i] / (sampleRate * rt60));
+  }
+  damp = dampFader();
+}
+
+void YSE::INTERNAL::fdnReverb::process(MULTICHANNELBUFFER & buffer) {
+  if (!enabled) return;
+  if (buffer.empty()) return;
+  if (sampleRate != SAMPLERATE) init();
+  if (earlyOffset.size() < buffer.size()) channels(buffer.size());
+  update();
+
+  UInt blockLength = buffer[0].getLength();
+  if (send.getLength() != blockLength) {
+    send.resize(blockLength);
+    wetOut.resize(blockLength);
+    for (Int k = 0; k < FDN_LINES; k++) lineOut[k].resize(blockLength);
+  }
+
+  // mono send of all outputs, scaled to keep the power of uncorrelated outputs
+  send = buffer[0];
+  for (UInt c = 1; c < buffer.size(); c++) {
+    send += buffer[c];
+  }
+  send *= 1.f / sqrt((Flt)buffer.size());
+  early.process(send);
+
+  // modulation of the delay lengths, every line with its own phase
+  Flt depth = modWidth() * 0.25f;
+  Clamp(depth, 0.f, (Flt)maxdepth);
+  Flt mod[FDN_LINES];
+  modPhase += modFrequency() * blockLength / sampleRate;
+  modPhase -= (Int)modPhase;
+  for (Int k = 0; k < FDN_LINES; k++) {
+    mod[k] = depth > 0 ? (1 + sin(Pi2 * (modPhase + k / (Flt)FDN_LINES))) * depth : 0.f;
+  }
+
+  {
+    const Flt damp1 = damp;
+    const Flt damp2 = 1 - damp;
+    const Flt size = static_cast<Flt>(mask + 1);
+    const Flt step = 1.f / blockLength;
+    const Flt * in = send.getConstPtr();
+    Flt * out[FDN_LINES];
+    Flt delay[FDN_LINES];
+    Flt delayStep[FDN_LINES];
+    Flt sign[FDN_LINES];
+    Flt store[FDN_LINES];
+    for (Int k = 0; k < FDN_LINES; k++) {
+      out[k] = lineOut[k].getPtr();
+      delay[k] = length[k] + lastMod[k];
+      delayStep[k] = (mod[k] - lastMod[k]) * step;
+      sign[k] = hadamardSign(1, k) * inputgain;
+      store[k] = filterStore[k];
+    }
+    Flt * buf = lines.data();
+
+    for (UInt i = 0; i < blockLength; i++) {
+      // read all lines, with linear interpolation for modulated delays
+      Flt y[FDN_LINES];
+      for (Int k = 0; k < FDN_LINES; k++) {
+        Flt pos = write - delay[k] + size;
+        UInt index = static_cast<UInt>(pos);
+        Flt fraction = pos - index;
+        Flt a = buf[(index & mask) * FDN_LINES + k];
+        Flt b = buf[((index + 1) & mask) * FDN_LINES + k];
+        y[k] = a + (b - a) * fraction;
+        out[k][i] = y[k];
+        delay[k] += delayStep[k];
+      }
+
+      // damping and decay
+      for (Int k = 0; k < FDN_LINES; k++) {
+        store[k] = flushDenormal(y[k] * damp2 + store[k] * damp1);
+        y[k] = store[k] * gain[k];
+      }
+
+      hadamard(y);
+
+      Flt * w = buf + write * FDN_LINES;
+      const Flt input = in[i];
+      for (Int k = 0; k < FDN_LINES; k++) {
+        w[k] = y[k] + input * sign[k];
+      }
+      write = (write + 1) & mask;
+    }
+
+    for (Int k = 0; k < FDN_LINES; k++) {
+      filterStore[k] = store[k];
+      lastMod[k] = mod[k];
+    }
+  }
+
+  // every output listens to another row of the hadamard matrix
+  const Flt wet = wetFader() * outputgain / sqrt((Flt)FDN_LINES);
+  const Flt dry = dryFader();
+  for (UInt c = 0; c < buffer.size(); c++) {
+    Flt * o = wetOut.getPtr();
+    for (UInt i = 0; i < blockLength; i++) o[i] = 0;
+    for (Int k = 0; k < FDN_LINES; k++) {
+      const Flt g = hadamardSign(c % FDN_LINES, k) * ((c / FDN_LINES) & 1 ? -wet : wet);
+      const Flt * l = lineOut[k].getConstPtr();
+      for (UInt i = 0; i < blockLength; i++) o[i] += l[i] * g;
+    }
+
+    // early reflections, all read in one pass
+    Flt time[4], gain[4];
+    Bool reflections = false;
+    for (Int i = 0; i < 4; i++) {
+      time[i] = earlyPtr[i]() + earlyOffset[c];
+      gain[i] = earlyVolume[i]() > 0 ? earlyVolume[i]() : 0;
+      if (gain[i] > 0) reflections = true;
+    }
+    if (reflections) {
+      early.readTaps(earlyBuffer, 4, time, time, gain);
+      buffer[c] += earlyBuffer;
+    }
+
+    buffer[c] *= dry;
+    buffer[c] += wetOut;
+  }
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    fdnReverb.h
+    Created: 16 Oct 2026 7:03:25pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef FDNREVERB_H_INCLUDED
+#define FDNREVERB_H_INCLUDED
+
+#include <vector>
+#include "../dsp/buffer.hpp"
+#include "../dsp/delay.hpp"
+#include "../dsp/ramp.hpp"
+#include "../dsp/dspObject.hpp"
+#include "../reverb/reverb.hpp"
+
+#define FDN_LINES 8
+
+namespace YSE {
+  namespace INTERNAL {
+
+    /**
+      A feedback delay network reverb. All outputs share one network, which is
+      fed with the mono sum of the outputs. Every output listens to a different
+      orthogonal combination of the delay lines, so the outputs are decorrelated
+      without running a reverb per output.
+
+      Delay lengths are derived from the sample rate. The parameters are those of
+      the reverb interface, so that presets can be used with both reverb engines.
+    */
+    class fdnReverb : DSP::dspObject {
+    public:
+      fdnReverb();
+
+      void channels(Int value);
+      void set(reverb & params);
+      void clear();
+
+      virtual void create() {}
+      virtual void process(MULTICHANNELBUFFER & buffer);
+
+    private:
+      void init();
+      void update();
+
+      Bool enabled;
+      UInt sampleRate; // the rate the delay lengths were calculated for
+
+      // faders for smooth value adjustment
+      DSP::lint roomsizeFader;
+      DSP::lint dampFader;
+      DSP::lint wetFader;
+      DSP::lint dryFader;
+      DSP::lint modFrequency;
+      DSP::lint modWidth;
+
+      // The delay lines are interleaved: lines[position * FDN_LINES + line]. They
+      // share a write position and every line reads at its own delay behind it.
+      std::vector<Flt> lines;
+      UInt write;
+      UInt mask;
+      Flt length[FDN_LINES];
+      Flt gain[FDN_LINES];
+      Flt filterStore[FDN_LINES];
+      Flt damp;
+
+      // modulation of the delay lengths
+      Flt modPhase;
+      Flt lastMod[FDN_LINES];
+
+      // mono input and the output of every line for one block
+      DSP::buffer send;
+      DSP::buffer lineOut[FDN_LINES];
+      DSP::buffer wetOut;
+
+      // early reflections, read from the mono input
+      DSP::delay early;
+      DSP::buffer earlyBuffer;
+      DSP::lint earlyPtr[4];
+      DSP::lint earlyVolume[4];
+
+      std::vector<Int> earlyOffset; // per output, to decorrelate the reflections
+    };
+
+  }
+}
+
+
+
+#endif  // FDNREVERB_H_INCLUDED
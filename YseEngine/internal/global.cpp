@@ -27,6 +27,8 @@ void YSE::INTERNAL::global::addFastJob(threadPoolJob * job) {
 YSE::INTERNAL::global::global() : slowThreads(100, 1), fastThreads(2), update(false), active(false) {}
 
 void YSE::INTERNAL::global::init() {
+  // voices register with the hrtf manager, so it has to outlive all sounds and channels
+  Hrtf();
   REVERB::Manager().create();
 }
 
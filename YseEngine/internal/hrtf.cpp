@@ -0,0 +1,482 @@
+/*
+  ==============================================================================
+
+    hrtf.cpp
+    Created: 16 Oct 2026 2:31:07pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include "../internalHeaders.h"
+#include "../utils/json.hpp"
+#include <fstream>
+#include <string.h>
+
+using json = nlohmann::json;
+
+/******************************************************************
+** hrtfSet
+*******************************************************************/
+
+YSE::INTERNAL::hrtfSet::hrtfSet() : numPartitions(0), numMeasurements(0) {}
+
+Bool YSE::INTERNAL::hrtfSet::load(const std::string & fileName) {
+  std::ifstream source(fileName);
+  if (!source.is_open()) {
+    LogImpl().emit(E_FILE_ERROR, "hrtf set not found: " + fileName);
+    return false;
+  }
+
+  json j;
+  try {
+    source >> j;
+  }
+  catch (...) {
+    LogImpl().emit(E_FILE_ERROR, "invalid hrtf set: " + fileName);
+    return false;
+  }
+
+  if (j.count("SourcePosition") == 0 || j.count("Data.IR") == 0) {
+    LogImpl().emit(E_FILE_ERROR, "hrtf set without SourcePosition or Data.IR: " + fileName);
+    return false;
+  }
+
+  // SOFA stores the sample rate as an array
+  Flt fileRate = static_cast<Flt>(SAMPLERATE);
+  if (j.count("Data.SamplingRate")) {
+    auto & rate = j["Data.SamplingRate"];
+    fileRate = rate.is_array() ? rate[0].get<Flt>() : rate.get<Flt>();
+  }
+
+  auto & positions = j["SourcePosition"];
+  auto & irs = j["Data.IR"];
+  if (positions.size() != irs.size() || positions.size() == 0) {
+    LogImpl().emit(E_FILE_ERROR, "hrtf set has no measurements or a different number of positions and responses: " + fileName);
+    return false;
+  }
+
+  // find the longest response, after conversion to the current sample rate
+  Flt ratio = fileRate / SAMPLERATE;
+  UInt irLength = 0;
+  for (UInt m = 0; m < irs.size(); m++) {
+    for (UInt ear = 0; ear < 2; ear++) {
+      UInt length = static_cast<UInt>(irs[m][ear].size() / ratio);
+      if (length > irLength) irLength = length;
+    }
+  }
+
+  numMeasurements = positions.size();
+  numPartitions = (irLength + STANDARD_BUFFERSIZE - 1) / STANDARD_BUFFERSIZE;
+  if (numPartitions == 0) numPartitions = 1;
+
+  dirX.resize(numMeasurements);
+  dirY.resize(numMeasurements);
+  dirZ.resize(numMeasurements);
+  spectraReal.assign(numMeasurements * 2 * numPartitions * HRTF_BINS, 0.f);
+  spectraImaginary.assign(numMeasurements * 2 * numPartitions * HRTF_BINS, 0.f);
+
+  DSP::buffer segment(HRTF_FFTSIZE);
+  DSP::realFft fft;
+  std::vector<Flt> ir;
+
+  for (UInt m = 0; m < numMeasurements; m++) {
+    // SOFA azimuth is counter clockwise, while yse angles are clockwise
+    Flt angle = -positions[m][0].get<Flt>() * ToRadians;
+    Flt elevation = positions[m][1].get<Flt>() * ToRadians;
+    dirX[m] = sin(angle) * cos(elevation);
+    dirY[m] = sin(elevation);
+    dirZ[m] = cos(angle) * cos(elevation);
+
+    for (UInt ear = 0; ear < 2; ear++) {
+      // resample to the current sample rate with linear interpolation
+      const json & in = irs[m][ear];
+      ir.assign(numPartitions * STANDARD_BUFFERSIZE, 0.f);
+      for (UInt i = 0; i < ir.size(); i++) {
+        Flt pos = i * ratio;
+        UInt index = static_cast<UInt>(pos);
+        if (index >= in.size()) break;
+        Flt fraction = pos - index;
+        Flt next = index + 1 < in.size() ? in[index + 1].get<Flt>() : 0.f;
+        ir[i] = in[index].get<Flt>() * (1 - fraction) + next * fraction;
+      }
+
+      // every partition is zero padded to the fft size. The inverse fft
+      // is not normalized, so the scale is applied here.
+      for (UInt p = 0; p < numPartitions; p++) {
+        segment = 0.f;
+        Flt * ptr = segment.getPtr();
+        for (UInt i = 0; i < STANDARD_BUFFERSIZE; i++) {
+          ptr[i] = ir[p * STANDARD_BUFFERSIZE + i] / HRTF_FFTSIZE;
+        }
+        fft(segment);
+        memcpy(const_cast<Flt*>(real(m, ear, p)), fft.getReal().getConstPtr(), HRTF_BINS * sizeof(Flt));
+        memcpy(const_cast<Flt*>(imaginary(m, ear, p)), fft.getImaginary().getConstPtr(), HRTF_BINS * sizeof(Flt));
+      }
+    }
+  }
+
+  return true;
+}
+
+void YSE::INTERNAL::hrtfSet::find(Flt angle, Flt elevation, UInt & first, UInt & second, Flt & weight) const {
+  Flt x = sin(angle) * cos(elevation);
+  Flt y = sin(elevation);
+  Flt z = cos(angle) * cos(elevation);
+
+  Flt best = -2.f, next = -2.f;
+  first = second = 0;
+  for (UInt i = 0; i < numMeasurements; i++) {
+    Flt dot = x * dirX[i] + y * dirY[i] + z * dirZ[i];
+    if (dot > best) {
+      next = best; second = first;
+      best = dot; first = i;
+    }
+    else if (dot > next) {
+      next = dot; second = i;
+    }
+  }
+
+  if (numMeasurements < 2) {
+    second = first;
+    weight = 1.f;
+    return;
+  }
+
+  // weigh by angular distance
+  Clamp(best, -1.f, 1.f);
+  Clamp(next, -1.f, 1.f);
+  Flt d1 = acos(best);
+  Flt d2 = acos(next);
+  weight = (d1 + d2) > 0 ? d2 / (d1 + d2) : 1.f;
+}
+
+const Flt * YSE::INTERNAL::hrtfSet::real(UInt measurement, UInt ear, UInt partition) const {
+  return spectraReal.data() + ((measurement * 2 + ear) * numPartitions + partition) * HRTF_BINS;
+}
+
+const Flt * YSE::INTERNAL::hrtfSet::imaginary(UInt measurement, UInt ear, UInt partition) const {
+  return spectraImaginary.data() + ((measurement * 2 + ear) * numPartitions + partition) * HRTF_BINS;
+}
+
+/******************************************************************
+** hrtfManager
+*******************************************************************/
+
+YSE::INTERNAL::hrtfManager & YSE::INTERNAL::Hrtf() {
+  static hrtfManager h;
+  return h;
+}
+
+YSE::INTERNAL::hrtfManager::hrtfManager() : active(nullptr), pending(false) {}
+
+Bool YSE::INTERNAL::hrtfManager::load(const std::string & fileName) {
+  // loading takes a while, so this is done before anything is locked
+  hrtfSet set;
+  if (!set.load(fileName)) return false;
+
+  std::lock_guard<std::mutex> lock(mtx);
+  sets.emplace_front(std::move(set));
+  hrtfSet * ptr = &sets.front();
+
+  // allocate for the new set before the audio thread can see it
+  for (auto i = voices.begin(); i != voices.end(); ++i) {
+    std::lock_guard<std::mutex> voiceLock((*i)->mtx);
+    (*i)->stage(ptr);
+  }
+  active = ptr;
+  pending = true;
+  release();
+  return true;
+}
+
+void YSE::INTERNAL::hrtfManager::update() {
+  if (!pending) return;
+  std::lock_guard<std::mutex> lock(mtx);
+  release();
+}
+
+void YSE::INTERNAL::hrtfManager::release() {
+  // voices which still have to switch keep their set alive
+  Bool waiting = false;
+  for (auto i = voices.begin(); i != voices.end(); ++i) {
+    std::lock_guard<std::mutex> voiceLock((*i)->mtx);
+    if ((*i)->staged != nullptr) waiting = true;
+    else (*i)->releaseStaged();
+  }
+
+  auto previous = sets.before_begin();
+  for (auto i = sets.begin(); i != sets.end();) {
+    Bool used = &(*i) == active;
+    for (auto v = voices.begin(); v != voices.end() && !used; ++v) {
+      std::lock_guard<std::mutex> voiceLock((*v)->mtx);
+      used = (*v)->current == &(*i);
+    }
+    if (used) {
+      previous = i;
+      ++i;
+    }
+    else {
+      i = sets.erase_after(previous);
+    }
+  }
+
+  pending = waiting || std::next(sets.begin()) != sets.end();
+}
+
+void YSE::INTERNAL::hrtfManager::attach(hrtfVoice * voice) {
+  std::lock_guard<std::mutex> lock(mtx);
+  hrtfSet * set = active;
+  if (set != nullptr) voice->prepare(set);
+  voices.push_front(voice);
+}
+
+void YSE::INTERNAL::hrtfManager::detach(hrtfVoice * voice) {
+  std::lock_guard<std::mutex> lock(mtx);
+  voices.remove(voice);
+}
+
+/******************************************************************
+** hrtfMix
+*******************************************************************/
+
+YSE::INTERNAL::hrtfMix::hrtfMix() : used(false), fadeUsed(false) {
+  for (UInt ear = 0; ear < 2; ear++) {
+    real[ear].resize(HRTF_FFTSIZE);
+    imaginary[ear].resize(HRTF_FFTSIZE);
+    fadeReal[ear].resize(HRTF_FFTSIZE);
+    fadeImaginary[ear].resize(HRTF_FFTSIZE);
+  }
+}
+
+void YSE::INTERNAL::hrtfMix::clear() {
+  if (used) {
+    for (UInt ear = 0; ear < 2; ear++) {
+      real[ear] = 0.f;
+      imaginary[ear] = 0.f;
+    }
+    used = false;
+  }
+  if (fadeUsed) {
+    for (UInt ear = 0; ear < 2; ear++) {
+      fadeReal[ear] = 0.f;
+      fadeImaginary[ear] = 0.f;
+    }
+    fadeUsed = false;
+  }
+}
+
+void YSE::INTERNAL::hrtfMix::render(std::vector<DSP::buffer> & out) {
+  if (!used || out.size() < 2) return;
+
+  for (UInt ear = 0; ear < 2; ear++) {
+    // overlap-save: only the second half of the result is valid
+    DSP::buffer & result = ifft(real[ear], imaginary[ear]);
+    const Flt * in = result.getConstPtr() + STANDARD_BUFFERSIZE;
+    Flt * ptr = out[ear].getPtr();
+    UInt l = STANDARD_BUFFERSIZE;
+    for (; l > 7; l -= 8, ptr += 8, in += 8) {
+      ptr[0] += in[0]; ptr[1] += in[1];
+      ptr[2] += in[2]; ptr[3] += in[3];
+      ptr[4] += in[4]; ptr[5] += in[5];
+      ptr[6] += in[6]; ptr[7] += in[7];
+    }
+    while (l--) *ptr++ += *in++;
+
+    if (!fadeUsed) continue;
+
+    // the difference between the old and the new filters fades out
+    DSP::buffer & fade = ifft(fadeReal[ear], fadeImaginary[ear]);
+    in = fade.getConstPtr() + STANDARD_BUFFERSIZE;
+    ptr = out[ear].getPtr();
+    Flt step = 1.f / STANDARD_BUFFERSIZE;
+    for (UInt i = 0; i < STANDARD_BUFFERSIZE; i++) {
+      ptr[i] += in[i] * (1.f - step * (i + 1));
+    }
+  }
+}
+
+/******************************************************************
+** hrtfVoice
+*******************************************************************/
+
+YSE::INTERNAL::hrtfVoice::hrtfVoice()
+  : current(nullptr)
+  , staged(nullptr)
+  , frame(HRTF_FFTSIZE)
+  , inputHead(0)
+  , fade(false)
+  , interpolated(false)
+  , lastAngle(0)
+  , lastElevation(0) {
+  frame = 0.f;
+  Hrtf().attach(this);
+}
+
+YSE::INTERNAL::hrtfVoice::hrtfVoice(const hrtfVoice &)
+  : current(nullptr)
+  , staged(nullptr)
+  , frame(HRTF_FFTSIZE)
+  , inputHead(0)
+  , fade(false)
+  , interpolated(false)
+  , lastAngle(0)
+  , lastElevation(0) {
+  frame = 0.f;
+  Hrtf().attach(this);
+}
+
+YSE::INTERNAL::hrtfVoice::~hrtfVoice() {
+  Hrtf().detach(this);
+}
+
+void YSE::INTERNAL::hrtfVoice::prepare(hrtfSet * set) {
+  current = set;
+  UInt length = set->partitions() * HRTF_BINS;
+  inputReal.assign(length, 0.f);
+  inputImaginary.assign(length, 0.f);
+  filterReal.assign(length * 2, 0.f);
+  filterImaginary.assign(length * 2, 0.f);
+  previousReal.assign(length * 2, 0.f);
+  previousImaginary.assign(length * 2, 0.f);
+  fade = false;
+  interpolated = false;
+  inputHead = 0;
+  frame = 0.f;
+}
+
+void YSE::INTERNAL::hrtfVoice::stage(hrtfSet * set) {
+  UInt length = set->partitions() * HRTF_BINS;
+  nextInputReal.assign(length, 0.f);
+  nextInputImaginary.assign(length, 0.f);
+  nextFilterReal.assign(length * 2, 0.f);
+  nextFilterImaginary.assign(length * 2, 0.f);
+  nextPreviousReal.assign(length * 2, 0.f);
+  nextPreviousImaginary.assign(length * 2, 0.f);
+  staged = set;
+}
+
+void YSE::INTERNAL::hrtfVoice::releaseStaged() {
+  std::vector<Flt>().swap(nextInputReal);
+  std::vector<Flt>().swap(nextInputImaginary);
+  std::vector<Flt>().swap(nextFilterReal);
+  std::vector<Flt>().swap(nextFilterImaginary);
+  std::vector<Flt>().swap(nextPreviousReal);
+  std::vector<Flt>().swap(nextPreviousImaginary);
+}
+
+void YSE::INTERNAL::hrtfVoice::interpolate(Flt angle, Flt elevation) {
+  UInt first, second;
+  Flt weight;
+  current->find(angle, elevation, first, second, weight);
+  Flt inverse = 1.f - weight;
+
+  UInt partitions = current->partitions();
+  for (UInt ear = 0; ear < 2; ear++) {
+    for (UInt p = 0; p < partitions; p++) {
+      const Flt * r1 = current->real(first, ear, p);
+      const Flt * i1 = current->imaginary(first, ear, p);
+      const Flt * r2 = current->real(second, ear, p);
+      const Flt * i2 = current->imaginary(second, ear, p);
+      Flt * r = filterReal.data() + (ear * partitions + p) * HRTF_BINS;
+      Flt * i = filterImaginary.data() + (ear * partitions + p) * HRTF_BINS;
+      for (UInt k = 0; k < HRTF_BINS; k++) {
+        r[k] = r1[k] * weight + r2[k] * inverse;
+        i[k] = i1[k] * weight + i2[k] * inverse;
+      }
+    }
+  }
+
+  lastAngle = angle;
+  lastElevation = elevation;
+  interpolated = true;
+}
+
+void YSE::INTERNAL::hrtfVoice::process(hrtfSet * set, DSP::buffer & input, Flt angle, Flt elevation, hrtfMix & mix) {
+  // Switch to the state that was allocated when the set was loaded. If the
+  // manager holds the lock, the voice keeps the old set for another block.
+  if (set != current && mtx.try_lock()) {
+    if (staged == set) {
+      inputReal.swap(nextInputReal);
+      inputImaginary.swap(nextInputImaginary);
+      filterReal.swap(nextFilterReal);
+      filterImaginary.swap(nextFilterImaginary);
+      previousReal.swap(nextPreviousReal);
+      previousImaginary.swap(nextPreviousImaginary);
+      current = set;
+      staged = nullptr;
+      fade = false;
+      interpolated = false;
+      inputHead = 0;
+      frame = 0.f;
+    }
+    mtx.unlock();
+  }
+  if (current == nullptr) return;
+
+  if (!interpolated) {
+    interpolate(angle, elevation);
+  }
+  // only look for new responses if the direction has changed more than a degree
+  else if (fabs(angle - lastAngle) > ToRadians || fabs(elevation - lastElevation) > ToRadians) {
+    // keep the old filter to crossfade from
+    filterReal.swap(previousReal);
+    filterImaginary.swap(previousImaginary);
+    interpolate(angle, elevation);
+    fade = true;
+  }
+
+  // shift the input frame and add the new block
+  Flt * f = frame.getPtr();
+  memmove(f, f + STANDARD_BUFFERSIZE, STANDARD_BUFFERSIZE * sizeof(Flt));
+  memcpy(f + STANDARD_BUFFERSIZE, input.getConstPtr(), STANDARD_BUFFERSIZE * sizeof(Flt));
+
+  // the input spectrum is calculated once and used for both ears
+  UInt partitions = current->partitions();
+  inputHead = (inputHead + partitions - 1) % partitions;
+  fft(frame);
+  memcpy(inputReal.data() + inputHead * HRTF_BINS, fft.getReal().getConstPtr(), HRTF_BINS * sizeof(Flt));
+  memcpy(inputImaginary.data() + inputHead * HRTF_BINS, fft.getImaginary().getConstPtr(), HRTF_BINS * sizeof(Flt));
+
+  for (UInt ear = 0; ear < 2; ear++) {
+    Flt * outR = mix.real[ear].getPtr();
+    Flt * outI = mix.imaginary[ear].getPtr();
+    for (UInt p = 0; p < partitions; p++) {
+      UInt slot = (inputHead + p) % partitions;
+      const Flt * xr = inputReal.data() + slot * HRTF_BINS;
+      const Flt * xi = inputImaginary.data() + slot * HRTF_BINS;
+      const Flt * hr = filterReal.data() + (ear * partitions + p) * HRTF_BINS;
+      const Flt * hi = filterImaginary.data() + (ear * partitions + p) * HRTF_BINS;
+      for (UInt k = 0; k < HRTF_BINS; k++) {
+        outR[k] += xr[k] * hr[k] - xi[k] * hi[k];
+        outI[k] += xr[k] * hi[k] + xi[k] * hr[k];
+      }
+    }
+  }
+  mix.used = true;
+
+  if (!fade) return;
+
+  // the result of the old filter minus that of the new one, which the mix fades out
+  for (UInt ear = 0; ear < 2; ear++) {
+    Flt * outR = mix.fadeReal[ear].getPtr();
+    Flt * outI = mix.fadeImaginary[ear].getPtr();
+    for (UInt p = 0; p < partitions; p++) {
+      UInt slot = (inputHead + p) % partitions;
+      const Flt * xr = inputReal.data() + slot * HRTF_BINS;
+      const Flt * xi = inputImaginary.data() + slot * HRTF_BINS;
+      const Flt * hr = filterReal.data() + (ear * partitions + p) * HRTF_BINS;
+      const Flt * hi = filterImaginary.data() + (ear * partitions + p) * HRTF_BINS;
+      const Flt * pr = previousReal.data() + (ear * partitions + p) * HRTF_BINS;
+      const Flt * pi = previousImaginary.data() + (ear * partitions + p) * HRTF_BINS;
+      for (UInt k = 0; k < HRTF_BINS; k++) {
+        Flt dr = pr[k] - hr[k];
+        Flt di = pi[k] - hi[k];
+        outR[k] += xr[k] * dr - xi[k] * di;
+        outI[k] += xr[k] * di + xi[k] * dr;
+      }
+    }
+  }
+  mix.fadeUsed = true;
+  fade = false;
+}
@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+
+    hrtf.h
+    Created: 16 Oct 2026 2:31:07pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef HRTF_H_INCLUDED
+#define HRTF_H_INCLUDED
+
+#include <atomic>
+#include <forward_list>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../headers/types.hpp"
+#include "../dsp/buffer.hpp"
+#include "../dsp/fourier/fft.hpp"
+
+namespace YSE {
+  namespace INTERNAL {
+
+    // fft size used for uniformly partitioned convolution. Every partition
+    // covers one STANDARD_BUFFERSIZE block of the impulse response.
+    const UInt HRTF_FFTSIZE = STANDARD_BUFFERSIZE * 2;
+    const UInt HRTF_BINS = STANDARD_BUFFERSIZE + 1;
+
+    /**
+      A set of head related impulse responses. All responses are converted to
+      partitioned spectra when loading, so that they can be used directly for
+      frequency domain convolution.
+
+      The file format mirrors the fields of a SOFA SimpleFreeFieldHRIR set,
+      exported as JSON:
+
+      {
+        "Data.SamplingRate" : 44100,
+        "SourcePosition"    : [ [azimuth, elevation, distance], ... ],
+        "Data.IR"           : [ [ [left ir], [right ir] ], ... ]
+      }
+
+      Azimuth and elevation are in degrees, with positive azimuth to the left,
+      as in the SOFA spherical coordinate system.
+    */
+    class hrtfSet {
+    public:
+      hrtfSet();
+
+      Bool load(const std::string & fileName);
+
+      UInt partitions() const { return numPartitions; }
+      UInt measurements() const { return numMeasurements; }
+
+      /** Find the two measurements closest to a direction.
+          @param weight   the weight for the first measurement. The second
+                          measurement should be used with 1 - weight.
+      */
+      void find(Flt angle, Flt elevation, UInt & first, UInt & second, Flt & weight) const;
+
+      const Flt * real(UInt measurement, UInt ear, UInt partition) const;
+      const Flt * imaginary(UInt measurement, UInt ear, UInt partition) const;
+
+    private:
+      UInt numPartitions;
+      UInt numMeasurements;
+
+      // unit vectors for all measurement directions
+      std::vector<Flt> dirX, dirY, dirZ;
+
+      // spectra, ordered by measurement, ear and partition
+      std::vector<Flt> spectraReal, spectraImaginary;
+    };
+
+    class hrtfVoice;
+
+    /**
+      The hrtf manager holds the hrtf set used for binaural output. Sets are loaded
+      from the calling thread and then handed to the audio thread. All voices are
+      registered here, so that their state for a new set can be allocated when it
+      is loaded. A previous set is kept until no voice uses it anymore.
+    */
+    class hrtfManager {
+    public:
+      hrtfManager();
+
+      Bool load(const std::string & fileName);
+
+      // returns nullptr if no set is loaded
+      hrtfSet * get() { return active; }
+
+      /** Release sets which are replaced and no longer used by a voice. This
+          should not be called from the audio thread.
+      */
+      void update();
+
+    private:
+      void attach(hrtfVoice * voice);
+      void detach(hrtfVoice * voice);
+      void release();
+
+      std::atomic<hrtfSet *> active;
+      std::forward_list<hrtfSet> sets;
+      std::forward_list<hrtfVoice *> voices;
+      std::mutex mtx;
+      std::atomic<Bool> pending; // there are old sets or staged states to release
+
+      friend class hrtfVoice;
+    };
+
+    hrtfManager & Hrtf();
+
+    /**
+      Accumulates the output spectra of all binaural sounds in a channel. Because
+      convolution is linear, this way only one inverse fft per ear is needed for
+      all sounds together.
+
+      Voices which change their filter add the difference between the old and the
+      new filter result to a second set of spectra. This part fades out over the
+      block, so all voices crossfade with one extra inverse fft per ear.
+    */
+    class hrtfMix {
+    public:
+      hrtfMix();
+
+      void clear();
+
+      /** Transform the accumulated spectra back to the time domain and add
+          them to the first two output buffers.
+      */
+      void render(std::vector<DSP::buffer> & out);
+
+    private:
+      DSP::buffer real[2];
+      DSP::buffer imaginary[2];
+      DSP::buffer fadeReal[2];
+      DSP::buffer fadeImaginary[2];
+      DSP::inverseRealFft ifft;
+      Bool used;
+      Bool fadeUsed;
+
+      friend class hrtfVoice;
+    };
+
+    /**
+      The convolution state of a single sound. The input spectrum is calculated
+      once per block and shared by both ears.
+    */
+    class hrtfVoice {
+    public:
+      // allocates for the loaded hrtf set, if there is one
+      hrtfVoice();
+      // a copy starts without input, like a new voice
+      hrtfVoice(const hrtfVoice &);
+      hrtfVoice & operator=(const hrtfVoice &) = delete;
+      ~hrtfVoice();
+
+      /** Convolve one block of mono input and add the result to the mix. When
+          the direction changes, the output crossfades from the old to the new
+          filter over this block. When the set changes, the voice switches to
+          the state which was allocated when the set was loaded.
+      */
+      void process(hrtfSet * set, DSP::buffer & input, Flt angle, Flt elevation, hrtfMix & mix);
+
+    private:
+      // allocate the state for a set, used before the voice is registered
+      void prepare(hrtfSet * set);
+      // allocate the next state for a set, with the voice locked by the manager
+      void stage(hrtfSet * set);
+      // free the next state if it is not needed anymore
+      void releaseStaged();
+      void interpolate(Flt angle, Flt elevation);
+
+      hrtfSet * current;
+
+      // state for a newly loaded set, which process() switches to
+      hrtfSet * staged;
+      std::vector<Flt> nextInputReal, nextInputImaginary;
+      std::vector<Flt> nextFilterReal, nextFilterImaginary;
+      std::vector<Flt> nextPreviousReal, nextPreviousImaginary;
+      std::mutex mtx; // locked by the manager while staging, try_lock only on the audio thread
+
+      // previous and current input block
+      DSP::buffer frame;
+      DSP::realFft fft;
+
+      // frequency domain delay line, one spectrum per partition
+      std::vector<Flt> inputReal, inputImaginary;
+      UInt inputHead;
+
+      // interpolated filter for both ears, and the one it replaced
+      std::vector<Flt> filterReal, filterImaginary;
+      std::vector<Flt> previousReal, previousImaginary;
+      Bool fade;
+      Bool interpolated; // false until the filter is calculated for this set
+      Flt lastAngle, lastElevation;
+
+      friend class hrtfManager;
+    };
+
+  }
+}
+
+
+
+#endif  // HRTF_H_INCLUDED
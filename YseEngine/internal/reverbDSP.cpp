@@ -11,7 +11,7 @@
 #include "reverbDSP.h"
 #include "../reverb/reverbInterface.hpp"
 #include "../utils/misc.hpp"
-#include <limits>
+#include "denormal.h"
 
 #define LOGTEN 2.302585092994
 
@@ -32,10 +32,6 @@
 #define freezemode		0.5f
 #define	stereospread	23
 
-inline void Undenormal(Flt &v) {
-  if (v != 0 && fabsf(v) < std::numeric_limits<float>::min()) v = 0;
-}
-
 /* these values assume 44.1KHz sample rate
 they will probably be OK for 48KHz sample rate
 but would need scaling for 96KHz (or other) sample rates.
@@ -43,51 +39,9 @@ the values were obtained by listening tests.                */
 static const int combtuning[8] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
 static const int allpasstuning[4] = { 556, 441, 341, 225 };
 
-// static inline functions and pointer for speed optimisation
-UInt ch;
-Int filterIndex;
-Int * curCombIndex;
-Int * curCombTuning;
-std::vector< std::vector<Flt> > * curBufComb;
-Flt * curFilterStore;
-std::vector< std::vector<Flt> > * curBufAll;
-Int * curAllIndex;
-Int * curAllTuning;
-Flt _allpassFeedback;
-Flt _combFeedback;
-Flt combDamp1;
-Flt combDamp2;
-Int bufferIndex;
-
-static inline Flt combProcess(Flt input) {
-  Flt output;
-  output = (*curBufComb)[filterIndex][bufferIndex];
-  Undenormal(output);
-
-  curFilterStore[filterIndex] = (output * combDamp2) + (curFilterStore[filterIndex] * combDamp1);
-  Undenormal(curFilterStore[filterIndex]);
-
-  (*curBufComb)[filterIndex][bufferIndex] = input + (curFilterStore[filterIndex] * _combFeedback);
-  if (++bufferIndex >= curCombTuning[filterIndex]) bufferIndex = 0;
-  return output;
-}
-
-static inline void allpassProcess(Flt & input) {
-  Flt bufout;
-
-  bufout = (*curBufAll)[filterIndex][bufferIndex];
-  Undenormal(bufout);
-
-  (*curBufAll)[filterIndex][bufferIndex] = input + (bufout * _allpassFeedback);
-  if (++bufferIndex >= curAllTuning[filterIndex]) bufferIndex = 0;
-
-  input = -input + bufout;
-}
-
-
 void YSE::INTERNAL::reverbDSP::combDamp(Flt value) {
-  combDamp1 = value;
-  combDamp2 = 1 - value;
+  _combDamp1 = value;
+  _combDamp2 = 1 - value;
 }
 
 YSE::INTERNAL::reverbDSP& YSE::INTERNAL::reverbDSP::combFeedback(Flt value) {
@@ -138,93 +92,110 @@ void YSE::INTERNAL::reverbDSP::process(MULTICHANNELBUFFER & buffer) {
     cosPtr2 = cos2(modPtr);
   }
 
-  for (ch = 0; ch < channel.size(); ch++) {
-    Flt * ptr = buffer[ch].getPtr();
-    channel[ch].out = 0;
+  // local copies, so that the compiler doesn't have to reload them for every sample
+  const Flt gain = _gain;
+  const Flt combFb = _combFeedback;
+  const Flt damp1 = _combDamp1;
+  const Flt damp2 = _combDamp2;
+  const Flt allpassFb = _allpassFeedback;
+
+  for (UInt ch = 0; ch < channel.size(); ch++) {
+    const Flt * ptr = buffer[ch].getConstPtr();
     Flt * out = channel[ch].out.getPtr();
     Int length = buffer[ch].getLength();
-    curCombIndex = channel[ch].combIndex;
-    curBufComb = &channel[ch].bufComb;
-    curFilterStore = channel[ch].filterStore;
-    curCombTuning = channel[ch].combTuning;
-    curBufAll = &channel[ch].bufAll;
-    curAllIndex = channel[ch].allIndex;
-    curAllTuning = channel[ch].allTuning;
+    reverbChannel & c = channel[ch];
 
     // update delay line
     channel[ch].delayline.process(buffer[ch]);
-    for (Int i = 0; i < 4; i++) {
-      if (channel[ch].earlyVolume[i].getValue() > 0) {
-        channel[ch].delayline.read(channel[ch].early[i], channel[ch].earlyPtr[i]());
-        channel[ch].early[i] *= channel[ch].earlyVolume[i]();
-        buffer[ch] += channel[ch].early[i];
+
+    // all reflections are read in one pass. The reflection times are ramps,
+    // which are linear within a block.
+    {
+      Flt startTime[4], endTime[4], level[4];
+      Bool reflections = false;
+      for (Int i = 0; i < 4; i++) {
+        DSP::buffer & time = c.earlyPtr[i]();
+        startTime[i] = time.getConstPtr()[0];
+        endTime[i] = time.getBack();
+        level[i] = c.earlyVolume[i].getValue();
+        if (level[i] > 0) reflections = true;
+        else level[i] = 0;
+      }
+      if (reflections) {
+        c.delayline.readTaps(c.early, 4, startTime, endTime, level);
+        buffer[ch] += c.early;
       }
     }
 
-    for (; length > 7; length -= 8, ptr += 8, out += 8) {
-      //ptr[0] = ptr[1] = ptr[2] = ptr[3] = ptr[4] = ptr[5] = ptr[6] = ptr[7] = 0;			
-      for (filterIndex = 0; filterIndex < COMBS; filterIndex++) {
-        bufferIndex = curCombIndex[filterIndex];
-
-        out[0] += combProcess(ptr[0] * _gain);
-        out[1] += combProcess(ptr[1] * _gain);
-        out[2] += combProcess(ptr[2] * _gain);
-        out[3] += combProcess(ptr[3] * _gain);
-        out[4] += combProcess(ptr[4] * _gain);
-        out[5] += combProcess(ptr[5] * _gain);
-        out[6] += combProcess(ptr[6] * _gain);
-        out[7] += combProcess(ptr[7] * _gain);
-        curCombIndex[filterIndex] = bufferIndex;
+    // comb filters in parallel: every lane of the inner loops is one comb
+    {
+      Flt * comb = c.combBuffer.data();
+      const UInt mask = c.combMask;
+      UInt write = c.combWrite;
+      Flt store[COMBS];
+      UInt delay[COMBS];
+      for (Int k = 0; k < COMBS; k++) {
+        store[k] = c.filterStore[k];
+        delay[k] = c.combTuning[k];
       }
 
-      for (filterIndex = 0; filterIndex < APASS; filterIndex++) {
-        bufferIndex = curAllIndex[filterIndex];
-        allpassProcess(out[0]);
-        allpassProcess(out[1]);
-        allpassProcess(out[2]);
-        allpassProcess(out[3]);
-        allpassProcess(out[4]);
-        allpassProcess(out[5]);
-        allpassProcess(out[6]);
-        allpassProcess(out[7]);
-        curAllIndex[filterIndex] = bufferIndex;
+      for (Int i = 0; i < length; i++) {
+        const Flt input = ptr[i] * gain;
+        Flt output[COMBS];
+        for (Int k = 0; k < COMBS; k++) {
+          output[k] = comb[((write - delay[k]) & mask) * COMBS + k];
+        }
+
+        Flt * w = comb + write * COMBS;
+        for (Int k = 0; k < COMBS; k++) {
+          store[k] = flushDenormal((output[k] * damp2) + (store[k] * damp1));
+          w[k] = input + (store[k] * combFb);
+        }
+
+        Flt sum = 0;
+        for (Int k = 0; k < COMBS; k++) sum += output[k];
+        out[i] = sum;
+        write = (write + 1) & mask;
       }
-    }
 
-    while (length--) {
-      // accumulate comb filters in parallel
-      for (filterIndex = 0; filterIndex < COMBS; filterIndex++) {
-        bufferIndex = curCombIndex[filterIndex];
-        *out += combProcess(*ptr * _gain);
-        curCombIndex[filterIndex] = bufferIndex;
-      }
+      c.combWrite = write;
+      for (Int k = 0; k < COMBS; k++) c.filterStore[k] = store[k];
+    }
 
-      // feed through allpass in series
-      for (filterIndex = 0; filterIndex < APASS; filterIndex++) {
-        bufferIndex = curAllIndex[filterIndex];
-        allpassProcess(*out);
-        curAllIndex[filterIndex] = bufferIndex;
+    // allpass filters in series. An allpass has no dependencies between samples
+    // shorter than its delay, so a filter processes the whole block at once, in 
+    // parts that don't wrap around its buffer.
+    for (Int f = 0; f < APASS; f++) {
+      Flt * buf = c.allBuffer.data() + c.allOffset[f];
+      Int index = c.allIndex[f];
+      const Int tuning = c.allTuning[f];
+      Int done = 0;
+      while (done < length) {
+        Int run = tuning - index;
+        if (run > length - done) run = length - done;
+        Flt * o = out + done;
+        Flt * b = buf + index;
+        for (Int i = 0; i < run; i++) {
+          const Flt bufout = b[i];
+          b[i] = flushDenormal(o[i] + (bufout * allpassFb));
+          o[i] = -o[i] + bufout;
+        }
+        index += run;
+        if (index >= tuning) index = 0;
+        done += run;
       }
-      ptr++;
-      out++;
+      c.allIndex[f] = index;
     }
 
     // apply modulation to wet signal
     if (_modFrequency() != 0 && _modWidth() != 0) {
       channel[ch].hil(channel[ch].out, channel[ch].hil1, channel[ch].hil2);
-      channel[ch].hil1 *= cosPtr1;
-      channel[ch].hil2 *= cosPtr2;
-      channel[ch].hil1 -= channel[ch].hil2;
 
       // Calculate output REPLACING anything already there
-      buffer[ch] *= _dryFader();
-      channel[ch].hil1 *= _wet1;
-      buffer[ch] += channel[ch].hil1;
+      buffer[ch] = buffer[ch] * _dryFader() + (channel[ch].hil1 * cosPtr1 - channel[ch].hil2 * cosPtr2) * _wet1;
     }
     else {
-      buffer[ch] *= _dryFader();
-      channel[ch].out *= _wet1;
-      buffer[ch] += channel[ch].out;
+      buffer[ch] = buffer[ch] * _dryFader() + channel[ch].out * _wet1;
     }
   }
 }
@@ -347,6 +318,9 @@ void YSE::INTERNAL::reverbDSP::set(YSE::reverb & params) {
 
 YSE::INTERNAL::reverbDSP::reverbDSP() {
   _freeze = false;
+  _combFeedback = 0;
+  _combDamp1 = 0;
+  _combDamp2 = 1;
 
   // default values
   _modFrequency.set(0, 0);
@@ -365,76 +339,51 @@ YSE::INTERNAL::reverbDSP::~reverbDSP() {
 
 }
 
-YSE::INTERNAL::reverbChannel::reverbChannel() : delayline(3000), bufComb(COMBS), bufAll(APASS) {
-  Int rnd = Random(50);
-  // recalculate the reverb parameters in case we don't run at 44.1kHz
-  for (Int i = 0; i < COMBS; i++) {
-    combTuning[i] = (Int)((combtuning[i] + rnd) * (SAMPLERATE / 44100.0f));
-  }
-
-  for (int i = 0; i < APASS; i++) {
-    allTuning[i] = (Int)((allpasstuning[i] + rnd) * (SAMPLERATE / 44100.0f));
-  }
-
-  // get memory for delay lines
-  for (Int i = 0; i < COMBS; i++) {
-    bufComb[i].resize(combTuning[i]);
-    combIndex[i] = 0;
-  }
-
-  for (Int i = 0; i < APASS; i++) {
-    bufAll[i].resize(allTuning[i]);
-    allIndex[i] = 0;
-  }
-  
-  earlyOffset = Random(30);
-  /*earlyPtr[0] = 60;
-  earlyPtr[1] = 100;
-  earlyPtr[2] = 150;
-  earlyPtr[3] = 230;
-  earlyVolume[0] = 0.50;
-  earlyVolume[1] = 0.30;
-  earlyVolume[2] = 0.35;
-  earlyVolume[3] = 0.20;*/
+YSE::INTERNAL::reverbChannel::reverbChannel() : delayline(3000) {
+  init();
+}
 
-  clear();
+YSE::INTERNAL::reverbChannel::reverbChannel(const reverbChannel& source) : delayline(3000) {
+  init();
 }
 
-YSE::INTERNAL::reverbChannel::reverbChannel(const reverbChannel& source): delayline(3000), bufComb(COMBS), bufAll(APASS) {
-    Int rnd = Random(50);
+void YSE::INTERNAL::reverbChannel::init() {
+  Int rnd = Random(50);
   // recalculate the reverb parameters in case we don't run at 44.1kHz
+  UInt longest = 0;
   for (Int i = 0; i < COMBS; i++) {
-    combTuning[i] = (Int)((combtuning[i] + rnd) * (SAMPLERATE / 44100.0f));
+    combTuning[i] = (UInt)((combtuning[i] + rnd) * (SAMPLERATE / 44100.0f));
+    if (combTuning[i] > longest) longest = combTuning[i];
   }
 
+  Int allLength = 0;
   for (int i = 0; i < APASS; i++) {
     allTuning[i] = (Int)((allpasstuning[i] + rnd) * (SAMPLERATE / 44100.0f));
+    allOffset[i] = allLength;
+    allIndex[i] = 0;
+    allLength += allTuning[i];
   }
 
-  // get memory for delay lines
-  for (Int i = 0; i < COMBS; i++) {
-    bufComb[i].resize(combTuning[i]);
-    combIndex[i] = 0;
-  }
+  // get memory for delay lines. The comb length is a power of two, so that
+  // read and write positions can wrap with a mask.
+  UInt combLength = 1;
+  while (combLength <= longest) combLength <<= 1;
+  combMask = combLength - 1;
+  combWrite = 0;
+  combBuffer.resize(combLength * COMBS);
+  allBuffer.resize(allLength);
 
-  for (Int i = 0; i < APASS; i++) {
-    bufAll[i].resize(allTuning[i]);
-    allIndex[i] = 0;
-  }
-  
   earlyOffset = Random(30);
-  clear();  
+  clear();
 }
 
 void YSE::INTERNAL::reverbChannel::clear() {
-  for (UInt i = 0; i < bufComb.size(); i++) {
-    bufComb[i].assign(bufComb[i].size(), 0.f);
+  combBuffer.assign(combBuffer.size(), 0.f);
+  allBuffer.assign(allBuffer.size(), 0.f);
+  delayline.clear();
+  for (Int i = 0; i < COMBS; i++) {
     filterStore[i] = 0.f;
   }
-
-  for (UInt i = 0; i < bufAll.size(); i++) {
-    bufAll[i].assign(bufAll[i].size(), 0.f);
-  }
 }
 
 void YSE::INTERNAL::reverbChannel::update() {
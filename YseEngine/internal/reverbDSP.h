@@ -32,7 +32,7 @@ namespace YSE {
 
       DSP::buffer   out;
       DSP::delay    delayline;
-      DSP::buffer   early[4];
+      DSP::buffer   early; // the sum of all reflections
       DSP::ramp     earlyPtr[4];
       DSP::ramp     earlyVolume[4];
       DSP::hilbert  hil;
@@ -41,16 +41,27 @@ namespace YSE {
 
       Flt * cPtr;
       Int   earlyOffset;
+
+      // The comb filters are interleaved, so that all combs can be processed in
+      // parallel: combBuffer[position * COMBS + comb]. They share a write
+      // position and every comb reads at its own delay behind it.
+      std::vector<Flt> combBuffer;
+      UInt  combWrite;
+      UInt  combMask;
+      UInt  combTuning[COMBS];
       Flt   filterStore[COMBS];
-      std::vector< std::vector<Flt> > bufComb;
-      Int   combIndex[COMBS];
-      Int   combTuning[COMBS];
-      std::vector< std::vector<Flt> > bufAll;
+
+      // allpass filters, one after the other in a single buffer
+      std::vector<Flt> allBuffer;
+      Int   allOffset[APASS];
       Int   allIndex[APASS];
       Int   allTuning[APASS];
 
       reverbChannel();
       reverbChannel(const reverbChannel & source);
+
+    private:
+      void init();
     };
 
     class reverbDSP : DSP::dspObject {
@@ -62,6 +73,11 @@ namespace YSE {
       Bool _freeze;
       Bool _bypass;
 
+      // filter state, kept per object so that several reverbs can run at the same time
+      Flt _combFeedback;
+      Flt _allpassFeedback;
+      Flt _combDamp1, _combDamp2;
+
       // faders for smooth value adjustment 
       DSP::lint _roomsizeFader;
       DSP::lint _dampFader;
@@ -9,6 +9,7 @@
 */
 
 #include "threadPool.h"
+#include "denormal.h"
 #include <assert.h>
 #include "../system.hpp"
 
@@ -36,6 +37,7 @@ void YSE::INTERNAL::threadPoolJob::activate() {
 YSE::INTERNAL::threadPoolThread::threadPoolThread(threadPool * pool, Int sleepTimeMS) : pool(pool), sleepTime(sleepTimeMS) {}
 
 void YSE::INTERNAL::threadPoolThread::run() {
+  disableDenormals();
   while (!threadShouldExit()) {
     threadPoolJob * job = pool->getJob();
     if (job != nullptr) {
@@ -0,0 +1,416 @@
+/*
+  ==============================================================================
+
+    timeStretch.cpp
+    Created: 16 Oct 2026 11:12:40pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include <math.h>
+#include <string.h>
+#include "timeStretch.h"
+#include "global.h"
+
+namespace {
+  const Dbl PI = 3.14159265358979323846;
+  const Flt TWO_PI = (Flt)(2.0 * PI);
+
+  // output samples between frames, the same for both modes
+  const UInt HOP = 512;
+
+  const UInt WSOLA_SIZE = 1024;
+  const UInt WSOLA_TOLERANCE = 256;
+  // the part of a frame that overlaps with the next one is compared
+  const UInt WSOLA_COMPARE = WSOLA_SIZE - HOP;
+  // the coarse search only looks at every fourth offset and sample
+  const UInt WSOLA_DECIMATE = 4;
+
+  const UInt VOCODER_SIZE = 2048;
+  const UInt VOCODER_BINS = VOCODER_SIZE / 2 + 1;
+
+  // Enough for the largest frame with its search range and the input of a
+  // full block at the maximum ratio, with room to spare.
+  const UInt INPUT_SIZE = 8192;
+  const UInt STAGING_SIZE = VOCODER_SIZE + 4 * HOP;
+  const UInt OUTPUT_SIZE = VOCODER_SIZE + 2 * HOP;
+
+  const Flt NORM_EPSILON = 1e-6f;
+
+  inline Flt limit(Flt ratio) {
+    if (ratio < YSE::INTERNAL::STRETCH_MIN_RATIO) return YSE::INTERNAL::STRETCH_MIN_RATIO;
+    if (ratio > YSE::INTERNAL::STRETCH_MAX_RATIO) return YSE::INTERNAL::STRETCH_MAX_RATIO;
+    return ratio;
+  }
+
+  void hann(std::vector<Flt> & window, UInt size) {
+    window.resize(size);
+    for (UInt i = 0; i < size; i++) {
+      window[i] = (Flt)(0.5 - 0.5 * cos(2.0 * PI * i / size));
+    }
+  }
+
+  inline Flt wrap(Flt phase) {
+    return phase - TWO_PI * floorf((phase + (Flt)PI) / TWO_PI);
+  }
+
+  // correlation of a candidate with the template, divided by the
+  // candidate energy so that louder parts are not preferred
+  inline Flt similarity(const Flt * templ, const Flt * candidate, UInt length, UInt step) {
+    Flt product = 0.f, energy = 0.f;
+    for (UInt i = 0; i < length; i += step) {
+      product += templ[i] * candidate[i];
+      energy += candidate[i] * candidate[i];
+    }
+    return product / sqrtf(energy + 1e-9f);
+  }
+}
+
+YSE::INTERNAL::timeStretch::timeStretch()
+  : current(SM_WSOLA)
+  , numChannels(0), wantedChannels(0), isReady(false)
+  , filled(0), nominal(0), previous(0), first(true), done(0)
+  , plan(nullptr)
+  , job(this) {
+}
+
+void YSE::INTERNAL::timeStretch::prepare(UInt channels) {
+  if (isReady || job.isQueued() || channels == 0) return;
+  wantedChannels = channels;
+  Global().addSlowJob(&job);
+}
+
+void YSE::INTERNAL::timeStretch::allocateJob::run() {
+  owner->allocate();
+}
+
+void YSE::INTERNAL::timeStretch::allocate() {
+  UInt channels = wantedChannels;
+
+  staging.resize(channels);
+  input.resize(channels);
+  sum.resize(channels);
+  analysisPhase.resize(channels);
+  synthesisPhase.resize(channels);
+  for (UInt c = 0; c < channels; c++) {
+    staging[c].resize(STAGING_SIZE);
+    input[c].assign(INPUT_SIZE, 0.f);
+    sum[c].assign(OUTPUT_SIZE, 0.f);
+    analysisPhase[c].assign(VOCODER_BINS, 0.f);
+    synthesisPhase[c].assign(VOCODER_BINS, 0.f);
+  }
+  mono.assign(INPUT_SIZE, 0.f);
+  norm.assign(OUTPUT_SIZE, 0.f);
+
+  hann(wsolaWindow, WSOLA_SIZE);
+  hann(vocoderWindow, VOCODER_SIZE);
+
+  plan = DSP::fftPlan::get(VOCODER_SIZE);
+  frame.assign(VOCODER_SIZE, 0.f);
+  real.assign(VOCODER_SIZE, 0.f);
+  imaginary.assign(VOCODER_SIZE, 0.f);
+  workReal.assign(VOCODER_SIZE, 0.f);
+  workImaginary.assign(VOCODER_SIZE, 0.f);
+  magnitude.assign(VOCODER_BINS, 0.f);
+  phase.assign(VOCODER_BINS, 0.f);
+  peaks.assign(VOCODER_BINS, 0);
+
+  numChannels = channels;
+  filled = 0;
+  nominal = 0;
+  previous = 0;
+  first = true;
+  done = 0;
+  isReady = true;
+}
+
+YSE::INTERNAL::timeStretch & YSE::INTERNAL::timeStretch::mode(STRETCH_MODE value) {
+  if (value != current) {
+    current = value;
+    clear();
+  }
+  return *this;
+}
+
+YSE::INTERNAL::timeStretch & YSE::INTERNAL::timeStretch::clear() {
+  if (!isReady) return *this;
+  for (UInt c = 0; c < numChannels; c++) {
+    memset(sum[c].data(), 0, OUTPUT_SIZE * sizeof(Flt));
+  }
+  memset(norm.data(), 0, OUTPUT_SIZE * sizeof(Flt));
+  filled = 0;
+  nominal = 0;
+  previous = 0;
+  first = true;
+  done = 0;
+  return *this;
+}
+
+UInt YSE::INTERNAL::timeStretch::frameSize() const {
+  return current == SM_WSOLA ? WSOLA_SIZE : VOCODER_SIZE;
+}
+
+UInt YSE::INTERNAL::timeStretch::tolerance() const {
+  return current == SM_WSOLA ? WSOLA_TOLERANCE : 0;
+}
+
+UInt YSE::INTERNAL::timeStretch::required(UInt length, Flt ratio) const {
+  ratio = limit(ratio);
+  UInt frames = 0;
+  for (UInt d = done; d < length; d += HOP) frames++;
+  if (frames == 0) return 0;
+
+  // one extra sample, in case rounding of the accumulated hops differs
+  Dbl last = nominal + (frames - 1) * (Dbl)ratio * HOP;
+  Int end = (Int)floor(last + 0.5) + (Int)(tolerance() + frameSize()) + 1;
+  return end > (Int)filled ? end - filled : 0;
+}
+
+UInt YSE::INTERNAL::timeStretch::buffered() const {
+  Int used = (Int)floor(nominal + 0.5);
+  return (Int)filled > used ? filled - used : 0;
+}
+
+UInt YSE::INTERNAL::timeStretch::tail(Flt ratio) const {
+  ratio = limit(ratio);
+  return (UInt)((tolerance() + frameSize()) / ratio) + frameSize();
+}
+
+void YSE::INTERNAL::timeStretch::process(UInt inLength, MULTICHANNELBUFFER & out, UInt length, Flt ratio) {
+  if (length > STANDARD_BUFFERSIZE) length = STANDARD_BUFFERSIZE;
+  if (!isReady) {
+    for (UInt c = 0; c < out.size(); c++) memset(out[c].getPtr(), 0, length * sizeof(Flt));
+    return;
+  }
+
+  ///////////////////////////////////////////
+  // add input
+  ///////////////////////////////////////////
+  if (inLength > STAGING_SIZE) inLength = STAGING_SIZE;
+  if (inLength > INPUT_SIZE - filled) inLength = INPUT_SIZE - filled;
+  for (UInt c = 0; c < numChannels; c++) {
+    memcpy(input[c].data() + filled, staging[c].getConstPtr(), inLength * sizeof(Flt));
+  }
+  if (current == SM_WSOLA) {
+    Flt * m = mono.data() + filled;
+    memset(m, 0, inLength * sizeof(Flt));
+    for (UInt c = 0; c < numChannels; c++) {
+      const Flt * ptr = staging[c].getConstPtr();
+      for (UInt i = 0; i < inLength; i++) m[i] += ptr[i];
+    }
+  }
+  filled += inLength;
+
+  ///////////////////////////////////////////
+  // add frames until the output is complete
+  ///////////////////////////////////////////
+  Dbl hop = (Dbl)limit(ratio) * HOP;
+  while (done < length) {
+    Int start = (Int)floor(nominal + 0.5);
+    if (start + (Int)(tolerance() + frameSize()) > (Int)filled) break;
+
+    if (current == SM_WSOLA) {
+      if (!first) start = search(start);
+      wsolaFrame(start);
+    }
+    else {
+      vocoderFrame(start);
+    }
+
+    first = false;
+    previous = start;
+    nominal += hop;
+    done += HOP;
+
+    // forget input that no frame will need anymore
+    Int keep = (Int)floor(nominal + 0.5) - (Int)tolerance();
+    if (current == SM_WSOLA && previous + (Int)HOP < keep) keep = previous + HOP;
+    if (keep > (Int)filled) keep = filled;
+    if (keep > 0) {
+      UInt remain = filled - keep;
+      for (UInt c = 0; c < numChannels; c++) {
+        memmove(input[c].data(), input[c].data() + keep, remain * sizeof(Flt));
+      }
+      memmove(mono.data(), mono.data() + keep, remain * sizeof(Flt));
+      filled = remain;
+      nominal -= keep;
+      previous -= keep;
+    }
+  }
+
+  ///////////////////////////////////////////
+  // output
+  ///////////////////////////////////////////
+  UInt available = done < length ? done : length;
+  for (UInt c = 0; c < out.size(); c++) {
+    Flt * ptr = out[c].getPtr();
+    if (c >= numChannels) {
+      memset(ptr, 0, length * sizeof(Flt));
+      continue;
+    }
+    const Flt * s = sum[c].data();
+    for (UInt i = 0; i < available; i++) {
+      ptr[i] = norm[i] > NORM_EPSILON ? s[i] / norm[i] : 0.f;
+    }
+    memset(ptr + available, 0, (length - available) * sizeof(Flt));
+  }
+
+  for (UInt c = 0; c < numChannels; c++) {
+    Flt * s = sum[c].data();
+    memmove(s, s + available, (OUTPUT_SIZE - available) * sizeof(Flt));
+    memset(s + OUTPUT_SIZE - available, 0, available * sizeof(Flt));
+  }
+  memmove(norm.data(), norm.data() + available, (OUTPUT_SIZE - available) * sizeof(Flt));
+  memset(norm.data() + OUTPUT_SIZE - available, 0, available * sizeof(Flt));
+  done -= available;
+}
+
+Int YSE::INTERNAL::timeStretch::search(Int start) {
+  // the template is where the previous frame would have continued
+  const Flt * templ = mono.data() + previous + HOP;
+
+  Int lowest = start - (Int)WSOLA_TOLERANCE;
+  if (lowest < 0) lowest = 0;
+  Int highest = start + (Int)WSOLA_TOLERANCE;
+
+  // Coarse search on a decimated signal first. Silence gives no preference,
+  // so the nominal position wins unless something correlates better.
+  Int best = start;
+  Flt bestScore = 0.f;
+  for (Int p = lowest; p <= highest; p += WSOLA_DECIMATE) {
+    Flt score = similarity(templ, mono.data() + p, WSOLA_COMPARE, WSOLA_DECIMATE);
+    if (score > bestScore) {
+      bestScore = score;
+      best = p;
+    }
+  }
+
+  if (bestScore <= 0.f) return start;
+
+  // refine around the best coarse position
+  Int from = best - (Int)WSOLA_DECIMATE + 1;
+  Int to = best + (Int)WSOLA_DECIMATE - 1;
+  if (from < lowest) from = lowest;
+  if (to > highest) to = highest;
+  bestScore = -1e30f;
+  for (Int p = from; p <= to; p++) {
+    Flt score = similarity(templ, mono.data() + p, WSOLA_COMPARE, 1);
+    if (score > bestScore) {
+      bestScore = score;
+      best = p;
+    }
+  }
+  return best;
+}
+
+void YSE::INTERNAL::timeStretch::overlapAdd(UInt channel, const Flt * source, const Flt * window, Flt scale) {
+  UInt size = frameSize();
+  Flt * s = sum[channel].data() + done;
+
+  // The first frame is used as it is up to its center, so that the
+  // output starts without a fade in.
+  UInt i = 0;
+  if (first) {
+    for (; i < size / 2; i++) s[i] += source[i];
+  }
+  for (; i < size; i++) s[i] += source[i] * window[i] * scale;
+}
+
+void YSE::INTERNAL::timeStretch::wsolaFrame(Int start) {
+  for (UInt c = 0; c < numChannels; c++) {
+    overlapAdd(c, input[c].data() + start, wsolaWindow.data(), 1.f);
+  }
+
+  const Flt * w = wsolaWindow.data();
+  Flt * n = norm.data() + done;
+  UInt i = 0;
+  if (first) {
+    for (; i < WSOLA_SIZE / 2; i++) n[i] += 1.f;
+  }
+  for (; i < WSOLA_SIZE; i++) n[i] += w[i];
+}
+
+void YSE::INTERNAL::timeStretch::vocoderFrame(Int start) {
+  const Flt * w = vocoderWindow.data();
+  Int hop = start - previous;
+
+  for (UInt c = 0; c < numChannels; c++) {
+    const Flt * x = input[c].data() + start;
+
+    if (first) {
+      // nothing to adjust yet, but the phases are needed for the next frame
+      for (UInt i = 0; i < VOCODER_SIZE; i++) frame[i] = x[i] * w[i];
+      plan->realForward(frame.data(), real.data(), imaginary.data(), workReal.data(), workImaginary.data());
+      for (UInt k = 0; k < VOCODER_BINS; k++) {
+        Flt p = atan2f(imaginary[k], real[k]);
+        analysisPhase[c][k] = p;
+        synthesisPhase[c][k] = p;
+      }
+      overlapAdd(c, x, w, 1.f);
+      continue;
+    }
+
+    for (UInt i = 0; i < VOCODER_SIZE; i++) frame[i] = x[i] * w[i];
+    plan->realForward(frame.data(), real.data(), imaginary.data(), workReal.data(), workImaginary.data());
+    for (UInt k = 0; k < VOCODER_BINS; k++) {
+      magnitude[k] = sqrtf(real[k] * real[k] + imaginary[k] * imaginary[k]);
+      phase[k] = atan2f(imaginary[k], real[k]);
+    }
+
+    // peaks are larger than two bins on either side
+    UInt numPeaks = 0;
+    const Flt * m = magnitude.data();
+    for (UInt k = 0; k < VOCODER_BINS; k++) {
+      Flt v = m[k];
+      if (k > 0 && m[k - 1] >= v) continue;
+      if (k > 1 && m[k - 2] >= v) continue;
+      if (k + 1 < VOCODER_BINS && m[k + 1] > v) continue;
+      if (k + 2 < VOCODER_BINS && m[k + 2] > v) continue;
+      peaks[numPeaks++] = k;
+    }
+
+    Flt * last = analysisPhase[c].data();
+    Flt * synth = synthesisPhase[c].data();
+
+    // Only the phases of the peaks advance with their frequency. All other
+    // bins keep their phase relative to the peak they belong to.
+    for (UInt j = 0; j < numPeaks; j++) {
+      UInt k = peaks[j];
+      Flt omega = TWO_PI * k / VOCODER_SIZE;
+      Flt deviation = wrap(phase[k] - last[k] - omega * hop);
+      Flt frequency = omega + deviation / hop;
+      synth[k] = wrap(synth[k] + frequency * HOP);
+    }
+
+    for (UInt j = 0; j < numPeaks; j++) {
+      UInt p = peaks[j];
+      UInt from = j == 0 ? 0 : (peaks[j - 1] + p) / 2 + 1;
+      UInt to = j + 1 == numPeaks ? VOCODER_BINS - 1 : (p + peaks[j + 1]) / 2;
+      Flt rotation = synth[p] - phase[p];
+      for (UInt k = from; k <= to; k++) {
+        if (k != p) synth[k] = wrap(phase[k] + rotation);
+      }
+    }
+
+    memcpy(last, phase.data(), VOCODER_BINS * sizeof(Flt));
+
+    for (UInt k = 0; k < VOCODER_BINS; k++) {
+      real[k] = magnitude[k] * cosf(synth[k]);
+      imaginary[k] = magnitude[k] * sinf(synth[k]);
+    }
+    plan->realInverse(real.data(), imaginary.data(), frame.data(), workReal.data(), workImaginary.data());
+    overlapAdd(c, frame.data(), w, 1.f / VOCODER_SIZE);
+  }
+
+  // every frame is windowed twice
+  Flt * n = norm.data() + done;
+  UInt i = 0;
+  if (first) {
+    for (; i < VOCODER_SIZE / 2; i++) n[i] += 1.f;
+    for (; i < VOCODER_SIZE; i++) n[i] += w[i];
+  }
+  else {
+    for (; i < VOCODER_SIZE; i++) n[i] += w[i] * w[i];
+  }
+}
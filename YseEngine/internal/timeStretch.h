@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+    timeStretch.h
+    Created: 16 Oct 2026 11:12:40pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef TIMESTRETCH_H_INCLUDED
+#define TIMESTRETCH_H_INCLUDED
+
+#include <vector>
+#include "../headers/types.hpp"
+#include "../headers/enums.hpp"
+#include "../headers/defines.hpp"
+#include "../dsp/buffer.hpp"
+#include "../dsp/fourier/fftPlan.h"
+#include "threadPool.h"
+
+namespace YSE {
+  namespace INTERNAL {
+
+    // ratios of input to output samples that can be used
+    const Flt STRETCH_MIN_RATIO = 0.25f;
+    const Flt STRETCH_MAX_RATIO = 4.f;
+
+    /**
+      Changes the duration of a multichannel signal without changing its pitch.
+      Frames of input are windowed and added to the output every 512 samples,
+      while the input position moves ratio * 512 samples.
+
+      SM_WSOLA uses frames of 1024 samples. Every frame is moved up to 256
+      samples away from its nominal position, to where it resembles the
+      continuation of the previous frame most. This keeps transients and
+      speech intact, but can sound rough on dense tonal material.
+
+      SM_VOCODER uses frames of 2048 samples and adjusts the phase of every
+      bin to the new hop, with the phases locked around spectral peaks. This
+      is smooth on tonal material, but smears transients.
+
+      Both modes read ahead up to a frame of input, but there is no delay in
+      the output: the first output sample is the first input sample.
+
+      Cost per voice, for a stereo file at 44.1kHz on one x86 server core:
+      about 0.5% of that core for SM_WSOLA and 2% for SM_VOCODER. Mono
+      files cost half of that. Memory is allocated once on the slow thread
+      pool, about 70kB per channel.
+    */
+    class timeStretch {
+    public:
+      timeStretch();
+
+      /** Allocate the buffers for a number of channels. This only queues a
+          job and can be called from the audio thread. Nothing is processed
+          until ready() returns true.
+      */
+      void prepare(UInt channels);
+      Bool ready() const { return isReady; }
+
+      /** Switching modes forgets all input and output.
+      */
+      timeStretch & mode(STRETCH_MODE value);
+      STRETCH_MODE mode() const { return current; }
+
+      /** Forget all input and output, for instance after seeking.
+      */
+      timeStretch & clear();
+
+      /** The number of input samples that process() needs to produce length
+          samples. The ratio must be the same for both calls.
+      */
+      UInt required(UInt length, Flt ratio) const;
+
+      /** Input is read into these buffers before calling process(). They
+          are large enough for the required() samples of one block.
+      */
+      MULTICHANNELBUFFER & source() { return staging; }
+
+      /** Input samples that were passed to process() but were not used
+          for output yet.
+      */
+      UInt buffered() const;
+
+      /** Output samples that still follow after the input has ended.
+      */
+      UInt tail(Flt ratio) const;
+
+      /** Add inLength samples from source() and write length samples to the
+          output. Length cannot be larger than STANDARD_BUFFERSIZE.
+      */
+      void process(UInt inLength, MULTICHANNELBUFFER & out, UInt length, Flt ratio);
+
+    private:
+      class allocateJob : public threadPoolJob {
+      public:
+        allocateJob(timeStretch * owner) : owner(owner) {}
+        virtual void run();
+
+      private:
+        timeStretch * owner;
+      };
+
+      void allocate();
+      UInt frameSize() const;
+      UInt tolerance() const;
+
+      Int  search(Int start);
+      void wsolaFrame(Int start);
+      void vocoderFrame(Int start);
+      void overlapAdd(UInt channel, const Flt * frame, const Flt * window, Flt scale);
+
+      STRETCH_MODE current;
+      UInt numChannels, wantedChannels;
+      aBool isReady;
+
+      // input per channel, and the sum of all channels for the similarity search
+      MULTICHANNELBUFFER staging;
+      std::vector< std::vector<Flt> > input;
+      std::vector<Flt> mono;
+      UInt filled;
+
+      // start of the next frame in the input, and of the last one used
+      Dbl nominal;
+      Int previous;
+      Bool first;
+
+      // output is the sum divided by the sum of the windows used,
+      // the first done samples are complete
+      std::vector< std::vector<Flt> > sum;
+      std::vector<Flt> norm;
+      UInt done;
+
+      std::vector<Flt> wsolaWindow, vocoderWindow;
+
+      // phase vocoder
+      const DSP::fftPlan * plan;
+      std::vector< std::vector<Flt> > analysisPhase, synthesisPhase;
+      std::vector<Flt> frame, real, imaginary, workReal, workImaginary;
+      std::vector<Flt> magnitude, phase;
+      std::vector<UInt> peaks;
+
+      // declared last, so that it is joined before anything else is destroyed
+      allocateJob job;
+    };
+
+  }
+}
+
+#endif  // TIMESTRETCH_H_INCLUDED
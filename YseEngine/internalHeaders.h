@@ -17,6 +17,7 @@
 #include "channel/channelMessage.h"
 
 #include "reverb/reverbImplementation.h"
+#include "reverb/reverbZone.h"
 #include "reverb/reverbManager.h"
 #include "reverb/reverbMessage.h"
 
@@ -58,7 +59,10 @@
 #include "implementations/logImplementation.h"
 
 #include "internal/global.h"
+#include "internal/hrtf.h"
+#include "internal/ambisonics.h"
 #include "internal/reverbDSP.h"
+#include "internal/fdnReverb.h"
 #include "internal/settings.h"
 
 #include "internal/abstractSoundFile.h"
@@ -71,6 +75,9 @@
 #include "internal/lsfSoundfile.h"
 #endif
 
+#include "internal/convolution.h"
+#include "internal/timeStretch.h"
+
 #include "internal/time.h"
 #include "internal/underWaterEffect.h"
 #include "internal/virtualFinder.h"
@@ -17,8 +17,10 @@ YSE::REVERB::managerObject & YSE::REVERB::Manager() {
 }
 
 YSE::REVERB::managerObject::managerObject() 
-  : globalReverb(true), calculatedValues(true), mgrDelete(this) {
-  reverbDSPObject.channels(CHANNEL::Manager().getNumberOfOutputs());
+  : count(0), dryStart(1), dryEnd(1), engine(RE_FREEVERB), dormant(0), reverbChannel(nullptr), globalReverb(true), mgrDelete(this) {
+  for (UInt i = 0; i < MAX_ZONES; i++) {
+    zones[i].channels(CHANNEL::Manager().getNumberOfOutputs());
+  }
 }
 
 YSE::REVERB::managerObject::~managerObject() {
@@ -32,7 +34,6 @@ YSE::REVERB::managerObject::~managerObject() {
 
 void YSE::REVERB::managerObject::create() {
   globalReverb.create();
-  calculatedValues.create();
 }
 
 YSE::REVERB::implementationObject * YSE::REVERB::managerObject::addImplementation(YSE::reverb * head) {
@@ -48,7 +49,17 @@ void YSE::REVERB::managerObject::setup(YSE::REVERB::implementationObject* impl)
 }
 
 void YSE::REVERB::managerObject::setOutputChannels(Int value) {
-  reverbDSPObject.channels(value);
+  for (UInt i = 0; i < MAX_ZONES; i++) {
+    zones[i].channels(value);
+  }
+}
+
+void YSE::REVERB::managerObject::setEngine(REVERB_ENGINE value) {
+  engine = value;
+}
+
+YSE::REVERB_ENGINE YSE::REVERB::managerObject::getEngine() {
+  return engine;
 }
 
 YSE::reverb & YSE::REVERB::managerObject::getGlobalReverb() {
@@ -98,115 +109,143 @@ void YSE::REVERB::managerObject::update() {
     }
   }
 
-  Int reverbsActive = 0;
-  calculatedValues.setPreset(REVERB_OFF);
-  calculatedValues.setActive(false);
-  calculatedValues.setDryWetBalance(0.f, 0.f); // this is ok here, because this reverb is only used for calculating the real one
-
   ///////////////////////////////////////
-  // find local reverbs within distance
+  // weigh local reverbs by the distance to the listener
   ///////////////////////////////////////
+  // the strongest reverbs are kept, sorted by weight
+  implementationObject * sources[MAX_ZONES];
+  Flt weights[MAX_ZONES];
+  UInt found = 0;
+  Pos listener = INTERNAL::ListenerImpl().getPos();
+
   for (auto i = inUse.begin(); i != inUse.end(); i++) {
-    if (!(*i)->active) continue;
-    if (Dist((*i)->position, INTERNAL::ListenerImpl().getPos()) <= (*i)->size) {
-      // add this reverb
-      calculatedValues.roomsize += (*i)->roomsize;
-      calculatedValues.damp += (*i)->damp;
-      calculatedValues.wet += (*i)->wet;
-      calculatedValues.dry += (*i)->dry;
-      calculatedValues.modFrequency += (*i)->modFrequency;
-      calculatedValues.modWidth += (*i)->modWidth;
-      for (Int j = 0; j < 4; j++) {
-        calculatedValues.earlyPtr[j] += (*i)->earlyPtr[j];
-        calculatedValues.earlyGain[j] += (*i)->earlyGain[j];
+    if (!(*i)->active || (*i)->wet < 0.001) continue;
+    Flt distance = Dist((*i)->position, listener);
+    Flt weight = 0;
+    if (distance <= (*i)->size) weight = 1;
+    else if (distance < (*i)->size + (*i)->rolloff) weight = 1 - (distance - (*i)->size) / (*i)->rolloff;
+    if (weight <= 0) continue;
+
+    UInt pos = found < MAX_ZONES ? found++ : MAX_ZONES;
+    while (pos > 0 && weights[pos - 1] < weight) {
+      if (pos < MAX_ZONES) {
+        sources[pos] = sources[pos - 1];
+        weights[pos] = weights[pos - 1];
       }
-      reverbsActive++;
+      pos--;
+    }
+    if (pos < MAX_ZONES) {
+      sources[pos] = *i;
+      weights[pos] = weight;
     }
   }
 
-  // if exactly one reverb within distance has been found, totalAdjust will be 1
-  // in this case we can just use this reverb. When more reverbs have been found
-  // we need to average the result
-  if (reverbsActive > 1) {
-    calculatedValues.roomsize /= reverbsActive;
-    calculatedValues.damp /= reverbsActive;
-    calculatedValues.wet /= reverbsActive;
-    calculatedValues.dry /= reverbsActive;
-    calculatedValues.modFrequency /= reverbsActive;
-    calculatedValues.modWidth /= reverbsActive;
-
-    for (Int j = 0; j < 4; j++) {
-      calculatedValues.earlyPtr[j] /= reverbsActive;
-      calculatedValues.earlyGain[j] /= reverbsActive;
-    }
+  // the sends never add up to more than 1
+  Flt total = 0;
+  for (UInt i = 0; i < found; i++) total += weights[i];
+  if (total > 1) {
+    for (UInt i = 0; i < found; i++) weights[i] /= total;
+    total = 1;
   }
-  else if (reverbsActive == 0) {
-    // no reverbs are within distance. Check for rolloff's
-    Flt partial = 0;
-    for (auto i = inUse.begin(); i != inUse.end(); ++i) {
-      if (!(*i)->active) continue;
-      if (Dist((*i)->position, INTERNAL::ListenerImpl().getPos()) <= (*i)->size + (*i)->rolloff) {
-        // add partial reverb
-        Flt adjust = Dist((*i)->position, INTERNAL::ListenerImpl().getPos()) - (*i)->size;
-        adjust = 1 - adjust / (*i)->rolloff;
-        calculatedValues.roomsize += (*i)->roomsize * adjust;
-        calculatedValues.damp += (*i)->damp * adjust;
-        calculatedValues.wet += (*i)->wet * adjust;
-        calculatedValues.dry += (*i)->dry * adjust;
-        calculatedValues.modFrequency += (*i)->modFrequency * adjust;
-        calculatedValues.modWidth += (*i)->modWidth * adjust;
-        for (Int j = 0; j < 4; j++) {
-          calculatedValues.earlyPtr[j] = static_cast<Int>(calculatedValues.earlyPtr[j] + (*i)->earlyPtr[j] * adjust);
-          calculatedValues.earlyGain[j] += (*i)->earlyGain[j] * adjust;
-        }
-        partial += adjust;
+
+  // the global reverb takes what is left
+  Flt globalWeight = 0;
+  if (total < 1 && globalReverb.getActive() && globalReverb.wet >= 0.001) {
+    globalWeight = 1 - total;
+    if (found == MAX_ZONES) {
+      if (weights[found - 1] < globalWeight) {
+        // the weakest reverb makes room, and its weight goes to the global reverb
+        found--;
+        total -= weights[found];
+        globalWeight = 1 - total;
       }
+      else globalWeight = 0;
     }
+  }
 
-    // if sum of partial reverbs > 1 we have to scale down
-    if (partial > 1) {
-      calculatedValues.roomsize /= partial;
-      calculatedValues.damp /= partial;
-      calculatedValues.wet /= partial;
-      calculatedValues.dry /= partial;
-      calculatedValues.modFrequency /= partial;
-      calculatedValues.modWidth /= partial;
-
-      for (Int j = 0; j < 4; j++) {
-        calculatedValues.earlyPtr[j] = static_cast<Int>(calculatedValues.earlyPtr[j] / partial);
-        calculatedValues.earlyGain[j] /= partial;
+  ///////////////////////////////////////
+  // assign zones
+  ///////////////////////////////////////
+  // A zone can only be taken over when it's idle, or when its reverb is not
+  // selected anymore. Otherwise its tail would be cut off.
+  Bool selected[MAX_ZONES] = { false };
+  Bool available[MAX_ZONES];
+  for (UInt j = 0; j < MAX_ZONES; j++) {
+    zones[j].target(0);
+    available[j] = true;
+    if (zones[j].idle()) continue;
+    for (UInt i = 0; i <= found; i++) {
+      implementationObject * source = i < found ? sources[i] : nullptr;
+      Flt weight = i < found ? weights[i] : globalWeight;
+      if (weight > 0 && zones[j].isAssigned(source)) {
+        available[j] = false;
+        break;
       }
     }
-
-    // if partial == 0, we can just use the global reverb object
-    else if (partial == 0) {
-      calculatedValues = globalReverb;
-      return; // important because active could be overwritten at the end of this function
+  }
+  for (UInt i = 0; i <= found; i++) {
+    implementationObject * source = i < found ? sources[i] : nullptr;
+    Flt weight = i < found ? weights[i] : globalWeight;
+    if (weight <= 0) continue;
+
+    // keep the zone this reverb already has
+    Int slot = -1;
+    for (UInt j = 0; j < MAX_ZONES; j++) {
+      if (zones[j].isAssigned(source)) {
+        slot = j;
+        break;
+      }
     }
 
-    // if sum of partial reverbs < 1 we have to add (part of) the global reverb
-    else if (partial < 1) {
-      if (globalReverb.getActive()) {
-        calculatedValues.roomsize += globalReverb.roomsize * (1 - partial);
-        calculatedValues.damp += globalReverb.damp * (1 - partial);
-        calculatedValues.wet += globalReverb.wet * (1 - partial);
-        calculatedValues.dry += globalReverb.dry * (1 - partial);
-        calculatedValues.modFrequency += globalReverb.modFrequency * (1 - partial);
-        calculatedValues.modWidth += globalReverb.modWidth * (1 - partial);
-        for (Int j = 0; j < 4; j++) {
-          calculatedValues.earlyGain[j] += globalReverb.earlyGain[j] * (1 - partial);
-          calculatedValues.earlyPtr[j] = static_cast<Int>(calculatedValues.earlyPtr[j] + globalReverb.earlyGain[j] * (1 - partial));
+    // otherwise use an idle zone, or the released zone with the lowest send
+    if (slot < 0) {
+      for (UInt j = 0; j < MAX_ZONES; j++) {
+        if (selected[j] || !available[j]) continue;
+        if (slot < 0 || (zones[j].idle() && !zones[slot].idle()) || zones[j].current() < zones[slot].current()) {
+          slot = j;
         }
       }
+      if (slot < 0) continue;
+      zones[slot].assign(source);
     }
-  }
 
-  // end of calculations, disable reverb if no wet signal
-  if (calculatedValues.wet < 0.001) {
-    calculatedValues.active = false;
+    selected[slot] = true;
+    setZone(source, weight);
   }
-  else {
-    calculatedValues.active = true;
+}
+
+void YSE::REVERB::managerObject::setZone(implementationObject * source, Flt send) {
+  for (UInt i = 0; i < MAX_ZONES; i++) {
+    if (!zones[i].isAssigned(source)) continue;
+
+    reverb & values = zones[i].parameters();
+    if (source == nullptr) {
+      values.roomsize = globalReverb.roomsize;
+      values.damp = globalReverb.damp;
+      values.wet = globalReverb.wet;
+      values.dry = globalReverb.dry;
+      values.modFrequency = globalReverb.modFrequency;
+      values.modWidth = globalReverb.modWidth;
+      for (Int j = 0; j < 4; j++) {
+        values.earlyPtr[j] = globalReverb.earlyPtr[j];
+        values.earlyGain[j] = globalReverb.earlyGain[j];
+      }
+    }
+    else {
+      values.roomsize = source->roomsize;
+      values.damp = source->damp;
+      values.wet = source->wet;
+      values.dry = source->dry;
+      values.modFrequency = source->modFrequency;
+      values.modWidth = source->modWidth;
+      for (Int j = 0; j < 4; j++) {
+        values.earlyPtr[j] = source->earlyPtr[j];
+        values.earlyGain[j] = source->earlyGain[j];
+      }
+    }
+    values.active = true;
+    zones[i].target(send);
+    return;
   }
 }
 
@@ -216,11 +255,61 @@ void YSE::REVERB::managerObject::attachToChannel(YSE::CHANNEL::implementationObj
   reverbChannel = ptr;
 }
 
-void YSE::REVERB::managerObject::process(YSE::CHANNEL::implementationObject * ptr) {
+Bool YSE::REVERB::managerObject::begin(YSE::CHANNEL::implementationObject * ptr) {
+  if (ptr != reverbChannel) return false;
+
+  // the part of the signal which is not sent to a zone stays dry
+  dryStart = 1;
+  dryEnd = 1;
+  REVERB_ENGINE current = engine;
+  count = 0;
+  UInt sleeping = 0;
+  for (UInt i = 0; i < MAX_ZONES; i++) {
+    if (zones[i].idle()) continue;
+    zones[i].begin(ptr->out, current);
+    dryStart -= zones[i].sendStart();
+    dryEnd -= zones[i].sendEnd();
+    if (zones[i].dormant()) sleeping++;
+    else active[count++] = &zones[i];
+  }
+  dormant = sleeping;
+
+  // Zones are independent, so they run in parallel. They are joined in end(),
+  // which runs on the audio thread itself and not inside a pool job.
+  for (UInt i = 1; i < count; i++) {
+    INTERNAL::Global().addFastJob(active[i]);
+  }
+  if (count > 0) active[0]->run();
+  return true;
+}
+
+void YSE::REVERB::managerObject::end(YSE::CHANNEL::implementationObject * ptr) {
   if (ptr != reverbChannel) return;
-  if (!calculatedValues.active) return;
-  reverbDSPObject.set(calculatedValues);
+  for (UInt i = 1; i < count; i++) {
+    active[i]->join();
+  }
+  if (count == 0) return;
+
+  if (dryStart < 0) dryStart = 0;
+  if (dryEnd < 0) dryEnd = 0;
+  for (UInt c = 0; c < ptr->out.size(); c++) {
+    if (dryStart == dryEnd) {
+      ptr->out[c] *= dryEnd;
+    }
+    else {
+      Flt * out = ptr->out[c].getPtr();
+      UInt length = ptr->out[c].getLength();
+      Flt gain = dryStart;
+      Flt delta = (dryEnd - dryStart) / length;
+      for (UInt i = 0; i < length; i++) {
+        out[i] *= gain;
+        gain += delta;
+      }
+    }
+  }
 
-  // the actual reverb processing
-  reverbDSPObject.process(ptr->out);
-}
\ No newline at end of file
+  for (UInt i = 0; i < count; i++) {
+    active[i]->mix(ptr->out);
+  }
+  count = 0;
+}
@@ -14,7 +14,7 @@
 #include "reverb.hpp"
 #include "reverbInterface.hpp"
 #include "reverbImplementation.h"
-#include "../internal/reverbDSP.h"
+#include "reverbZone.h"
 #include "reverbMessage.h"
 #include "../internal/threadPool.h"
 
@@ -78,8 +78,9 @@ namespace YSE {
       */
       Bool empty();
 
-      /** This function calculates the effective reverb from all active reverbs within
-          distance of the listener
+      /** This function selects the reverbs within distance of the listener and sets
+          the send to their zone. Reverbs that overlap are processed separately and
+          their results are added.
       */
       void update();
 
@@ -90,9 +91,16 @@ namespace YSE {
       */
       void attachToChannel(CHANNEL::implementationObject * ptr);
 
-      /** If the reverb is attached to a channel, it will be applied here
+      /** If the reverb is attached to this channel, fill the zones from its output
+          and start them. Zones run in parallel on the fast thread pool. Returns
+          false if the reverb is not attached to this channel.
       */
-      void process(CHANNEL::implementationObject * ptr); 
+      Bool begin(CHANNEL::implementationObject * ptr);
+
+      /** Wait for the zones and add their result to the channel. This must be
+          called from the audio thread, outside the thread pool, after begin().
+      */
+      void end(CHANNEL::implementationObject * ptr);
 
       /** This function is called by the system if the number of channels changes, because
           it needs to change the reverb output channels to reflect this.
@@ -104,12 +112,27 @@ namespace YSE {
       */
       reverb & getGlobalReverb();
 
+      /** Select the algorithm used for the reverb. This can be changed while playing.
+      */
+      void setEngine(REVERB_ENGINE value);
+      REVERB_ENGINE getEngine();
+
+      // the number of zones which are waiting for input
+      UInt dormantZones() { return dormant; }
+
     private:
-      INTERNAL::reverbDSP reverbDSPObject; // this is the actual reverb object (there can be only one)
+      // copy the settings of a reverb to a zone and set its send level
+      void setZone(implementationObject * source, Flt send);
+
+      zone zones[MAX_ZONES]; // every zone runs its own reverb
+      zone * active[MAX_ZONES]; // zones which run in the current block
+      UInt count;
+      Flt dryStart, dryEnd;
+      std::atomic<REVERB_ENGINE> engine;
+      std::atomic<UInt> dormant;
       CHANNEL::implementationObject * reverbChannel; // < the channel on which to apply this reverb
 
       reverb globalReverb;
-      reverb calculatedValues;
 
       deleteJob mgrDelete;
 
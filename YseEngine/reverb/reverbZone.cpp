@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    reverbZone.cpp
+    Created: 16 Oct 2026 9:20:14pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include "../internalHeaders.h"
+
+namespace {
+  // signals below -100dB are considered silent
+  const Flt silenceThreshold = 0.00001f;
+
+  // the output of a reverb can be silent for a while after the input, until
+  // the early reflections and the first reflections of the delay lines arrive
+  UInt tailGap(YSE::reverb & values) {
+    Int longest = 0;
+    for (Int i = 0; i < 4; i++) {
+      if (values.getReflectionGain(i) > 0 && values.getReflectionTime(i) > longest) {
+        longest = values.getReflectionTime(i);
+      }
+    }
+    return static_cast<UInt>((longest + 100) * YSE::SAMPLERATE * 0.001f);
+  }
+
+  Bool isSilent(const MULTICHANNELBUFFER & buffer) {
+    for (UInt i = 0; i < buffer.size(); i++) {
+      if (!buffer[i].isSilent(silenceThreshold)) return false;
+    }
+    return true;
+  }
+}
+
+YSE::REVERB::zone::zone()
+  : source(nullptr)
+  , used(false)
+  , values(true)
+  , send(0)
+  , lastSend(0)
+  , targetSend(0)
+  , sleeping(true)
+  , silentInput(true)
+  , silentSamples(0)
+  , engine(RE_FREEVERB)
+  , activeEngine(RE_FREEVERB) {
+}
+
+void YSE::REVERB::zone::channels(Int value) {
+  freeverb.channels(value);
+  fdn.channels(value);
+}
+
+void YSE::REVERB::zone::assign(implementationObject * source) {
+  this->source = source;
+  used = true;
+  send = lastSend = 0;
+  sleeping = true;
+  silentSamples = 0;
+  for (auto & channel : freeverb.channel) channel.clear();
+  fdn.clear();
+}
+
+Bool YSE::REVERB::zone::idle() const {
+  return sleeping && send == 0 && targetSend == 0;
+}
+
+void YSE::REVERB::zone::begin(MULTICHANNELBUFFER & input, REVERB_ENGINE engine) {
+  this->engine = engine;
+
+  // sends fade in and out in 100 ms
+  lastSend = send;
+  Flt step = static_cast<Flt>(STANDARD_BUFFERSIZE) / (SAMPLERATE * 0.1f);
+  if (targetSend > send) send = send + step < targetSend ? send + step : targetSend;
+  else send = send - step > targetSend ? send - step : targetSend;
+
+  if (bus.size() != input.size()) bus.resize(input.size());
+  for (UInt c = 0; c < input.size(); c++) {
+    UInt length = input[c].getLength();
+    if (bus[c].getLength() != length) bus[c].resize(length);
+    if ((send == 0 && lastSend == 0) || input[c].isZero()) {
+      bus[c] = 0.f;
+      continue;
+    }
+
+    Flt * out = bus[c].getPtr();
+    const Flt * in = input[c].getConstPtr();
+    if (send == lastSend) {
+      for (UInt i = 0; i < length; i++) out[i] = in[i] * send;
+    }
+    else {
+      Flt gain = lastSend;
+      Flt delta = (send - lastSend) / length;
+      for (UInt i = 0; i < length; i++) {
+        out[i] = in[i] * gain;
+        gain += delta;
+      }
+    }
+  }
+
+  silentInput = (send == 0 && lastSend == 0) || isSilent(bus);
+  if (!silentInput) {
+    sleeping = false;
+    silentSamples = 0;
+  }
+}
+
+void YSE::REVERB::zone::run() {
+  // the tail of the previous engine is dropped, so start the new one empty
+  if (engine != activeEngine) {
+    activeEngine = engine;
+    if (activeEngine == RE_FDN) fdn.clear();
+    else for (auto & channel : freeverb.channel) channel.clear();
+  }
+
+  if (activeEngine == RE_FDN) {
+    fdn.set(values);
+    fdn.process(bus);
+  }
+  else {
+    freeverb.set(values);
+    freeverb.process(bus);
+  }
+}
+
+void YSE::REVERB::zone::mix(MULTICHANNELBUFFER & output) {
+  for (UInt c = 0; c < output.size() && c < bus.size(); c++) {
+    output[c] += bus[c];
+  }
+
+  // go to sleep when the tail has decayed
+  if (!silentInput) return;
+  if (!isSilent(bus)) {
+    silentSamples = 0;
+    return;
+  }
+  if (!bus.empty()) silentSamples += bus[0].getLength();
+  if (silentSamples > tailGap(values)) sleeping = true;
+}
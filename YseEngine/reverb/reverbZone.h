@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    reverbZone.h
+    Created: 16 Oct 2026 9:20:14pm
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef REVERBZONE_H_INCLUDED
+#define REVERBZONE_H_INCLUDED
+
+#include "reverbInterface.hpp"
+#include "../internal/reverbDSP.h"
+#include "../internal/fdnReverb.h"
+#include "../internal/threadPool.h"
+
+namespace YSE {
+  namespace REVERB {
+
+    class implementationObject;
+
+    // the maximum number of reverb zones that are processed at the same time
+    const UInt MAX_ZONES = 4;
+
+    /**
+      A zone runs the reverb of one reverb object, or the global reverb. It is fed
+      by a send from the channel the reverb is attached to, and the send level
+      depends on the distance between the listener and the reverb.
+
+      A zone goes dormant when its input is silent and its own output has decayed.
+      A dormant zone is skipped until there is input again. When its send is also
+      zero, the zone is idle and can be used for another reverb.
+    */
+    class zone : public INTERNAL::threadPoolJob {
+    public:
+      zone();
+
+      void channels(Int value);
+
+      /** Use this zone for another reverb. The reverb is cleared and the
+          send starts at zero. Use nullptr for the global reverb.
+      */
+      void assign(implementationObject * source);
+      Bool isAssigned(implementationObject * source) const { return used && this->source == source; }
+
+      // the send level this zone moves to
+      void target(Flt value) { targetSend = value; }
+      Flt current() const { return send; }
+      Bool idle() const;
+      Bool dormant() const { return sleeping; }
+
+      // the settings for this zone's reverb
+      reverb & parameters() { return values; }
+
+      /** Fill the send bus from the input. Send changes are ramped over the block.
+          A dormant zone wakes up here when the input is not silent.
+      */
+      void begin(MULTICHANNELBUFFER & input, REVERB_ENGINE engine);
+
+      /** Apply the reverb to the send bus. This can run on any thread.
+      */
+      virtual void run();
+
+      /** Add the result to the output. This is also where the tail is checked,
+          so this must be called after run().
+      */
+      void mix(MULTICHANNELBUFFER & output);
+
+      // send level at the start and the end of the current block
+      Flt sendStart() const { return lastSend; }
+      Flt sendEnd() const { return send; }
+
+    private:
+      implementationObject * source;
+      Bool used;
+      reverb values;
+
+      Flt send, lastSend, targetSend;
+
+      Bool sleeping;
+      Bool silentInput;
+      UInt silentSamples; // how long the output has been silent after the input stopped
+
+      MULTICHANNELBUFFER bus;
+
+      REVERB_ENGINE engine;
+      REVERB_ENGINE activeEngine;
+      INTERNAL::reverbDSP freeverb;
+      INTERNAL::fdnReverb fdn;
+    };
+
+  }
+}
+
+
+
+#endif  // REVERBZONE_H_INCLUDED
@@ -22,6 +22,7 @@ namespace YSE {
     class implementationObject;
     class messageObject;
     class managerObject;
+    class spatialBatch;
     enum MESSAGE {
       POSITION,
       SPREAD,
@@ -39,6 +40,9 @@ namespace YSE {
       PAN2D,
       FADE_AND_STOP,
       MOVE,
+      TEMPO,
+      PITCH_SHIFT,
+      STRETCH,
     };
   }
 
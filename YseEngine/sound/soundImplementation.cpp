@@ -11,6 +11,7 @@
 #include "../internalHeaders.h"
 #include "../utils/fileFunctions.hpp"
 #include "../patcher/patcherImplementation.h"
+#include <string.h>
 
 YSE::SOUND::implementationObject::implementationObject(sound * head) :
 	_head_streaming(false),
@@ -27,9 +28,15 @@ YSE::SOUND::implementationObject::implementationObject(sound * head) :
 	pos(0.0f),
 	newPos(0.f),
 	lastPos(0.f),
-	velocityVec(0.f),
+	distance(0.f),
+	angle(0.f),
+	elevation(0.f),
 	velocity(0.f),
 	pitch(1.f),
+	tempo(1.f),
+	pitchShift(1.f),
+	stretching(false),
+	stretchTail(0),
 	size(1.0f),
 	setVolume(false),
 	volumeValue(0),
@@ -57,6 +64,8 @@ YSE::SOUND::implementationObject::implementationObject(sound * head) :
 	objectStatus(OBJECT_CONSTRUCTED)
   {
   fader.set(0.5f);
+  // timed messages are kept on the audio thread, which should not allocate memory
+  timedMessages.reserve(64);
 
 #if defined YSE_DEBUG
   //INTERNAL::Global().getLog().emit(E_SOUND_ADDED);
@@ -159,6 +168,7 @@ bool YSE::SOUND::implementationObject::create(const std::string &fileName,
             printf("6implementationObject::create \n");
 
             filebuffer.resize(file->channels());
+            segmentBuffer.resize(file->channels());
             buffer = &filebuffer;
             return true;
         } else {
@@ -187,6 +197,7 @@ Bool YSE::SOUND::implementationObject::create(YSE::DSP::buffer & buffer, channel
   file->attach(this);
   if (file->create(false)) {
     filebuffer.resize(file->channels());
+    segmentBuffer.resize(file->channels());
     this->buffer = &filebuffer;
     setup();
     return true;
@@ -212,6 +223,7 @@ Bool YSE::SOUND::implementationObject::create(MULTICHANNELBUFFER & buffer, chann
   file->attach(this);
   if (file->create(false)) {
     filebuffer.resize(file->channels());
+    segmentBuffer.resize(file->channels());
     this->buffer = &filebuffer;
     setup();
     return true;
@@ -283,12 +295,14 @@ void YSE::SOUND::implementationObject::setup() {
     else if (streaming) {
       // streaming sounds do not have to wait until loaded
       filebuffer.resize(file->channels());
+      segmentBuffer.resize(file->channels());
 	  _head_length = file->length();
       resize();
       
     } else if (file->getState() == INTERNAL::FILESTATE::READY) {
       // file is ready!
       filebuffer.resize(file->channels());
+      segmentBuffer.resize(file->channels());
       buffer = &filebuffer;
 	  _head_length = file->length();
       resize();
@@ -298,6 +312,13 @@ void YSE::SOUND::implementationObject::setup() {
       return;
     }
   }
+
+  // the number of channels is known now, so allocate for effects which were set before
+  if (head.load() != nullptr && buffer != nullptr) {
+    for (DSP::dspObject * i = head.load()->_dsp; i != nullptr; i = i->link()) {
+      i->prepare(static_cast<UInt>(buffer->size()));
+    }
+  }
   objectStatus = OBJECT_SETUP;
 }
 
@@ -354,8 +375,18 @@ void YSE::SOUND::implementationObject::sync() {
   }
 
   messageObject message;
+  ULong now = DEVICE::Manager().frame();
   while (messages.try_pop(message)) {
-    parseMessage(message);
+    // Messages for a later frame wait until dsp reaches that frame. When
+    // there's no more room, they are applied right away instead of lost.
+    if (message.frame > now && timedMessages.size() < timedMessages.capacity()) {
+      auto pos = timedMessages.end();
+      while (pos != timedMessages.begin() && (pos - 1)->frame > message.frame) --pos;
+      timedMessages.insert(pos, message);
+    }
+    else {
+      parseMessage(message);
+    }
   }
 
   // sync dsp values
@@ -393,6 +424,18 @@ void YSE::SOUND::implementationObject::parseMessage(const messageObject & messag
       pitch = message.floatValue;
       break;
     }
+    case MESSAGE::TEMPO: {
+      tempo = message.floatValue;
+      break;
+    }
+    case MESSAGE::PITCH_SHIFT: {
+      pitchShift = message.floatValue;
+      break;
+    }
+    case MESSAGE::STRETCH: {
+      stretch.mode(message.stretchValue);
+      break;
+    }
     case MESSAGE::SIZE: {
       size = message.floatValue;
       break;
@@ -449,64 +492,8 @@ void YSE::SOUND::implementationObject::parseMessage(const messageObject & messag
 
 
 void YSE::SOUND::implementationObject::update() {
-  ///////////////////////////////////////////
-  // set position and distance
-  ///////////////////////////////////////////
-  newPos = pos * INTERNAL::Settings().distanceFactor;
-
-  // distance to listener
-  if (relative) {
-    distance = Dist(Pos(0), newPos);
-  }
-  else {
-    distance = Dist(newPos, INTERNAL::ListenerImpl().newPos);
-  }
-  virtualDist = (distance- size) * currentVolume_upd;
-  if (virtualDist < 0) virtualDist = 0;
-  /*if (virtualDist > 1000.f) {
-    assert(false);
-  }*/
-
-  ///////////////////////////////////////////
-  // calculate doppler effect 
-  ///////////////////////////////////////////
-  Flt vel = velocity; // avoid using atomic all the time
-  if (!doppler) vel = 0;
-  else {
-    velocityVec = (newPos - lastPos) * (1 / INTERNAL::Time().delta());
-    
-    Pos listenerVelocity;
-    listenerVelocity.x = INTERNAL::ListenerImpl().vel.x.load();
-    listenerVelocity.y = INTERNAL::ListenerImpl().vel.y.load();
-    listenerVelocity.z = INTERNAL::ListenerImpl().vel.z.load();
-
-    if (velocityVec == Pos(0) && listenerVelocity == Pos(0)) vel = 0;
-    else {
-      Pos dist = relative ? newPos : newPos - INTERNAL::ListenerImpl().newPos;
-      if (dist != Pos(0)) {
-        Flt rSound = Dot(velocityVec, dist) / dist.length();
-        Flt rList = Dot(listenerVelocity, dist) / dist.length();
-        vel = 1 - (440 / (((344.0f + rList) / (344.0f + rSound)) * 440));
-        vel *= INTERNAL::Settings().dopplerScale;
-      }
-    }
-    
-  }
-  lastPos = newPos;
-  // disregard rounding errors
-  if (abs(vel) < 0.01f) vel = 0.0f;
-  velocity = vel; // back to atomic
-
-  ///////////////////////////////////////////
-  // calculate angle
-  ///////////////////////////////////////////
-  Flt a = angle; // avoid using atomic all the time
-  Pos dir = relative ? newPos : newPos - INTERNAL::ListenerImpl().newPos;
-  if (relative) a = -atan2(dir.x, dir.z);
-  else a = (atan2(dir.x, dir.z) - atan2(INTERNAL::ListenerImpl().forward.x.load(), INTERNAL::ListenerImpl().forward.z.load()));
-  while (a > Pi) a -= Pi2;
-  while (a < -Pi) a += Pi2;
-  angle = a; // back to atomic
+  // position, distance, doppler and angle are calculated for all sounds
+  // at once by the spatialBatch in the soundManager, before this function is called.
 
   ///////////////////////////////////////////
   // sound occlusion (optional)
@@ -535,6 +522,16 @@ void YSE::SOUND::implementationObject::update() {
 
 Bool YSE::SOUND::implementationObject::dsp() {
   if (objectStatus == OBJECT_DELETE) return false;
+
+  ///////////////////////////////////////////
+  // timed messages
+  ///////////////////////////////////////////
+  // File sounds split the block at every timed message, so that it is applied
+  // at its exact frame. Other sources apply all messages for this block now.
+  ULong blockStart = DEVICE::Manager().frame();
+  Bool split = playerType == PT_FILE && !stretching && stretchTail == 0 && tempo == pitchShift;
+  UInt next = dspFunc_timedMessages(blockStart, split ? 0 : STANDARD_BUFFERSIZE - 1);
+
   ///////////////////////////////////////////
   // handle play status
   ///////////////////////////////////////////
@@ -549,21 +546,14 @@ Bool YSE::SOUND::implementationObject::dsp() {
 		}
 	}
 
-  if (status_dsp == SS_STOPPED || status_dsp == SS_PAUSED) return false;
+  // a stopped sound might still start later in this block
+  if ((status_dsp == SS_STOPPED || status_dsp == SS_PAUSED) && next == STANDARD_BUFFERSIZE) return false;
   if (parent->allowVirtual && !VirtualSoundFinder().inRange(virtualDist)) return false;
 
   ///////////////////////////////////////////
   // set volume at sound level
   ///////////////////////////////////////////
-  if (setVolume) {
-    fader.set(volumeValue, (Int)volumeTime);
-    setVolume = false;
-  }
-  if (setFadeAndStop) {
-    fader.set(0, (Int)fadeAndStopTime);
-    stopAfterFade = true;
-    setFadeAndStop = false;
-  }
+  dspFunc_setVolume();
   currentVolume_dsp = fader.getValue();
 
   if (stopAfterFade && currentVolume_dsp == 0) {
@@ -575,51 +565,145 @@ Bool YSE::SOUND::implementationObject::dsp() {
   ///////////////////////////////////////////
   // set position
   ///////////////////////////////////////////
-  if (setFilePos) {
-    Clamp(newFilePos, 0.f, static_cast<Flt>(file->length()));
-    filePtr = newFilePos;
-    setFilePos = false;
-  }
+  dspFunc_setPosition();
 
   ///////////////////////////////////////////
   // fill buffer
   ///////////////////////////////////////////
   if (playerType == PT_DSP && source_dsp != nullptr) {
     source_dsp->process(status_dsp);
+    fader.update();
   }
   else if (playerType == PT_PATCHER && patcher != nullptr) {
 		
     patcher->Calculate(YSE::T_DSP);
+    fader.update();
   }
   //else if (synth != nullptr) {
   //  synth->process(status_dsp);
   //} 
-  else if (playerType == PT_FILE && file->read(filebuffer, filePtr, STANDARD_BUFFERSIZE, pitch + velocity, looping, status_dsp, bufferVolume) == false) {
-    // non looping sound has reached end of file
-    /*filePtr = 0;
-    _status = SS_STOPPED;
-    if (_streaming) file->needsReset = true;*/
+  else if (playerType == PT_FILE) {
+    Flt speed = (pitch + velocity) * pitchShift;
+    Flt ratio = tempo / pitchShift;
+    if (ratio != 1.f) stretch.prepare(filebuffer.size());
+
+    if ((ratio != 1.f || stretchTail > 0) && stretch.ready()) {
+      dspFunc_stretch(speed, ratio);
+      fader.update();
+    }
+    else {
+      if (stretching) {
+        // go back to what has been read ahead, but not heard yet
+        if (!streaming) {
+          filePtr -= stretch.buffered() * speed;
+          if (filePtr < 0) filePtr = 0;
+        }
+        stretching = false;
+      }
+
+      // until the stretch buffers are ready, the tempo is right but the pitch isn't
+      UInt from = 0;
+      dspFunc_read(from, next, speed * ratio);
+      fader.update(from, next);
+
+      // continue at every timed message in this block
+      while (next < STANDARD_BUFFERSIZE) {
+        from = next;
+        next = dspFunc_timedMessages(blockStart, from);
+        dspFunc_parseIntent();
+        dspFunc_setVolume();
+        dspFunc_setPosition();
+        speed = (pitch + velocity) * pitchShift;
+        dspFunc_read(from, next, speed * ratio);
+        fader.update(from, next);
+      }
+    }
+  }
+  else {
+    fader.update();
   }
 
   // update file position for query by frontend
   currentFilePos = filePtr;
 
-  // update fader
-  fader.update();
-
   ///////////////////////////////////////////
   // apply post dsp if needed
   ///////////////////////////////////////////
   if (post_dsp != nullptr) {
     DSP::dspObject * ptr = post_dsp;
     while (ptr) {
-      if (!ptr->bypass()) ptr->process(*buffer);
+      ptr->processOrSleep(*buffer);
       ptr = ptr->link();
     }
   }
   return true;
 }
 
+UInt YSE::SOUND::implementationObject::dspFunc_timedMessages(ULong blockStart, UInt offset) {
+  UInt due = 0;
+  while (due < timedMessages.size() && timedMessages[due].frame <= blockStart + offset) {
+    parseMessage(timedMessages[due]);
+    due++;
+  }
+  if (due > 0) timedMessages.erase(timedMessages.begin(), timedMessages.begin() + due);
+
+  if (timedMessages.empty() || timedMessages.front().frame >= blockStart + STANDARD_BUFFERSIZE) {
+    return STANDARD_BUFFERSIZE;
+  }
+  return static_cast<UInt>(timedMessages.front().frame - blockStart);
+}
+
+void YSE::SOUND::implementationObject::dspFunc_setVolume() {
+  if (setVolume) {
+    fader.set(volumeValue, (Int)volumeTime);
+    setVolume = false;
+  }
+  if (setFadeAndStop) {
+    fader.set(0, (Int)fadeAndStopTime);
+    stopAfterFade = true;
+    setFadeAndStop = false;
+  }
+}
+
+void YSE::SOUND::implementationObject::dspFunc_setPosition() {
+  if (setFilePos) {
+    Clamp(newFilePos, 0.f, static_cast<Flt>(file->length()));
+    filePtr = newFilePos;
+    setFilePos = false;
+    stretching = false;
+    stretchTail = 0;
+  }
+}
+
+void YSE::SOUND::implementationObject::dspFunc_read(UInt from, UInt to, Flt speed) {
+  if (from == 0 && to == STANDARD_BUFFERSIZE) {
+    if (file->read(filebuffer, filePtr, STANDARD_BUFFERSIZE, speed, looping, status_dsp, bufferVolume) == false) {
+      // non looping sound has reached end of file
+      /*filePtr = 0;
+      _status = SS_STOPPED;
+      if (_streaming) file->needsReset = true;*/
+    }
+    return;
+  }
+
+  UInt length = to - from;
+  if (status_dsp == SS_STOPPED || status_dsp == SS_PAUSED) {
+    // nothing to read, and a stopped read would reset the file
+    for (UInt i = 0; i < filebuffer.size(); i++) {
+      memset(filebuffer[i].getPtr() + from, 0, length * sizeof(Flt));
+    }
+    return;
+  }
+
+  // The file is always read to the start of a buffer. segmentBuffer is sized
+  // together with filebuffer, so this only resizes if they somehow differ.
+  if (segmentBuffer.size() != filebuffer.size()) segmentBuffer.resize(filebuffer.size());
+  file->read(segmentBuffer, filePtr, length, speed, looping, status_dsp, bufferVolume);
+  for (UInt i = 0; i < filebuffer.size(); i++) {
+    memcpy(filebuffer[i].getPtr() + from, segmentBuffer[i].getConstPtr(), length * sizeof(Flt));
+  }
+}
+
 void YSE::SOUND::implementationObject::dspFunc_parseIntent() {
   switch (headIntent) {
     case SI_RESTART:
@@ -652,6 +736,8 @@ void YSE::SOUND::implementationObject::dspFunc_parseIntent() {
       else if (status_dsp == SS_PAUSED) {
         status_dsp = SS_STOPPED;
         filePtr = 0;
+        stretching = false;
+        stretchTail = 0;
         if (streaming) file->reset();
       }
       break;
@@ -670,9 +756,90 @@ void YSE::SOUND::implementationObject::dspFunc_parseIntent() {
 }
 
 
+void YSE::SOUND::implementationObject::dspFunc_stretch(Flt speed, Flt ratio) {
+  if (!stretching) {
+    stretch.clear();
+    stretching = true;
+  }
+
+  MULTICHANNELBUFFER & source = stretch.source();
+  UInt length = stretch.required(STANDARD_BUFFERSIZE, ratio);
+
+  if (stretchTail == 0) {
+    // The stretcher reads ahead, so the fades for play, pause and stop are
+    // applied to its output instead of the file.
+    SOUND_STATUS intent = SS_PLAYING_FULL_VOLUME;
+    Flt volume = 1.f;
+    file->read(source, filePtr, length, speed, looping, intent, volume);
+    // a one-shot sound has ended, the rest of the input is already silent
+    if (intent == SS_STOPPED) stretchTail = stretch.tail(ratio);
+  }
+  else {
+    for (UInt i = 0; i < source.size(); i++) {
+      memset(source[i].getPtr(), 0, length * sizeof(Flt));
+    }
+  }
+
+  stretch.process(length, filebuffer, STANDARD_BUFFERSIZE, ratio);
+
+  if (stretchTail > 0) {
+    if (stretchTail > STANDARD_BUFFERSIZE) stretchTail -= STANDARD_BUFFERSIZE;
+    else {
+      stretchTail = 0;
+      status_dsp = SS_STOPPED;
+    }
+  }
+
+  ///////////////////////////////////////////
+  // fades, as in abstractSoundFile::read
+  ///////////////////////////////////////////
+  if (status_dsp == SS_PLAYING_FULL_VOLUME) return;
+
+  if (status_dsp == SS_WANTSTOPLAY) {
+    status_dsp = SS_PLAYING;
+    bufferVolume = 0.f;
+  }
+
+  Flt gain[STANDARD_BUFFERSIZE];
+  for (UInt i = 0; i < STANDARD_BUFFERSIZE; i++) {
+    gain[i] = bufferVolume;
+    if (status_dsp == SS_PLAYING) {
+      bufferVolume += 0.005f;
+      if (bufferVolume >= 1.f) {
+        bufferVolume = 1.f;
+        status_dsp = SS_PLAYING_FULL_VOLUME;
+      }
+    }
+    else if (status_dsp == SS_WANTSTOPAUSE || status_dsp == SS_WANTSTOSTOP) {
+      bufferVolume -= 0.005f;
+      if (bufferVolume <= 0.f) {
+        bufferVolume = 0.f;
+        status_dsp = status_dsp == SS_WANTSTOPAUSE ? SS_PAUSED : SS_STOPPED;
+      }
+    }
+    else if (status_dsp == SS_PAUSED || status_dsp == SS_STOPPED) {
+      bufferVolume = 0.f;
+    }
+  }
+
+  for (UInt c = 0; c < filebuffer.size(); c++) {
+    Flt * ptr = filebuffer[c].getPtr();
+    for (UInt i = 0; i < STANDARD_BUFFERSIZE; i++) ptr[i] *= gain[i];
+  }
+
+  if (status_dsp == SS_STOPPED) {
+    // the file was read ahead, so it has to start over
+    filePtr = 0;
+    stretching = false;
+    stretchTail = 0;
+    if (streaming) file->reset();
+  }
+}
+
 void YSE::SOUND::implementationObject::dspFunc_calculateGain(Int channel, Int source) {
   Flt finalGain = parent->outConf[channel].finalGain;
-  if (lastGain[channel][source] == finalGain) {
+  if (lastGain[channel][source] == finalGain || channelBuffer.isZero()) {
+    lastGain[channel][source] = finalGain;
     channelBuffer *= (finalGain);
     return;
   }
@@ -703,6 +870,21 @@ void YSE::SOUND::implementationObject::dspFunc_calculateGain(Int channel, Int so
 }
 
 void YSE::SOUND::implementationObject::toChannels() {
+  if (parent->ambisonics.active()) {
+    toAmbisonics();
+    return;
+  }
+
+  if (parent->hrtf != nullptr) {
+    toBinaural();
+    return;
+  }
+
+  if (CHANNEL::Manager().usesVBAP()) {
+    toChannelsVBAP();
+    return;
+  }
+
 #pragma warning ( disable : 4258 )
   for (UInt x = 0; x < buffer->size(); x++) {
     // calculate spread value for multichannel sounds
@@ -746,6 +928,112 @@ void YSE::SOUND::implementationObject::toChannels() {
   }
 }
 
+void YSE::SOUND::implementationObject::toChannelsVBAP() {
+  const std::vector<CHANNEL::speakerPair> & pairs = CHANNEL::Manager().getSpeakerPairs();
+
+  Flt dist = distance - size;
+  if (dist < 0) dist = 0;
+  Flt correctPower = 1 / pow(dist, (2 * INTERNAL::Settings().rolloffScale));
+  if (correctPower > 1) correctPower = 1;
+  Flt gain = sqrt(correctPower);
+  if (occlusionActive) gain *= 1 - occlusion_dsp;
+
+  for (UInt x = 0; x < buffer->size(); x++) {
+    // calculate spread value for multichannel sounds
+    Flt spreadAdjust = 0;
+    if (buffer->size() > 1) spreadAdjust = (((2 * Pi / buffer->size()) * x) + (Pi / buffer->size()) - Pi) * spread;
+    Flt px = sin(angle + spreadAdjust);
+    Flt pz = cos(angle + spreadAdjust);
+
+    // the active pair is the one where both gains are positive. When speakers
+    // don't surround the listener, the pair with the least negative gain is used.
+    UInt best = 0;
+    Flt bestMin = -1000.f, g1 = 0, g2 = 0;
+    for (UInt i = 0; i < pairs.size(); i++) {
+      Flt a, b;
+      pairs[i].gains(px, pz, a, b);
+      Flt lowest = a < b ? a : b;
+      if (lowest > bestMin) {
+        bestMin = lowest;
+        best = i;
+        g1 = a;
+        g2 = b;
+      }
+    }
+    if (g1 < 0) g1 = 0;
+    if (g2 < 0) g2 = 0;
+
+    // keep the emitted power constant
+    Flt norm = sqrt(g1 * g1 + g2 * g2);
+    if (norm > 0) {
+      g1 /= norm;
+      g2 /= norm;
+    }
+    else {
+      g1 = 1;
+    }
+
+    for (UInt j = 0; j < parent->out.size(); ++j) {
+      parent->outConf[j].finalGain = 0;
+    }
+    parent->outConf[pairs[best].first].finalGain = g1 * gain;
+    parent->outConf[pairs[best].second].finalGain = g2 * gain;
+
+    for (UInt j = 0; j < parent->out.size(); ++j) {
+      // speakers outside of the active pair are skipped once they have faded out
+      if (parent->outConf[j].finalGain == 0 && lastGain[j][x] == 0) continue;
+      channelBuffer = (*buffer)[x];
+      dspFunc_calculateGain(j, x);
+      channelBuffer *= fader();
+      parent->out[j] += channelBuffer;
+    }
+  }
+}
+
+void YSE::SOUND::implementationObject::toAmbisonics() {
+  Flt dist = distance - size;
+  if (dist < 0) dist = 0;
+  Flt correctPower = 1 / pow(dist, (2 * INTERNAL::Settings().rolloffScale));
+  if (correctPower > 1) correctPower = 1;
+  Flt gain = sqrt(correctPower);
+  if (occlusionActive) gain *= 1 - occlusion_dsp;
+
+  // the bus is in world orientation, the decoder takes care of the listener
+  Flt worldAngle = angle + parent->ambisonics.rotation();
+
+  for (UInt x = 0; x < buffer->size(); x++) {
+    // calculate spread value for multichannel sounds
+    Flt spreadAdjust = 0;
+    if (buffer->size() > 1) spreadAdjust = (((2 * Pi / buffer->size()) * x) + (Pi / buffer->size()) - Pi) * spread;
+
+    channelBuffer = (*buffer)[x];
+    channelBuffer *= fader();
+    ambisonic.process(parent->ambisonics, channelBuffer, x, worldAngle + spreadAdjust, elevation, gain);
+  }
+}
+
+void YSE::SOUND::implementationObject::toBinaural() {
+  // the hrtf takes care of the direction, so only distance is applied here
+  Flt dist = distance - size;
+  if (dist < 0) dist = 0;
+  Flt correctPower = 1 / pow(dist, (2 * INTERNAL::Settings().rolloffScale));
+  if (correctPower > 1) correctPower = 1;
+
+  parent->outConf[0].finalGain = sqrt(correctPower);
+  if (occlusionActive) parent->outConf[0].finalGain *= 1 - occlusion_dsp;
+
+  // multichannel sounds are mixed to a single source
+  for (UInt x = 0; x < buffer->size(); x++) {
+    channelBuffer = (*buffer)[x];
+    dspFunc_calculateGain(0, x);
+    channelBuffer *= fader();
+    if (x == 0) binauralBuffer = channelBuffer;
+    else binauralBuffer += channelBuffer;
+  }
+
+  binaural.process(parent->hrtf, binauralBuffer, angle, elevation, parent->hrtfOut);
+}
+
 void YSE::SOUND::implementationObject::addDSP(DSP::dspObject & ptr) {
   if (post_dsp) {
     if (post_dsp->calledfrom) {
@@ -753,10 +1041,22 @@ void YSE::SOUND::implementationObject::addDSP(DSP::dspObject & ptr) {
     }
   }
 
+  // the object is removed from the sound or channel that used it before
+  if (ptr.calledfrom) {
+    *(ptr.calledfrom) = nullptr;
+  }
+
   post_dsp = &ptr;
   post_dsp->calledfrom = &post_dsp;
 }
 
+void YSE::SOUND::implementationObject::prepareDSP(DSP::dspObject * ptr) {
+  if (objectStatus < OBJECT_SETUP || buffer == nullptr) return;
+  for (DSP::dspObject * i = ptr; i != nullptr; i = i->link()) {
+    i->prepare(static_cast<UInt>(buffer->size()));
+  }
+}
+
 bool YSE::SOUND::implementationObject::sortSoundObjects(implementationObject * lhs, implementationObject * rhs) {
   if (!lhs->parent->allowVirtual) return true;
   if (!rhs->parent->allowVirtual) return false;
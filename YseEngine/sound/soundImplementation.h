@@ -17,6 +17,9 @@
 #include "../dsp/buffer.hpp"
 #include "../dsp/ramp.hpp"
 #include "../utils/lfQueue.hpp"
+#include "../internal/hrtf.h"
+#include "../internal/ambisonics.h"
+#include "../internal/timeStretch.h"
 
 namespace YSE {
   namespace SOUND {
@@ -111,6 +114,12 @@ namespace YSE {
       */
       void setup();
 
+      /** Allocate what a dsp chain needs for the channels of this sound. This is called
+          from the interface before the chain is passed on, so that the audio thread does
+          not have to. Until the sound is set up, setup() does this instead.
+      */
+      void prepareDSP(DSP::dspObject * ptr);
+
       /** This function resizes internal containers to the number of channels used by
           the current device
       */
@@ -166,15 +175,55 @@ namespace YSE {
 
     private:
       void dspFunc_parseIntent();
+
+      /** Parses the timed messages which are due at 'offset' frames into the block
+          that starts at 'blockStart'. Returns the offset of the next timed message
+          in this block, or STANDARD_BUFFERSIZE if there is none.
+      */
+      UInt dspFunc_timedMessages(ULong blockStart, UInt offset);
+
+      /** Applies new volume and position values from the interface. Called at the
+          start of a block and at every timed message within it.
+      */
+      void dspFunc_setVolume();
+      void dspFunc_setPosition();
+
+      /** Reads the file into the frames of filebuffer from 'from' up to 'to'.
+      */
+      void dspFunc_read(UInt from, UInt to, Flt speed);
       void dspFunc_calculateGain(Int channel, Int source);
 
+      /** Alternative for reading the file directly when tempo and pitch are
+          changed independently. The file is read at the speed needed for the
+          pitch, and stretched to the tempo afterwards.
+      */
+      void dspFunc_stretch(Flt speed, Flt ratio);
+
+      /** Alternative for toChannels with vector base amplitude panning. Every
+          source channel is panned to the speaker pair around its direction.
+      */
+      void toChannelsVBAP();
+
+      /** Alternative for toChannels when the channel uses an ambisonic bus.
+      */
+      void toAmbisonics();
+
+      /** Alternative for toChannels when the output is binaural. All source
+          channels are mixed and convolved with the hrtf for the current direction.
+      */
+      void toBinaural();
+
       // for streaming sounds
       INTERNAL::soundFile * file;
 
       // buffers
       std::vector<DSP::buffer> filebuffer;
+      std::vector<DSP::buffer> segmentBuffer; // file output when the block is split by timed messages
       std::vector<DSP::buffer> * buffer;
       DSP::buffer channelBuffer; // temporary buffer to adjust channel gain
+      DSP::buffer binauralBuffer; // mono mix of all source channels for binaural output
+      INTERNAL::hrtfVoice binaural;
+      INTERNAL::ambisonicVoice ambisonic;
       std::vector< std::vector<Flt> > lastGain; // needed for each channel to smooth gain changes
       Flt bufferVolume; // keep track of actual volume in buffer (may vary all the time, not used elsewhere)
 
@@ -192,12 +241,19 @@ namespace YSE {
 
       // sound properties
       Pos pos; // desired position
-      Pos newPos, lastPos, velocityVec;
+      Pos newPos, lastPos;
       Flt distance;
       Flt angle;
+      Flt elevation;
       // for pitch shift and doppler
       Flt velocity;
       Flt pitch;
+      // independent tempo and pitch, for file sounds
+      Flt tempo;
+      Flt pitchShift;
+      INTERNAL::timeStretch stretch;
+      Bool stretching; // the last buffer was stretched
+      UInt stretchTail; // output left after a one-shot sound has reached its end
       // the distance before distance attenuation begins. 
       Flt size;
       //soundImplementation & size(Flt value);
@@ -254,6 +310,7 @@ namespace YSE {
       std::atomic<sound *> head; // < The interface connected to this object
       std::atomic<OBJECT_IMPLEMENTATION_STATE> objectStatus; // < the status of this object
       lfQueue<messageObject> messages;
+      std::vector<messageObject> timedMessages; // messages waiting for their frame, in order. Only use in dsp and sync
 
       enum PLAYER_TYPE 
       {
@@ -265,6 +322,7 @@ namespace YSE {
       PLAYER_TYPE playerType;
 
       friend class YSE::SOUND::managerObject;
+      friend class YSE::SOUND::spatialBatch;
       friend class YSE::CHANNEL::implementationObject;
     };
   }
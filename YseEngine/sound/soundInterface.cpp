@@ -18,6 +18,9 @@ YSE::sound::sound()
 	, _spread(0)
 	, _volume(0.f)
 	, _speed(1.f)
+	, _tempo(1.f)
+	, _pitchShift(1.f)
+	, _stretchMode(SM_WSOLA)
 	, _size(0.f)
 	, _loop(0.f)
 	, _relative(false)
@@ -151,6 +154,25 @@ void YSE::sound::volume(Flt value, UInt time) {
   }
 }
 
+void YSE::sound::volume(Flt value, UInt time, unsigned long long frame) {
+  // timed messages are always sent, the current value might change before they are applied
+  Clamp(value, 0.f, 1.f);
+  _volume = value;
+  SOUND::messageObject m;
+  m.ID = SOUND::VOLUME_VALUE;
+  m.floatValue = value;
+  m.frame = frame;
+  pimpl->sendMessage(m);
+
+  if (time > 0) {
+    SOUND::messageObject m2;
+    m2.ID = SOUND::VOLUME_TIME;
+    m2.uintValue = time;
+    m2.frame = frame;
+    pimpl->sendMessage(m2);
+  }
+}
+
 Flt YSE::sound::volume() {
   return _volume;
 }
@@ -165,10 +187,61 @@ void YSE::sound::speed(Flt value) {
   }
 }
 
+void YSE::sound::speed(Flt value, unsigned long long frame) {
+  _speed = value;
+  SOUND::messageObject m;
+  m.ID = SOUND::SPEED;
+  m.floatValue = value;
+  m.frame = frame;
+  pimpl->sendMessage(m);
+}
+
 Flt YSE::sound::speed() {
   return _speed;
 }
 
+void YSE::sound::tempo(Flt value) {
+  if (_tempo != value) {
+    _tempo = value;
+    SOUND::messageObject m;
+    m.ID = SOUND::TEMPO;
+    m.floatValue = value;
+    pimpl->sendMessage(m);
+  }
+}
+
+Flt YSE::sound::tempo() {
+  return _tempo;
+}
+
+void YSE::sound::pitchShift(Flt value) {
+  if (_pitchShift != value) {
+    _pitchShift = value;
+    SOUND::messageObject m;
+    m.ID = SOUND::PITCH_SHIFT;
+    m.floatValue = value;
+    pimpl->sendMessage(m);
+  }
+}
+
+Flt YSE::sound::pitchShift() {
+  return _pitchShift;
+}
+
+void YSE::sound::stretchMode(STRETCH_MODE value) {
+  if (_stretchMode != value) {
+    _stretchMode = value;
+    SOUND::messageObject m;
+    m.ID = SOUND::STRETCH;
+    m.stretchValue = value;
+    pimpl->sendMessage(m);
+  }
+}
+
+YSE::STRETCH_MODE YSE::sound::stretchMode() {
+  return _stretchMode;
+}
+
 void YSE::sound::size(Flt value) {
   if (_size != value) {
     _size = value;
@@ -205,6 +278,14 @@ void YSE::sound::play() {
   pimpl->sendMessage(m);
 }
 
+void YSE::sound::play(unsigned long long frame) {
+  SOUND::messageObject m;
+  m.ID = SOUND::INTENT;
+  m.intentValue = SI_PLAY;
+  m.frame = frame;
+  pimpl->sendMessage(m);
+}
+
 void YSE::sound::pause() {
   SOUND::messageObject m;
   m.ID = SOUND::INTENT;
@@ -212,6 +293,14 @@ void YSE::sound::pause() {
   pimpl->sendMessage(m);
 }
 
+void YSE::sound::pause(unsigned long long frame) {
+  SOUND::messageObject m;
+  m.ID = SOUND::INTENT;
+  m.intentValue = SI_PAUSE;
+  m.frame = frame;
+  pimpl->sendMessage(m);
+}
+
 void YSE::sound::stop() {
   SOUND::messageObject m;
   m.ID = SOUND::INTENT;
@@ -219,6 +308,14 @@ void YSE::sound::stop() {
   pimpl->sendMessage(m);
 }
 
+void YSE::sound::stop(unsigned long long frame) {
+  SOUND::messageObject m;
+  m.ID = SOUND::INTENT;
+  m.intentValue = SI_STOP;
+  m.frame = frame;
+  pimpl->sendMessage(m);
+}
+
 void YSE::sound::toggle() {
   SOUND::messageObject m;
   m.ID = SOUND::INTENT;
@@ -233,6 +330,14 @@ void YSE::sound::restart() {
   pimpl->sendMessage(m);
 }
 
+void YSE::sound::restart(unsigned long long frame) {
+  SOUND::messageObject m;
+  m.ID = SOUND::INTENT;
+  m.intentValue = SI_RESTART;
+  m.frame = frame;
+  pimpl->sendMessage(m);
+}
+
 Bool YSE::sound::isPlaying() {
   return (pimpl->_head_status == SS_PLAYING || pimpl->_head_status == SS_PLAYING_FULL_VOLUME);
 }
@@ -266,6 +371,7 @@ Bool YSE::sound::isStreaming() {
 void YSE::sound::setDSP(YSE::DSP::dspObject * value) {
   if (_dsp != value) {
     _dsp = value;
+    pimpl->prepareDSP(value);
     SOUND::messageObject m;
     m.ID = SOUND::DSP;
     m.ptrValue = value;
@@ -286,6 +392,14 @@ void YSE::sound::time(Flt value) {
   pimpl->sendMessage(m);
 }
 
+void YSE::sound::time(Flt value, unsigned long long frame) {
+  SOUND::messageObject m;
+  m.ID = SOUND::TIME;
+  m.floatValue = value;
+  m.frame = frame;
+  pimpl->sendMessage(m);
+}
+
 Flt YSE::sound::time() {
   return pimpl->_head_time;
 }
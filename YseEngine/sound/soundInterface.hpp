@@ -13,6 +13,7 @@
 
 #include "../classes.hpp"
 #include "../headers/defines.hpp"
+#include "../headers/enums.hpp"
 #include "../patcher/patcher.hpp"
 
 #if defined PUBLIC_JUCE
@@ -153,10 +154,54 @@ namespace YSE {
         */
 		void speed(float  value);
 
+    /**
+      Change the speed at an exact frame on the device clock. See System().frame().
+      */
+		void speed(float value, unsigned long long frame);
+
     /** Returns the current speed at which the sound is playing.
     */
     float speed();
 
+    /**
+        Change how fast a file sound plays without changing its pitch. 2 plays twice as fast,
+        0.5 at half speed. This is combined with speed() and doppler, which still change
+        both pitch and tempo.
+
+        The stretch between tempo and pitch shift is limited to a factor 4 in both
+        directions. When both are 1 (or equal) nothing is stretched and there is no extra
+        cost. See stretchMode() for what a stretched sound costs.
+        */
+    void tempo(float value);
+
+    /** Returns the tempo of this sound.
+    */
+    float tempo();
+
+    /**
+        Change the pitch of a file sound without changing its tempo. 2 is an octave higher,
+        0.5 an octave lower.
+        */
+    void pitchShift(float value);
+
+    /** Returns the pitch shift of this sound.
+    */
+    float pitchShift();
+
+    /**
+        Choose how tempo and pitch are separated. SM_WSOLA (the default) works best for
+        speech and percussive sounds, SM_VOCODER for tonal material like music and pads.
+
+        For a stereo sound at 44.1kHz, a stretched voice costs about 0.5% of one core
+        with SM_WSOLA and about 2% with SM_VOCODER. The buffers for stretching (about
+        70kB per channel) are allocated the first time a sound is stretched.
+        */
+    void stretchMode(STRETCH_MODE value);
+
+    /** Returns how tempo and pitch are separated for this sound.
+    */
+    STRETCH_MODE stretchMode();
+
     /**
       Set the 'size' of the sound. This defines from how far away in the virtual space a sound
       will be heard.
@@ -183,6 +228,16 @@ namespace YSE {
       */
 		void volume(float value, unsigned int time = 0);
 
+    /**
+      Sets the volume at an exact frame on the device clock. See System().frame().
+
+      @param value The target volume.
+      @param time  Do a smooth change to the target volume over 'time' milliseconds.
+      @param frame The frame at which the change starts. Frames which have already
+                   passed are applied at once.
+      */
+		void volume(float value, unsigned int time, unsigned long long frame);
+
     /**
       Get the current volume. This can be different from the current target volume if a time has been supplied
       when setVolume() is used.
@@ -199,6 +254,15 @@ namespace YSE {
       */
 		void play();
 
+    /**
+      Play this sound, starting at an exact frame on the device clock. See System().frame().
+      The call still has to reach the audio thread before that frame, so schedule it
+      at least one update ahead. File sounds start at exactly this frame. Sounds with
+      a dsp or patcher source, and file sounds with a changed tempo, start at the 
+      beginning of the block which contains it.
+      */
+		void play(unsigned long long frame);
+
     /**
       Return true if the sound is currently playing.
       */
@@ -209,6 +273,11 @@ namespace YSE {
       */
 		void pause();
 
+    /**
+      Pause this sound at an exact frame on the device clock.
+      */
+		void pause(unsigned long long frame);
+
     /**
       Return true if the sound is currently paused.
       */
@@ -220,6 +289,11 @@ namespace YSE {
       */
 		void stop();
 
+    /**
+      Stop this sound at an exact frame on the device clock.
+      */
+		void stop(unsigned long long frame);
+
     /**
       Return true if the sound is currently stopped.
       */
@@ -235,6 +309,11 @@ namespace YSE {
       */
 		void restart();
 
+    /**
+      Restart this sound at an exact frame on the device clock.
+      */
+		void restart(unsigned long long frame);
+
     /**
       Set the current plahing position in the file. Don't get confused here with setPosition,
       which sets the position in the virtual space where the sound will be rendered.
@@ -243,6 +322,11 @@ namespace YSE {
       */
 		void time(float value);
 
+    /**
+      Set the current playing position in the file at an exact frame on the device clock.
+      */
+		void time(float value, unsigned long long frame);
+
     /**
       Get the current playing position in the file. Don't get confused here with getPosition,
       which gets the position in the virtual space where the sound will be rendered.
@@ -339,6 +423,9 @@ namespace YSE {
     Flt  _spread;
     Flt  _volume;
     Flt  _speed;
+    Flt  _tempo;
+    Flt  _pitchShift;
+    STRETCH_MODE _stretchMode;
     Flt  _size;
     Bool _loop;
     Bool _relative;
@@ -170,6 +170,7 @@ void YSE::SOUND::managerObject::update() {
   // sync and update implementations
   ///////////////////////////////////////////
   {
+    spatial.reset();
     auto previous = inUse.before_begin();
     for (auto i = inUse.begin(); i != inUse.end();) {
       (*i)->sync();
@@ -180,11 +181,19 @@ void YSE::SOUND::managerObject::update() {
         runDelete = true;
         continue;
       }
-      // update
-      (*i)->update();
+      spatial.add(*i);
       previous = i;
       ++i;
     }
+
+    // distance, doppler and angle for all sounds at once
+    spatial.calculate();
+    spatial.scatter();
+
+    // update
+    for (auto i = inUse.begin(); i != inUse.end(); ++i) {
+      (*i)->update();
+    }
   }
 
   VirtualSoundFinder().calculate();
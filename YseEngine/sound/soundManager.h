@@ -16,6 +16,7 @@
 #include "soundMessage.h"
 #include "soundInterface.hpp"
 #include "soundImplementation.h"
+#include "soundSpatial.h"
 #include "../classes.hpp"
 #include "../internal/threadPool.h"
 
@@ -131,6 +132,11 @@ namespace YSE {
 
       Bool empty();
 
+      /** The listener orientation that was used to calculate sound angles in
+          the last update.
+      */
+      Flt getListenerAngle() { return spatial.getListenerAngle(); }
+
       /** Sets the maximum amount of sounds to be processed. The soundmanager
           will try to find the sounds that are most relevant and virtualize
           the rest.
@@ -188,6 +194,9 @@ namespace YSE {
       // update and sync all these objects during the dsp callback function
       std::forward_list<implementationObject*> inUse;
 
+      // spatial state of all sounds in use, calculated in one pass on every update
+      spatialBatch spatial;
+
       // this queue is used by the setupJob. It is accessed from a low
       // priority thread to setup, but also from the dsp thread to check if an
       // object is ready. This is why every pointer has to be atomic. (It's not
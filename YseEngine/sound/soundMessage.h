@@ -43,7 +43,16 @@ namespace YSE {
         UInt   uintValue;
         void * ptrValue;
         SOUND_INTENT intentValue;
+        STRETCH_MODE stretchValue;
       };
+
+      /** The frame on the device clock at which this message should be applied.
+      Messages with a frame that has already passed (the default) are applied at
+      the next update.
+      */
+      ULong frame;
+
+      messageObject() : frame(0) {}
     };
   
   }
@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+    soundSpatial.cpp
+    Created: 16 Oct 2026 10:12:41am
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#include "soundSpatial.h"
+#include "../internalHeaders.h"
+#include <string.h>
+
+// below this amount of sounds, the whole batch is done on the calling thread
+#define SPATIAL_THREAD_MIN 2048
+// number of extra jobs for the fast threadpool. The calling thread always
+// processes one part itself.
+#define SPATIAL_JOBS 2
+// the arrays are allocated for this many sounds when the sound manager is
+// created. More sounds are calculated in several passes.
+#define SPATIAL_MAX_SOUNDS 4096
+
+namespace {
+
+  /* Inverse square root with two newton iterations. The relative error
+     is below 5e-6, which is more than enough for distance attenuation and doppler.
+     It returns a large but finite value for zero, so that x * fastRSqrt(x) is 0.
+  */
+  inline Flt fastRSqrt(Flt x) {
+    Int i;
+    memcpy(&i, &x, sizeof(Flt));
+    i = 0x5f3759df - (i >> 1);
+    Flt y;
+    memcpy(&y, &i, sizeof(Flt));
+    Flt half = 0.5f * x;
+    y = y * (1.5f - half * y * y);
+    y = y * (1.5f - half * y * y);
+    return y;
+  }
+
+  /* Branchless atan2 approximation with a maximum error of about 2e-4 radians
+     (0.01 degrees), which is far below what can be heard in panning.
+  */
+  inline Flt fastAtan2(Flt y, Flt x) {
+    Flt ax = fabsf(x);
+    Flt ay = fabsf(y);
+    Flt mx = ax > ay ? ax : ay;
+    Flt mn = ax > ay ? ay : ax;
+    Flt a = mn / (mx + 1e-30f);
+    Flt s = a * a;
+    Flt r = ((-0.0464964749f * s + 0.15931422f) * s - 0.327622764f) * s * a + a;
+    r = ay > ax ? YSE::Pi_2 - r : r;
+    r = x < 0 ? YSE::Pi - r : r;
+    return y < 0 ? -r : r;
+  }
+}
+
+YSE::SOUND::spatialBatch::spatialBatch() : count(0), listenerAngle(0) {
+  for (Int i = 0; i < SPATIAL_JOBS; i++) {
+    jobs.emplace_front(this);
+  }
+  reserve(SPATIAL_MAX_SOUNDS);
+}
+
+YSE::SOUND::spatialBatch::~spatialBatch() {
+  for (auto i = jobs.begin(); i != jobs.end(); ++i) {
+    i->join();
+  }
+}
+
+void YSE::SOUND::spatialBatch::reserve(UInt length) {
+  objects.resize(length, nullptr);
+  posX.resize(length); posY.resize(length); posZ.resize(length);
+  lastX.resize(length); lastY.resize(length); lastZ.resize(length);
+  soundSize.resize(length);
+  volume.resize(length);
+  lastVelocity.resize(length);
+  relative.resize(length);
+  doppler.resize(length);
+  distance.resize(length);
+  virtualDist.resize(length);
+  velocity.resize(length);
+  angle.resize(length);
+  elevation.resize(length);
+}
+
+void YSE::SOUND::spatialBatch::reset() {
+  count = 0;
+
+  // read all listener atomics only once per update
+  INTERNAL::listenerImplementation & l = INTERNAL::ListenerImpl();
+  listenerX = l.newPos.x;
+  listenerY = l.newPos.y;
+  listenerZ = l.newPos.z;
+  listenerVelX = l.vel.x.load();
+  listenerVelY = l.vel.y.load();
+  listenerVelZ = l.vel.z.load();
+  listenerAngle = atan2(l.forward.x.load(), l.forward.z.load());
+
+  inverseDelta = 1.f / INTERNAL::Time().delta();
+  distanceFactor = INTERNAL::Settings().distanceFactor;
+  dopplerScale = INTERNAL::Settings().dopplerScale;
+}
+
+void YSE::SOUND::spatialBatch::add(implementationObject * impl) {
+  // the arrays are full: finish this part, so that the update never allocates
+  if (count == objects.size()) {
+    calculate();
+    scatter();
+    count = 0;
+  }
+
+  impl->newPos = impl->pos * distanceFactor;
+
+  objects[count] = impl;
+  posX[count] = impl->newPos.x;
+  posY[count] = impl->newPos.y;
+  posZ[count] = impl->newPos.z;
+  lastX[count] = impl->lastPos.x;
+  lastY[count] = impl->lastPos.y;
+  lastZ[count] = impl->lastPos.z;
+  soundSize[count] = impl->size;
+  volume[count] = impl->currentVolume_upd;
+  lastVelocity[count] = impl->velocity;
+  relative[count] = impl->relative ? 1.f : 0.f;
+  doppler[count] = impl->doppler ? 1.f : 0.f;
+  count++;
+}
+
+void YSE::SOUND::spatialBatch::calculate() {
+  if (count < SPATIAL_THREAD_MIN) {
+    process(0, count);
+    return;
+  }
+
+  UInt part = count / (SPATIAL_JOBS + 1);
+  UInt start = 0;
+  for (auto i = jobs.begin(); i != jobs.end(); ++i) {
+    i->set(start, start + part);
+    INTERNAL::Global().addFastJob(&(*i));
+    start += part;
+  }
+  process(start, count);
+
+  for (auto i = jobs.begin(); i != jobs.end(); ++i) {
+    i->join();
+  }
+}
+
+void YSE::SOUND::spatialBatch::process(UInt start, UInt end) {
+  // copy members to locals so that the compiler knows they don't alias the arrays
+  const Flt lx = listenerX, ly = listenerY, lz = listenerZ;
+  const Flt lvx = listenerVelX, lvy = listenerVelY, lvz = listenerVelZ;
+  const Flt la = listenerAngle;
+  const Flt invDelta = inverseDelta;
+  const Flt scale = dopplerScale;
+  const bool listenerMoves = lvx != 0 || lvy != 0 || lvz != 0;
+
+  const Flt * px = posX.data(); const Flt * py = posY.data(); const Flt * pz = posZ.data();
+  const Flt * ox = lastX.data(); const Flt * oy = lastY.data(); const Flt * oz = lastZ.data();
+  const Flt * sz = soundSize.data();
+  const Flt * vol = volume.data();
+  const Flt * lastVel = lastVelocity.data();
+  const Flt * rel = relative.data();
+  const Flt * dop = doppler.data();
+  Flt * outDist = distance.data();
+  Flt * outVirtual = virtualDist.data();
+  Flt * outVel = velocity.data();
+  Flt * outAngle = angle.data();
+  Flt * outElevation = elevation.data();
+
+  for (UInt i = start; i < end; i++) {
+    // relative sounds are positioned against the origin instead of the listener
+    const Flt absolute = 1.f - rel[i];
+    const Flt dx = px[i] - lx * absolute;
+    const Flt dy = py[i] - ly * absolute;
+    const Flt dz = pz[i] - lz * absolute;
+
+    ///////////////////////////////////////////
+    // distance
+    ///////////////////////////////////////////
+    const Flt d2 = dx * dx + dy * dy + dz * dz;
+    const Flt inv = fastRSqrt(d2);
+    const Flt dist = d2 * inv;
+    outDist[i] = dist;
+    Flt v = (dist - sz[i]) * vol[i];
+    outVirtual[i] = v < 0 ? 0 : v;
+
+    ///////////////////////////////////////////
+    // doppler
+    ///////////////////////////////////////////
+    const Flt vx = (px[i] - ox[i]) * invDelta;
+    const Flt vy = (py[i] - oy[i]) * invDelta;
+    const Flt vz = (pz[i] - oz[i]) * invDelta;
+    const Flt rSound = (vx * dx + vy * dy + vz * dz) * inv;
+    const Flt rList = (lvx * dx + lvy * dy + lvz * dz) * inv;
+    Flt vel = (1.f - (344.0f + rSound) / (344.0f + rList)) * scale;
+    // keep the previous value when sound and listener are at the same spot
+    vel = d2 > 0 ? vel : lastVel[i];
+    vel = (listenerMoves || vx != 0 || vy != 0 || vz != 0) ? vel : 0.f;
+    vel *= dop[i];
+    // disregard rounding errors
+    outVel[i] = fabsf(vel) < 0.01f ? 0.f : vel;
+
+    ///////////////////////////////////////////
+    // angle
+    ///////////////////////////////////////////
+    Flt a = fastAtan2(dx, dz);
+    a = a * (1.f - 2.f * rel[i]) - la * absolute;
+    a = a > Pi ? a - Pi2 : a;
+    a = a < -Pi ? a + Pi2 : a;
+    outAngle[i] = a;
+
+    // elevation is only used for binaural output
+    const Flt h2 = dx * dx + dz * dz;
+    outElevation[i] = fastAtan2(dy, h2 * fastRSqrt(h2));
+  }
+}
+
+void YSE::SOUND::spatialBatch::scatter() {
+  for (UInt i = 0; i < count; i++) {
+    implementationObject * impl = objects[i];
+    impl->distance = distance[i];
+    impl->virtualDist = virtualDist[i];
+    impl->velocity = velocity[i];
+    impl->angle = angle[i];
+    impl->elevation = elevation[i];
+    impl->lastPos = impl->newPos;
+  }
+}
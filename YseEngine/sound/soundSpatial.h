@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    soundSpatial.h
+    Created: 16 Oct 2026 10:12:41am
+    Author:  yvan
+
+  ==============================================================================
+*/
+
+#ifndef SOUNDSPATIAL_H_INCLUDED
+#define SOUNDSPATIAL_H_INCLUDED
+
+#include <vector>
+#include <forward_list>
+#include "../classes.hpp"
+#include "../headers/types.hpp"
+#include "../internal/threadPool.h"
+
+namespace YSE {
+  namespace SOUND {
+
+    /**
+      The spatial batch keeps the positional state of all active sounds in
+      contiguous arrays (one array per component) so that distance, doppler and
+      angle can be calculated in a single pass that the compiler can vectorize.
+      Listener data is read only once per update instead of once per sound.
+
+      The soundManager gathers all sounds in use after syncing them, calls
+      calculate() and then hands the results back with scatter(). When there
+      are a lot of sounds, the pass is split over the fast threadpool.
+    */
+    class spatialBatch {
+    public:
+      spatialBatch();
+      ~spatialBatch();
+
+      /** Start a new update. This reads the listener and global settings once.
+      */
+      void reset();
+
+      /** Copy the spatial state of a sound into the arrays. When they are full,
+          the sounds added so far are calculated and scattered first.
+      */
+      void add(implementationObject * impl);
+
+      /** Calculate distance, virtual distance, doppler and angle for all sounds
+          added since the last reset.
+      */
+      void calculate();
+
+      /** Write the results back to the sound implementations.
+      */
+      void scatter();
+
+      UInt size() const { return count; }
+
+      /** The listener orientation used for the last update.
+      */
+      Flt getListenerAngle() const { return listenerAngle; }
+
+    private:
+      /** A job for the fast threadpool, used to process one part of the arrays.
+      */
+      class job : public INTERNAL::threadPoolJob {
+      public:
+        job(spatialBatch * obj) : obj(obj), start(0), end(0) {}
+        void set(UInt start, UInt end) { this->start = start; this->end = end; }
+        virtual void run() { obj->process(start, end); }
+
+      private:
+        spatialBatch * obj;
+        UInt start, end;
+      };
+
+      void process(UInt start, UInt end);
+      void reserve(UInt length);
+
+      UInt count;
+      std::vector<implementationObject*> objects;
+
+      // sound state
+      std::vector<Flt> posX, posY, posZ;
+      std::vector<Flt> lastX, lastY, lastZ;
+      std::vector<Flt> soundSize, volume, lastVelocity;
+      std::vector<Flt> relative; // 1 for relative sounds, 0 otherwise
+      std::vector<Flt> doppler;  // 1 when doppler is enabled, 0 otherwise
+
+      // results
+      std::vector<Flt> distance, virtualDist, velocity, angle, elevation;
+
+      // listener state, read once per update
+      Flt listenerX, listenerY, listenerZ;
+      Flt listenerVelX, listenerVelY, listenerVelZ;
+      Flt listenerAngle;
+      Flt inverseDelta;
+      Flt distanceFactor;
+      Flt dopplerScale;
+
+      std::forward_list<job> jobs;
+    };
+
+  }
+}
+
+
+
+#endif  // SOUNDSPATIAL_H_INCLUDED
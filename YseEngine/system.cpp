@@ -62,6 +62,7 @@ Bool YSE::system::init() {
 
 void YSE::system::update() {
   INTERNAL::Global().flagForUpdate();
+  INTERNAL::Hrtf().update();
 	unsigned int callbacks = DEVICE::Manager().GetCallbacksSinceLastUpdate();
 	if (callbacks == 0) {
 		currentlyMissedCallbacks++;
@@ -115,6 +116,10 @@ YSE::occlusionFunc YSE::system::occlusionCallback() {
 YSE::system::system() : occlusionPtr(nullptr) {
 }
 
+bool YSE::system::loadHRTF(const std::string & fileName) {
+  return INTERNAL::Hrtf().load(fileName);
+}
+
 YSE::system & YSE::system::underWaterFX(const channel & target) {
   INTERNAL::UnderWaterEffect().channel(target.pimpl);
   return *this;
@@ -138,6 +143,14 @@ Flt YSE::system::cpuLoad() {
   return DEVICE::Manager().cpuLoad();
 }
 
+UInt YSE::system::dormantEffects() {
+  return DSP::dspObject::dormantObjects() + REVERB::Manager().dormantZones();
+}
+
+unsigned long long YSE::system::frame() {
+  return DEVICE::Manager().frame();
+}
+
 void YSE::system::sleep(unsigned int ms) {
 #if defined YSE_WINDOWS
   Sleep(ms);
@@ -150,6 +163,15 @@ YSE::reverb & YSE::system::getGlobalReverb() {
   return REVERB::Manager().getGlobalReverb();
 }
 
+YSE::system & YSE::system::reverbEngine(REVERB_ENGINE value) {
+  REVERB::Manager().setEngine(value);
+  return *this;
+}
+
+YSE::REVERB_ENGINE YSE::system::reverbEngine() {
+  return REVERB::Manager().getEngine();
+}
+
 const std::vector<YSE::device> & YSE::system::getDevices() {
   return DEVICE::Manager().getDeviceList();
 }
@@ -160,6 +182,11 @@ void YSE::system::openDevice(const deviceSetup & object, CHANNEL_TYPE conf) {
 
 }
 
+YSE::system & YSE::system::speakerAngle(unsigned int output, float degrees) {
+  CHANNEL::Manager().setCustomAngle(output, degrees * ToRadians);
+  return *this;
+}
+
 void YSE::system::closeCurrentDevice() {
   DEVICE::Manager().close();
 }
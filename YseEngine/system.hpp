@@ -40,6 +40,13 @@ namespace YSE {
     */
     reverb & getGlobalReverb();
 
+    /** Choose the reverb algorithm. RE_FREEVERB runs a comb filter reverb for every
+        output. RE_FDN runs a single feedback delay network for all outputs, which is
+        denser and costs less with many outputs. Both use the same reverb settings.
+    */
+    system & reverbEngine(REVERB_ENGINE value);
+    REVERB_ENGINE reverbEngine();
+
     // This function gets you a list of all available audio devices, but it will only work
     // with YSE as a static library, not with dynamic libraries.
     
@@ -51,6 +58,12 @@ namespace YSE {
     const device & getDevice(unsigned int nr);
     
     void openDevice(const deviceSetup & object, CHANNEL_TYPE conf = CT_AUTO);
+
+    /** Set the position of an output when using CT_CUSTOM. Angles are in degrees,
+        0 is in front of the listener and positive angles are to the right. Outputs
+        without a position are spread evenly around the listener.
+    */
+    system & speakerAngle(unsigned int output, float degrees);
     void closeCurrentDevice();
 
 	const std::string & getDefaultDevice();
@@ -76,6 +89,13 @@ namespace YSE {
     system& occlusionCallback(float(*func)(const YSE::Pos&, const YSE::Pos&));
     occlusionFunc occlusionCallback();
 
+    /** Load a set of head related impulse responses for binaural output. This set is
+        used for all sounds when the device is opened with CT_BINAURAL. The file should
+        contain the SourcePosition, Data.IR and Data.SamplingRate fields of a SOFA
+        SimpleFreeFieldHRIR set, in JSON format.
+    */
+    bool loadHRTF(const std::string & fileName);
+
     system & underWaterFX(const channel & target);
     system & setUnderWaterDepth(float value);
 
@@ -92,6 +112,12 @@ namespace YSE {
 
     // statistics
     float cpuLoad(); // cpu load of the audio steam (not the YSE update system)
+    unsigned int dormantEffects(); // reverbs and dsp objects that are skipped because their input is silent
+
+    // The device clock: frames rendered since the engine started. Sound and channel changes
+    // can be scheduled at an exact frame on this clock. Calls are only passed to the audio
+    // thread at the next update, so schedule them at least one update interval ahead.
+    unsigned long long frame();
     void sleep(unsigned int ms); // usefull for console applications if you don't want to run update at max speed
 		std::string Version() const { return VERSION; }
   private:
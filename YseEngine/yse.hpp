@@ -26,11 +26,14 @@
 #include "dsp/drawableBuffer.hpp"
 #include "dsp/fileBuffer.hpp"
 #include "dsp/wavetable.hpp"
+#include "dsp/wavetableSet.hpp"
 #include "dsp/sample_functions.hpp"
 #include "dsp/delay.hpp"
 #include "dsp/dspObject.hpp"
+#include "dsp/biQuadBank.hpp"
 #include "dsp/filters.hpp"
 #include "dsp/math.hpp"
+#include "dsp/oscillatorBank.hpp"
 #include "dsp/oscillators.hpp"
 #include "dsp/ramp.hpp"
 #include "dsp/envelope.hpp"
@@ -42,6 +45,7 @@
 #include "dsp/modules/sineWave.hpp"
 #include "dsp/modules/granulator.hpp"
 #include "dsp/modules/phaser.hpp"
+#include "dsp/modules/convolutionReverb.hpp"
 #include "dsp/modules/delay/basicDelay.hpp"
 #include "dsp/modules/delay/highpassDelay.hpp"
 #include "dsp/modules/delay/lowpassDelay.hpp"